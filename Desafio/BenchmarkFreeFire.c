@@ -0,0 +1,504 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h> // clock_gettime (relógio monotônico)
+#include <unistd.h> // sysconf (núcleos disponíveis)
+#include "componente.h"
+#include "ordenacao.h"
+#include "ordenacao_paralela.h"
+#include "busca.h"
+#include "indice_hash.h"
+#include "arena_nomes.h"
+#include "dicionario_tipos.h"
+
+// ---------------------------------------------
+// BENCHMARK NÃO INTERATIVO - CÓDIGO DA ILHA (NÍVEL MESTRE)
+// ---------------------------------------------
+// Executa as mesmas rotinas de ordenação e busca do MestreFreeFire.c sobre
+// componentes sintéticos e grava um CSV com mediana, p99, comparações e
+// trocas por elemento (além dos desempates por strcmp que o prefixo de 8 bytes
+// não resolveu), para acompanhar regressões entre builds.
+//
+// Uso: BenchmarkFreeFire [--tamanhos 1000,10000] [--repeticoes N] [--semente S]
+//                        [--limite-quadratico N] [--threads N] [--saida arquivo.csv]
+
+#define MAX_TAMANHOS 16
+#define REPETICOES_PADRAO 11
+#define LIMITE_QUADRATICO_PADRAO 5000
+// Quantidade de buscas cronometradas por repetição
+#define BUSCAS_POR_REPETICAO 10000
+
+typedef enum {
+    DISTRIBUICAO_ALEATORIA,
+    DISTRIBUICAO_ORDENADA,
+    DISTRIBUICAO_REVERSA,
+    DISTRIBUICAO_DUPLICADOS,
+    TOTAL_DISTRIBUICOES
+} Distribuicao;
+
+static const char *NOMES_DISTRIBUICOES[TOTAL_DISTRIBUICOES] = { "aleatorio", "ordenado", "reverso", "duplicados" };
+static const char *TIPOS_SINTETICOS[] = { "arma", "controle", "cura", "municao", "propulsao", "suporte" };
+#define TOTAL_TIPOS_SINTETICOS 6
+// Ordem composta medida (no CSV as vírgulas viram '+' para não quebrar as colunas)
+#define ORDEM_COMPOSTA_BENCHMARK "tipo,-prioridade,nome"
+#define ROTULO_ORDEM_COMPOSTA "tipo+-prioridade+nome"
+// Nomes dos componentes sintéticos (refeita a cada conjunto de dados gerado)
+static ArenaNomes nomesSinteticos;
+
+// Configuração lida da linha de comando
+typedef struct {
+    int tamanhos[MAX_TAMANHOS];
+    int totalTamanhos;
+    int repeticoes;
+    int limiteQuadratico;
+    unsigned int semente;
+    int threads;                // Threads da ordenação paralela (0 = núcleos disponíveis)
+    const char *caminhoSaida;
+} Configuracao;
+
+// ---------------------------------------------
+// FUNÇÕES AUXILIARES
+// ---------------------------------------------
+
+/**
+ * @brief Relógio monotônico em nanossegundos.
+ */
+static double agoraNs() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec * 1e9 + (double)t.tv_nsec;
+}
+
+/**
+ * @brief Gerador xorshift32: rápido e reprodutível a partir da semente.
+ */
+static unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *estado = x;
+}
+
+static int compararDouble(const void *a, const void *b) {
+    double da = *(const double *)a, db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+/**
+ * @brief Percentil pelo método nearest-rank (o vetor é ordenado no lugar).
+ */
+static double percentil(double *amostras, int total, double p) {
+    qsort(amostras, (size_t)total, sizeof(double), compararDouble);
+    int posicao = (int)(p * total + 0.999999) - 1;
+    if (posicao < 0) posicao = 0;
+    if (posicao >= total) posicao = total - 1;
+    return amostras[posicao];
+}
+
+/**
+ * @brief Preenche um componente a partir de uma chave numérica.
+ * A mesma chave ordena nome, tipo e prioridade ao mesmo tempo, então uma
+ * sequência crescente de chaves gera uma mochila já ordenada em todos os critérios.
+ */
+static int preencherComponente(Componente *c, unsigned int chave, unsigned int total) {
+    char nome[NOME_MAX];
+    snprintf(nome, sizeof(nome), "Comp%010u", chave);
+    unsigned long long escala = total > 0 ? total : 1;
+    const char *tipo = TIPOS_SINTETICOS[(unsigned long long)chave * TOTAL_TIPOS_SINTETICOS / escala % TOTAL_TIPOS_SINTETICOS];
+    c->idTipo = (uint16_t)dicionarioTiposInternar(tipo);
+    c->prioridade = PRIORIDADE_MIN + (int)((unsigned long long)chave * (PRIORIDADE_MAX - PRIORIDADE_MIN + 1) / escala % 10);
+    return arenaNomesAtribuir(&nomesSinteticos, c, nome);
+}
+
+/**
+ * @brief Gera n componentes sintéticos na distribuição pedida (os nomes anteriores são liberados).
+ * @return 1 em caso de sucesso, 0 se faltar memória para os nomes.
+ */
+static int gerarComponentes(Componente *v, int n, Distribuicao distribuicao, unsigned int *estado) {
+    char nome[NOME_MAX];
+    arenaNomesLiberar(&nomesSinteticos);
+    for (int i = 0; i < n; i++) {
+        switch (distribuicao) {
+            case DISTRIBUICAO_ORDENADA:
+                if (!preencherComponente(&v[i], (unsigned int)i, (unsigned int)n)) return 0;
+                continue;
+            case DISTRIBUICAO_REVERSA:
+                if (!preencherComponente(&v[i], (unsigned int)(n - 1 - i), (unsigned int)n)) return 0;
+                continue;
+            case DISTRIBUICAO_DUPLICADOS: {
+                // Poucos valores distintos em cada campo (≈1% de nomes distintos)
+                unsigned int distintos = n >= 100 ? (unsigned int)n / 100 : 1;
+                snprintf(nome, sizeof(nome), "Comp%010u", proximoAleatorio(estado) % distintos);
+                v[i].idTipo = (uint16_t)dicionarioTiposInternar(TIPOS_SINTETICOS[proximoAleatorio(estado) % 2]);
+                v[i].prioridade = PRIORIDADE_MAX - (int)(proximoAleatorio(estado) % 3);
+                break;
+            }
+            default:
+                snprintf(nome, sizeof(nome), "Comp%010u", proximoAleatorio(estado));
+                v[i].idTipo = (uint16_t)dicionarioTiposInternar(TIPOS_SINTETICOS[proximoAleatorio(estado) % TOTAL_TIPOS_SINTETICOS]);
+                v[i].prioridade = PRIORIDADE_MIN + (int)(proximoAleatorio(estado) % 10);
+        }
+        if (!arenaNomesAtribuir(&nomesSinteticos, &v[i], nome)) return 0;
+    }
+    return 1;
+}
+
+static int algoritmoQuadratico(AlgoritmoOrdenacao algoritmo) {
+    return algoritmo == ALGORITMO_BOLHA || algoritmo == ALGORITMO_INSERCAO || algoritmo == ALGORITMO_SELECAO;
+}
+
+static const char *obterNomeBenchmark(const void *contexto, int slot) {
+    return nomeNaArena(&nomesSinteticos, &((const Componente *)contexto)[slot]);
+}
+
+/**
+ * @brief Escreve uma linha do CSV.
+ */
+static void escreverLinha(FILE *saida, const char *operacao, const char *algoritmo, const char *criterio,
+                          Distribuicao distribuicao, int tamanho, int repeticoes, double *amostrasNs,
+                          double comparacoesPorElemento, double desempatesPorElemento, double trocasPorElemento) {
+    double mediana = percentil(amostrasNs, repeticoes, 0.50);
+    double p99 = percentil(amostrasNs, repeticoes, 0.99);
+    fprintf(saida, "%s,%s,%s,%s,%d,%d,%.0f,%.0f,%.4f,%.4f,%.4f\n",
+            operacao, algoritmo, criterio, NOMES_DISTRIBUICOES[distribuicao], tamanho, repeticoes,
+            mediana, p99, comparacoesPorElemento, desempatesPorElemento, trocasPorElemento);
+    fflush(saida);
+}
+
+// ---------------------------------------------
+// CENÁRIOS MEDIDOS
+// ---------------------------------------------
+
+/**
+ * @brief Mede a ordenação indireta: ordena entradas (chave + slot) e aplica a permutação.
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+static int medirOrdenacaoIndireta(FILE *saida, const Configuracao *cfg, const Componente *original, Componente *copia,
+                                  int n, Distribuicao distribuicao, double *amostras,
+                                  CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo) {
+    int *permutacao = malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    if (permutacao == NULL) return 0;
+
+    long long comparacoes = 0, desempates = 0, trocas = 0;
+    for (int r = 0; r < cfg->repeticoes; r++) {
+        memcpy(copia, original, (size_t)n * sizeof(Componente));
+        EstatisticasOrdenacao estatisticas;
+
+        double inicio = agoraNs();
+        int total = ordenarPermutacaoComponentes(copia, n, &nomesSinteticos, criterio, algoritmo, permutacao, &estatisticas);
+        long long movimentos = total < 0 ? -1 : aplicarPermutacao(copia, (size_t)total, sizeof(Componente), permutacao);
+        amostras[r] = agoraNs() - inicio;
+        if (movimentos < 0) {
+            free(permutacao);
+            return 0;
+        }
+        comparacoes += estatisticas.comparacoes;
+        desempates += estatisticas.desempatesTexto;
+        trocas += movimentos; // Só as movimentações de Componente (as das entradas são baratas)
+    }
+    free(permutacao);
+
+    double divisor = (double)cfg->repeticoes * (n > 0 ? n : 1);
+    escreverLinha(saida, "ordenacao_indireta", idAlgoritmo(algoritmo), nomeCriterio(criterio), distribuicao, n,
+                  cfg->repeticoes, amostras, comparacoes / divisor, desempates / divisor, trocas / divisor);
+    return 1;
+}
+
+/**
+ * @brief Mede a ordenação paralela de um critério (o id do algoritmo traz a quantidade de threads).
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+static int medirOrdenacaoParalela(FILE *saida, const Configuracao *cfg, PoolThreads *pool, const Componente *original,
+                                  Componente *copia, int n, Distribuicao distribuicao, double *amostras,
+                                  CriterioOrdenacao criterio) {
+    long long comparacoes = 0, desempates = 0, trocas = 0;
+    for (int r = 0; r < cfg->repeticoes; r++) {
+        memcpy(copia, original, (size_t)n * sizeof(Componente));
+        EstatisticasOrdenacao estatisticas;
+
+        double inicio = agoraNs();
+        if (!ordenarComponentesParalelo(pool, copia, n, &nomesSinteticos, criterio, &estatisticas, NULL)) return 0;
+        amostras[r] = agoraNs() - inicio;
+        comparacoes += estatisticas.comparacoes;
+        desempates += estatisticas.desempatesTexto;
+        trocas += estatisticas.trocas;
+    }
+
+    char id[32];
+    snprintf(id, sizeof(id), "paralelo_%dt", pool->totalThreads);
+    double divisor = (double)cfg->repeticoes * (n > 0 ? n : 1);
+    escreverLinha(saida, "ordenacao_paralela", id, nomeCriterio(criterio), distribuicao, n,
+                  cfg->repeticoes, amostras, comparacoes / divisor, desempates / divisor, trocas / divisor);
+    return 1;
+}
+
+/**
+ * @brief Mede a ordenação por várias chaves de uma vez (ORDEM_COMPOSTA_BENCHMARK): o radix
+ * faz uma passada linear sobre a chave codificada, os outros comparam as chaves com memcmp.
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+static int medirOrdenacaoComposta(FILE *saida, const Configuracao *cfg, const Componente *original, Componente *copia,
+                                  int n, Distribuicao distribuicao, double *amostras) {
+    OrdemComposta ordem;
+    ordemCompostaPorTexto(ORDEM_COMPOSTA_BENCHMARK, &ordem);
+    int *permutacao = malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    if (permutacao == NULL) return 0;
+
+    for (int a = 0; a < TOTAL_ALGORITMOS; a++) {
+        AlgoritmoOrdenacao algoritmo = (AlgoritmoOrdenacao)a;
+        if (!algoritmoSuportaOrdemComposta(algoritmo)) continue;
+        if (algoritmoQuadratico(algoritmo) && n > cfg->limiteQuadratico) continue;
+
+        long long comparacoes = 0, trocas = 0;
+        for (int r = 0; r < cfg->repeticoes; r++) {
+            memcpy(copia, original, (size_t)n * sizeof(Componente));
+            EstatisticasOrdenacao estatisticas;
+
+            double inicio = agoraNs();
+            int total = ordenarPermutacaoComposta(copia, n, &nomesSinteticos, &ordem, algoritmo, permutacao, &estatisticas);
+            long long movimentos = total < 0 ? -1 : aplicarPermutacao(copia, (size_t)total, sizeof(Componente), permutacao);
+            amostras[r] = agoraNs() - inicio;
+            if (movimentos < 0) {
+                free(permutacao);
+                return 0;
+            }
+            comparacoes += estatisticas.comparacoes;
+            trocas += estatisticas.trocas + movimentos;
+        }
+
+        // Nenhum desempate por strcmp: o nome já está dentro da chave
+        double divisor = (double)cfg->repeticoes * (n > 0 ? n : 1);
+        escreverLinha(saida, "ordenacao_composta", idAlgoritmo(algoritmo), ROTULO_ORDEM_COMPOSTA, distribuicao, n,
+                      cfg->repeticoes, amostras, comparacoes / divisor, 0.0, trocas / divisor);
+    }
+    free(permutacao);
+    return 1;
+}
+
+/**
+ * @brief Mede todas as combinações algoritmo x critério para um conjunto de dados.
+ * Os algoritmos O(n log n) e lineares também são medidos no modo indireto,
+ * cada critério também é medido com a ordenação paralela, e no final vem a ordem composta.
+ */
+static int medirOrdenacoes(FILE *saida, const Configuracao *cfg, PoolThreads *pool, const Componente *original,
+                           Componente *copia, int n, Distribuicao distribuicao, double *amostras) {
+    for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+        for (int a = 0; a < TOTAL_ALGORITMOS; a++) {
+            CriterioOrdenacao criterio = (CriterioOrdenacao)c;
+            AlgoritmoOrdenacao algoritmo = (AlgoritmoOrdenacao)a;
+            if (!algoritmoSuportaCriterio(algoritmo, criterio)) continue;
+            if (algoritmoQuadratico(algoritmo) && n > cfg->limiteQuadratico) continue;
+
+            long long comparacoes = 0, desempates = 0, trocas = 0;
+            for (int r = 0; r < cfg->repeticoes; r++) {
+                memcpy(copia, original, (size_t)n * sizeof(Componente));
+                EstatisticasOrdenacao estatisticas;
+
+                double inicio = agoraNs();
+                if (!ordenarComponentes(copia, n, &nomesSinteticos, criterio, algoritmo, &estatisticas)) {
+                    fprintf(stderr, "ERRO: Falha ao ordenar (%s por %s).\n", nomeAlgoritmo(algoritmo), nomeCriterio(criterio));
+                    return 0;
+                }
+                amostras[r] = agoraNs() - inicio;
+                comparacoes += estatisticas.comparacoes;
+                desempates += estatisticas.desempatesTexto;
+                trocas += estatisticas.trocas;
+            }
+
+            double divisor = (double)cfg->repeticoes * (n > 0 ? n : 1);
+            escreverLinha(saida, "ordenacao", idAlgoritmo(algoritmo), nomeCriterio(criterio), distribuicao, n,
+                          cfg->repeticoes, amostras, comparacoes / divisor, desempates / divisor, trocas / divisor);
+
+            if (!algoritmoQuadratico(algoritmo) &&
+                !medirOrdenacaoIndireta(saida, cfg, original, copia, n, distribuicao, amostras, criterio, algoritmo)) {
+                fprintf(stderr, "ERRO: Falha na ordenacao indireta (%s por %s).\n", nomeAlgoritmo(algoritmo), nomeCriterio(criterio));
+                return 0;
+            }
+        }
+        if (!medirOrdenacaoParalela(saida, cfg, pool, original, copia, n, distribuicao, amostras, (CriterioOrdenacao)c)) {
+            fprintf(stderr, "ERRO: Falha na ordenacao paralela (%s).\n", nomeCriterio((CriterioOrdenacao)c));
+            return 0;
+        }
+    }
+    if (!medirOrdenacaoComposta(saida, cfg, original, copia, n, distribuicao, amostras)) {
+        fprintf(stderr, "ERRO: Falha na ordenacao composta (%s).\n", ORDEM_COMPOSTA_BENCHMARK);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Mede a busca binária (vetor ordenado por nome), a busca pelo índice hash e a
+ * busca por prefixo (nome do alvo sem os 2 últimos dígitos: até 100 resultados percorridos).
+ * O tempo registrado é o tempo médio por busca em cada repetição.
+ */
+static int medirBuscas(FILE *saida, const Configuracao *cfg, Componente *dados, int n,
+                       Distribuicao distribuicao, double *amostras, unsigned int *estado) {
+    if (n == 0) return 1;
+
+    EstatisticasOrdenacao estatisticas;
+    if (!ordenarComponentes(dados, n, &nomesSinteticos, CRITERIO_NOME, ALGORITMO_INTROSORT, &estatisticas)) return 0;
+
+    // Sorteia os nomes buscados fora da medição
+    int *alvos = malloc(BUSCAS_POR_REPETICAO * sizeof(int));
+    IndiceHash indice;
+    if (alvos == NULL || !indiceHashInicializar(&indice, n, obterNomeBenchmark, dados)) {
+        free(alvos);
+        return 0;
+    }
+    for (int i = 0; i < BUSCAS_POR_REPETICAO; i++) alvos[i] = (int)(proximoAleatorio(estado) % (unsigned int)n);
+    indiceHashReconstruir(&indice, n);
+
+    long long comparacoes = 0, desempates = 0;
+    long long encontrados = 0;
+    for (int r = 0; r < cfg->repeticoes; r++) {
+        double inicio = agoraNs();
+        for (int i = 0; i < BUSCAS_POR_REPETICAO; i++) {
+            encontrados += buscaBinariaComponentes(dados, n, &nomesSinteticos, nomeNaArena(&nomesSinteticos, &dados[alvos[i]]), &comparacoes, &desempates) >= 0;
+        }
+        amostras[r] = (agoraNs() - inicio) / BUSCAS_POR_REPETICAO;
+    }
+    escreverLinha(saida, "busca", "binaria", "nome", distribuicao, n, cfg->repeticoes, amostras,
+                  (double)comparacoes / ((double)cfg->repeticoes * BUSCAS_POR_REPETICAO),
+                  (double)desempates / ((double)cfg->repeticoes * BUSCAS_POR_REPETICAO), 0.0);
+
+    for (int r = 0; r < cfg->repeticoes; r++) {
+        double inicio = agoraNs();
+        for (int i = 0; i < BUSCAS_POR_REPETICAO; i++) {
+            encontrados += indiceHashBuscar(&indice, nomeNaArena(&nomesSinteticos, &dados[alvos[i]])) >= 0;
+        }
+        amostras[r] = (agoraNs() - inicio) / BUSCAS_POR_REPETICAO;
+    }
+    escreverLinha(saida, "busca", "hash", "nome", distribuicao, n, cfg->repeticoes, amostras, 0.0, 0.0, 0.0);
+
+    comparacoes = desempates = 0;
+    for (int r = 0; r < cfg->repeticoes; r++) {
+        double inicio = agoraNs();
+        for (int i = 0; i < BUSCAS_POR_REPETICAO; i++) {
+            const Componente *alvo = &dados[alvos[i]];
+            char prefixo[NOME_MAX];
+            memcpy(prefixo, nomeNaArena(&nomesSinteticos, alvo), alvo->tamanhoNome - 2);
+            prefixo[alvo->tamanhoNome - 2] = '\0';
+            IteradorNomes iterador;
+            iteradorNomesPrefixo(&iterador, dados, NULL, n, &nomesSinteticos, prefixo, &comparacoes, &desempates);
+            int slot, resultados = 0;
+            while ((slot = iteradorNomesProximo(&iterador)) >= 0) resultados++;
+            encontrados += resultados > 0;
+        }
+        amostras[r] = (agoraNs() - inicio) / BUSCAS_POR_REPETICAO;
+    }
+    escreverLinha(saida, "busca", "prefixo", "nome", distribuicao, n, cfg->repeticoes, amostras,
+                  (double)comparacoes / ((double)cfg->repeticoes * BUSCAS_POR_REPETICAO),
+                  (double)desempates / ((double)cfg->repeticoes * BUSCAS_POR_REPETICAO), 0.0);
+
+    indiceHashLiberar(&indice);
+    free(alvos);
+
+    // Todas as buscas procuram nomes existentes: qualquer falha indica um bug
+    if (encontrados != 3LL * cfg->repeticoes * BUSCAS_POR_REPETICAO) {
+        fprintf(stderr, "ERRO: Busca nao encontrou um componente existente.\n");
+        return 0;
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+// FUNÇÃO PRINCIPAL (main)
+// ---------------------------------------------
+
+/**
+ * @brief Lê uma lista de tamanhos separada por vírgulas ("1000,10000").
+ */
+static int lerTamanhos(Configuracao *cfg, char *lista) {
+    cfg->totalTamanhos = 0;
+    for (char *parte = strtok(lista, ","); parte != NULL; parte = strtok(NULL, ",")) {
+        int valor = atoi(parte);
+        if (valor < 0 || cfg->totalTamanhos >= MAX_TAMANHOS) return 0;
+        cfg->tamanhos[cfg->totalTamanhos++] = valor;
+    }
+    return cfg->totalTamanhos > 0;
+}
+
+int main(int argc, char *argv[]) {
+    Configuracao cfg = { {1000, 10000, 100000}, 3, REPETICOES_PADRAO, LIMITE_QUADRATICO_PADRAO, 42u, 0, NULL };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tamanhos") == 0 && i + 1 < argc) {
+            if (!lerTamanhos(&cfg, argv[++i])) {
+                fprintf(stderr, "ERRO: Lista de tamanhos invalida.\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--repeticoes") == 0 && i + 1 < argc) {
+            cfg.repeticoes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            cfg.semente = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--limite-quadratico") == 0 && i + 1 < argc) {
+            cfg.limiteQuadratico = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            cfg.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc) {
+            cfg.caminhoSaida = argv[++i];
+        } else {
+            fprintf(stderr, "Uso: %s [--tamanhos 1000,10000] [--repeticoes N] [--semente S] "
+                            "[--limite-quadratico N] [--threads N] [--saida arquivo.csv]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (cfg.repeticoes < 1) cfg.repeticoes = 1;
+    if (cfg.semente == 0) cfg.semente = 1; // xorshift não aceita estado zero
+    if (cfg.threads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        cfg.threads = nucleos > 0 ? (int)nucleos : 1;
+    }
+
+    PoolThreads pool;
+    if (!poolCriar(&pool, cfg.threads)) {
+        fprintf(stderr, "ERRO: Nao foi possivel criar %d threads.\n", cfg.threads);
+        return 1;
+    }
+
+    FILE *saida = stdout;
+    if (cfg.caminhoSaida != NULL && (saida = fopen(cfg.caminhoSaida, "w")) == NULL) {
+        fprintf(stderr, "ERRO: Nao foi possivel criar \"%s\".\n", cfg.caminhoSaida);
+        poolDestruir(&pool);
+        return 1;
+    }
+
+    fprintf(saida, "operacao,algoritmo,criterio,distribuicao,tamanho,repeticoes,"
+                   "mediana_ns,p99_ns,comparacoes_por_elemento,desempates_strcmp_por_elemento,trocas_por_elemento\n");
+
+    double *amostras = malloc((size_t)cfg.repeticoes * sizeof(double));
+    int sucesso = amostras != NULL;
+
+    for (int t = 0; sucesso && t < cfg.totalTamanhos; t++) {
+        int n = cfg.tamanhos[t];
+        Componente *original = malloc((size_t)(n > 0 ? n : 1) * sizeof(Componente));
+        Componente *copia = malloc((size_t)(n > 0 ? n : 1) * sizeof(Componente));
+        if (original == NULL || copia == NULL) {
+            fprintf(stderr, "ERRO: Memoria insuficiente para %d componentes.\n", n);
+            sucesso = 0;
+        }
+
+        for (int d = 0; sucesso && d < TOTAL_DISTRIBUICOES; d++) {
+            unsigned int estado = cfg.semente + (unsigned int)(t * TOTAL_DISTRIBUICOES + d);
+            fprintf(stderr, "Medindo n=%d (%s)...\n", n, NOMES_DISTRIBUICOES[d]);
+
+            if (!gerarComponentes(original, n, (Distribuicao)d, &estado)) {
+                fprintf(stderr, "ERRO: Memoria insuficiente para os nomes de %d componentes.\n", n);
+                sucesso = 0;
+                break;
+            }
+            sucesso = medirOrdenacoes(saida, &cfg, &pool, original, copia, n, (Distribuicao)d, amostras) &&
+                      medirBuscas(saida, &cfg, original, n, (Distribuicao)d, amostras, &estado);
+        }
+        free(original);
+        free(copia);
+    }
+
+    free(amostras);
+    arenaNomesLiberar(&nomesSinteticos);
+    poolDestruir(&pool);
+    if (saida != stdout) fclose(saida);
+    return sucesso ? 0 : 1;
+}
@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> // sysconf (núcleos disponíveis)
+#include "inventario.h"
+#include "metricas.h"
+#include "pool_threads.h"
+
+// ---------------------------------------------
+// BENCHMARK DA BIBLIOTECA DE INVENTÁRIO - CÓDIGO DA ILHA
+// ---------------------------------------------
+// Cada thread cria o próprio Inventario e repete rodadas de adicionar, buscar,
+// ordenar, montar a visão por prioridade e descartar tudo, sem nenhuma trava entre
+// as threads (a biblioteca não tem estado global). Mede a latência de cada
+// operação no histograma da thread e, no final, soma os histogramas para mostrar
+// as operações por segundo e a latência de cauda. Com --threads 1 e --threads N
+// dá para ver se o núcleo escala com inventários independentes.
+//
+// Uso: BenchmarkInventario [--threads T] [--componentes N] [--rodadas R]
+//                          [--semente S] [--saida arquivo.csv]
+
+#define COMPONENTES_PADRAO 10000  // Por rodada, em cada thread
+#define RODADAS_PADRAO 20
+
+static const char *TIPOS_SINTETICOS[] = { "arma", "controle", "cura", "municao", "propulsao", "suporte" };
+#define TOTAL_TIPOS_SINTETICOS 6
+
+// Operações medidas (a ordem segue NOMES_OPERACOES)
+typedef enum {
+    OPERACAO_ADICIONAR,
+    OPERACAO_BUSCAR,
+    OPERACAO_ORDENAR,
+    OPERACAO_VISAO,
+    OPERACAO_DESCARTAR,
+    TOTAL_OPERACOES
+} OperacaoBenchmark;
+
+static const char *const NOMES_OPERACOES[TOTAL_OPERACOES] = { "adicionar", "buscar", "ordenar", "visao", "descartar" };
+
+typedef enum {
+    CONTADOR_COMPARACOES,
+    CONTADOR_MOVIMENTACOES,  // Componentes deslocados pela biblioteca (compactações)
+    CONTADOR_FALHAS,
+    TOTAL_CONTADORES
+} ContadorBenchmark;
+
+static const char *const NOMES_CONTADORES[TOTAL_CONTADORES] = { "comparacoes", "movimentacoes", "falhas" };
+
+// Configuração lida da linha de comando
+typedef struct {
+    int threads;
+    int componentes;
+    int rodadas;
+    unsigned int semente;
+    const char *caminhoSaida;
+} Configuracao;
+
+// Trabalho de uma thread: o inventário é criado dentro dela
+typedef struct {
+    const Configuracao *cfg;
+    unsigned int estado;
+    Metricas *metricas;
+    int sucesso;
+} TarefaBenchmark;
+
+// ---------------------------------------------
+// FUNÇÕES AUXILIARES
+// ---------------------------------------------
+
+/**
+ * @brief Gerador xorshift32: rápido, reprodutível e com estado próprio por thread.
+ */
+static unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *estado = x;
+}
+
+/**
+ * @brief Executa uma rodada completa em um inventário vazio e o deixa vazio de novo.
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+static int executarRodada(Inventario *inventario, TarefaBenchmark *tarefa, unsigned int *chaves) {
+    const Configuracao *cfg = tarefa->cfg;
+    Metricas *metricas = tarefa->metricas;
+    char nome[NOME_MAX];
+    int n = cfg->componentes;
+
+    for (int i = 0; i < n; i++) {
+        // Chaves repetidas viram nomes repetidos, que o nível Mestre aceita
+        chaves[i] = proximoAleatorio(&tarefa->estado);
+        snprintf(nome, sizeof(nome), "Comp%010u", chaves[i]);
+        uint64_t inicio = metricasAgoraNs();
+        int slot = inventarioAdicionar(inventario, nome, TIPOS_SINTETICOS[chaves[i] % TOTAL_TIPOS_SINTETICOS],
+                                       PRIORIDADE_MIN + (int)(chaves[i] % PRIORIDADE_MAX), NULL);
+        metricasRegistrar(metricas, OPERACAO_ADICIONAR, metricasAgoraNs() - inicio);
+        if (slot < 0) return 0;
+    }
+
+    for (int i = 0; i < n; i++) {
+        snprintf(nome, sizeof(nome), "Comp%010u", chaves[proximoAleatorio(&tarefa->estado) % (unsigned int)n]);
+        uint64_t inicio = metricasAgoraNs();
+        int slot = inventarioBuscar(inventario, nome);
+        metricasRegistrar(metricas, OPERACAO_BUSCAR, metricasAgoraNs() - inicio);
+        if (slot < 0) metricasSomar(metricas, CONTADOR_FALHAS, 1);
+    }
+
+    EstatisticasOrdenacao estatisticas;
+    uint64_t inicio = metricasAgoraNs();
+    if (!inventarioOrdenar(inventario, CRITERIO_NOME, inventario->algoritmoPorCriterio[CRITERIO_NOME], &estatisticas)) {
+        return 0;
+    }
+    metricasRegistrar(metricas, OPERACAO_ORDENAR, metricasAgoraNs() - inicio);
+    metricasSomar(metricas, CONTADOR_COMPARACOES, estatisticas.comparacoes);
+
+    inicio = metricasAgoraNs();
+    if (inventarioVisao(inventario, CRITERIO_PRIORIDADE, &estatisticas) == NULL) return 0;
+    metricasRegistrar(metricas, OPERACAO_VISAO, metricasAgoraNs() - inicio);
+
+    // Descarta na ordem em que entraram (as compactações automáticas entram na latência)
+    for (int i = 0; i < n; i++) {
+        snprintf(nome, sizeof(nome), "Comp%010u", chaves[i]);
+        inicio = metricasAgoraNs();
+        int slot = inventarioRemover(inventario, nome);
+        metricasRegistrar(metricas, OPERACAO_DESCARTAR, metricasAgoraNs() - inicio);
+        if (slot < 0) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Executa as rodadas de uma thread sobre um inventário só dela.
+ */
+static void executarBenchmark(void *argumento, int idThread) {
+    TarefaBenchmark *tarefa = argumento;
+    const Configuracao *cfg = tarefa->cfg;
+    (void)idThread;
+
+    ConfiguracaoInventario configuracao;
+    inventarioConfiguracaoPadrao(&configuracao);
+    Inventario inventario;
+    unsigned int *chaves = malloc((size_t)cfg->componentes * sizeof(unsigned int));
+    if (chaves == NULL || !inventarioCriar(&inventario, &configuracao)) {
+        free(chaves);
+        tarefa->sucesso = 0;
+        return;
+    }
+
+    tarefa->sucesso = 1;
+    for (int r = 0; r < cfg->rodadas && tarefa->sucesso; r++) {
+        tarefa->sucesso = executarRodada(&inventario, tarefa, chaves);
+    }
+    metricasSomar(tarefa->metricas, CONTADOR_MOVIMENTACOES, inventario.contadores.movimentacoes);
+    inventarioDestruir(&inventario);
+    free(chaves);
+}
+
+// ---------------------------------------------
+// FUNÇÃO PRINCIPAL
+// ---------------------------------------------
+
+int main(int argc, char *argv[]) {
+    Configuracao cfg = { 0, COMPONENTES_PADRAO, RODADAS_PADRAO, 42u, NULL };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            cfg.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--componentes") == 0 && i + 1 < argc) {
+            cfg.componentes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rodadas") == 0 && i + 1 < argc) {
+            cfg.rodadas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            cfg.semente = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc) {
+            cfg.caminhoSaida = argv[++i];
+        } else {
+            fprintf(stderr, "Uso: %s [--threads T] [--componentes N] [--rodadas R] [--semente S] "
+                            "[--saida arquivo.csv]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (cfg.componentes < 1) cfg.componentes = 1;
+    if (cfg.rodadas < 1) cfg.rodadas = 1;
+    if (cfg.semente == 0) cfg.semente = 1; // xorshift não aceita estado zero
+    if (cfg.threads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        cfg.threads = nucleos > 0 ? (int)nucleos : 1;
+    }
+
+    PoolThreads pool;
+    if (!poolCriar(&pool, cfg.threads)) {
+        fprintf(stderr, "ERRO: Nao foi possivel criar %d threads.\n", cfg.threads);
+        return 1;
+    }
+
+    TarefaBenchmark *tarefas = malloc((size_t)cfg.threads * sizeof(TarefaBenchmark));
+    Metricas *porThread = malloc((size_t)cfg.threads * sizeof(Metricas));
+    Metricas *total = malloc(sizeof(Metricas));
+    int sucesso = tarefas != NULL && porThread != NULL && total != NULL;
+
+    if (sucesso) {
+        for (int t = 0; t < cfg.threads; t++) {
+            metricasInicializar(&porThread[t], NOMES_OPERACOES, TOTAL_OPERACOES, NOMES_CONTADORES, TOTAL_CONTADORES);
+            tarefas[t].cfg = &cfg;
+            tarefas[t].estado = cfg.semente + (unsigned int)t * 0x9e3779b9u;
+            if (tarefas[t].estado == 0) tarefas[t].estado = 1;
+            tarefas[t].metricas = &porThread[t];
+            tarefas[t].sucesso = 0;
+        }
+
+        fprintf(stderr, "Medindo %d inventario(s) independentes (%d rodadas de %d componentes cada)...\n",
+                cfg.threads, cfg.rodadas, cfg.componentes);
+        uint64_t inicio = metricasAgoraNs();
+        poolExecutar(&pool, executarBenchmark, tarefas, sizeof(TarefaBenchmark), cfg.threads);
+        double segundos = (double)(metricasAgoraNs() - inicio) / 1e9;
+
+        metricasInicializar(total, NOMES_OPERACOES, TOTAL_OPERACOES, NOMES_CONTADORES, TOTAL_CONTADORES);
+        for (int t = 0; t < cfg.threads; t++) {
+            metricasCombinar(total, &porThread[t]);
+            if (!tarefas[t].sucesso) sucesso = 0;
+        }
+
+        // Adicionar, buscar e descartar contam uma operação por componente
+        long long operacoes = 3LL * cfg.threads * cfg.rodadas * cfg.componentes;
+        printf("INVENTARIO threads=%d componentes=%d rodadas=%d operacoes=%lld tempo=%.6f s (%.0f operacoes/s)\n",
+               cfg.threads, cfg.componentes, cfg.rodadas, operacoes, segundos,
+               segundos > 0 ? operacoes / segundos : 0.0);
+        metricasExibir(total);
+
+        if (!sucesso) fprintf(stderr, "ERRO: Memoria insuficiente em pelo menos uma thread.\n");
+        if (!metricasSalvar(total, cfg.caminhoSaida)) {
+            fprintf(stderr, "ERRO: Nao foi possivel gravar \"%s\".\n", cfg.caminhoSaida);
+            sucesso = 0;
+        }
+    } else {
+        fprintf(stderr, "ERRO: Memoria insuficiente para preparar o benchmark.\n");
+    }
+
+    free(tarefas);
+    free(porThread);
+    free(total);
+    poolDestruir(&pool);
+    return sucesso ? 0 : 1;
+}
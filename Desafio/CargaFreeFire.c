@@ -0,0 +1,236 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> // sysconf (núcleos disponíveis)
+#include "multijogador.h"
+#include "metricas.h"
+#include "pool_threads.h"
+
+// ---------------------------------------------
+// GERADOR DE CARGA MULTIJOGADOR - CÓDIGO DA ILHA
+// ---------------------------------------------
+// Simula vários jogadores saqueando, descartando e buscando componentes ao
+// mesmo tempo no motor multijogador. Cada thread escolhe jogadores ao acaso
+// (então threads diferentes disputam as mesmas fatias), mede a latência de cada
+// operação no próprio histograma e, no final, os histogramas são somados para
+// mostrar as operações por segundo e a latência de cauda (p50/p90/p99/máx).
+//
+// Uso: CargaFreeFire [--jogadores N] [--threads T] [--operacoes M] [--fatias S]
+//                    [--leituras P] [--itens K] [--semente S] [--saida arquivo.csv]
+
+#define JOGADORES_PADRAO 1000
+#define OPERACOES_PADRAO 200000   // Por thread
+#define FATIAS_PADRAO 64
+#define LEITURAS_PADRAO 80        // Percentual de buscas; o resto divide-se entre saques (2/3) e descartes (1/3)
+#define ITENS_PADRAO 64           // Nomes distintos por jogador (buscas podem falhar)
+
+static const char *TIPOS_SINTETICOS[] = { "arma", "controle", "cura", "municao", "propulsao", "suporte" };
+#define TOTAL_TIPOS_SINTETICOS 6
+
+// Operações medidas (a ordem segue NOMES_OPERACOES)
+typedef enum {
+    OPERACAO_SAQUEAR,
+    OPERACAO_DESCARTAR,
+    OPERACAO_BUSCAR,
+    TOTAL_OPERACOES
+} OperacaoCarga;
+
+static const char *const NOMES_OPERACOES[TOTAL_OPERACOES] = { "saquear", "descartar", "buscar" };
+
+typedef enum {
+    CONTADOR_BUSCAS_ENCONTRADAS,
+    CONTADOR_DESCARTES_VAZIOS,     // Descartes de itens que o jogador não tinha
+    CONTADOR_FALHAS,
+    TOTAL_CONTADORES
+} ContadorCarga;
+
+static const char *const NOMES_CONTADORES[TOTAL_CONTADORES] = { "buscas_encontradas", "descartes_vazios", "falhas" };
+
+// Configuração lida da linha de comando
+typedef struct {
+    int jogadores;
+    int threads;
+    int operacoes;
+    int fatias;
+    int leituras;
+    int itens;
+    unsigned int semente;
+    const char *caminhoSaida;
+} Configuracao;
+
+// Trabalho de uma thread simulada
+typedef struct {
+    MotorMultijogador *motor;
+    const Configuracao *cfg;
+    unsigned int estado;
+    Metricas *metricas;
+} TarefaCarga;
+
+// ---------------------------------------------
+// FUNÇÕES AUXILIARES
+// ---------------------------------------------
+
+/**
+ * @brief Gerador xorshift32: rápido, reprodutível e com estado próprio por thread.
+ */
+static unsigned int proximoAleatorio(unsigned int *estado) {
+    unsigned int x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *estado = x;
+}
+
+/**
+ * @brief Executa as operações de uma thread: jogador, item e operação sorteados a cada passo.
+ */
+static void executarCarga(void *argumento, int idThread) {
+    TarefaCarga *tarefa = argumento;
+    const Configuracao *cfg = tarefa->cfg;
+    Metricas *metricas = tarefa->metricas;
+    char nome[NOME_MAX];
+    (void)idThread;
+
+    for (int i = 0; i < cfg->operacoes; i++) {
+        int jogador = (int)(proximoAleatorio(&tarefa->estado) % (unsigned int)cfg->jogadores);
+        unsigned int item = proximoAleatorio(&tarefa->estado) % (unsigned int)cfg->itens;
+        int sorteio = (int)(proximoAleatorio(&tarefa->estado) % 300u);
+        snprintf(nome, sizeof(nome), "Item%04u", item);
+
+        uint64_t inicio = metricasAgoraNs();
+        if (sorteio < cfg->leituras * 3) {
+            Componente copia;
+            int resultado = multijogadorBuscar(tarefa->motor, jogador, nome, &copia);
+            metricasRegistrar(metricas, OPERACAO_BUSCAR, metricasAgoraNs() - inicio);
+            if (resultado >= 0) metricasSomar(metricas, CONTADOR_BUSCAS_ENCONTRADAS, 1);
+        } else if (sorteio < cfg->leituras * 3 + (100 - cfg->leituras) * 2) {
+            int resultado = multijogadorSaquear(tarefa->motor, jogador, nome, TIPOS_SINTETICOS[item % TOTAL_TIPOS_SINTETICOS],
+                                                PRIORIDADE_MIN + (int)(item % PRIORIDADE_MAX));
+            metricasRegistrar(metricas, OPERACAO_SAQUEAR, metricasAgoraNs() - inicio);
+            if (resultado < 0) metricasSomar(metricas, CONTADOR_FALHAS, 1);
+        } else {
+            int resultado = multijogadorDescartar(tarefa->motor, jogador, nome);
+            metricasRegistrar(metricas, OPERACAO_DESCARTAR, metricasAgoraNs() - inicio);
+            if (resultado < 0) metricasSomar(metricas, CONTADOR_DESCARTES_VAZIOS, 1);
+        }
+    }
+}
+
+/**
+ * @brief Dá a cada jogador metade dos itens possíveis, para as buscas e descartes terem alvo.
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+static int povoarMotor(MotorMultijogador *motor, const Configuracao *cfg) {
+    char nome[NOME_MAX];
+    for (int jogador = 0; jogador < cfg->jogadores; jogador++) {
+        for (int item = 0; item < cfg->itens; item += 2) {
+            snprintf(nome, sizeof(nome), "Item%04d", item);
+            if (multijogadorSaquear(motor, jogador, nome, TIPOS_SINTETICOS[item % TOTAL_TIPOS_SINTETICOS],
+                                    PRIORIDADE_MIN + item % PRIORIDADE_MAX) < 0) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+// FUNÇÃO PRINCIPAL
+// ---------------------------------------------
+
+int main(int argc, char *argv[]) {
+    Configuracao cfg = { JOGADORES_PADRAO, 0, OPERACOES_PADRAO, FATIAS_PADRAO, LEITURAS_PADRAO, ITENS_PADRAO, 42u, NULL };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--jogadores") == 0 && i + 1 < argc) {
+            cfg.jogadores = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            cfg.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--operacoes") == 0 && i + 1 < argc) {
+            cfg.operacoes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--fatias") == 0 && i + 1 < argc) {
+            cfg.fatias = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--leituras") == 0 && i + 1 < argc) {
+            cfg.leituras = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--itens") == 0 && i + 1 < argc) {
+            cfg.itens = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            cfg.semente = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc) {
+            cfg.caminhoSaida = argv[++i];
+        } else {
+            fprintf(stderr, "Uso: %s [--jogadores N] [--threads T] [--operacoes M] [--fatias S] "
+                            "[--leituras P] [--itens K] [--semente S] [--saida arquivo.csv]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (cfg.jogadores < 1) cfg.jogadores = 1;
+    if (cfg.operacoes < 0) cfg.operacoes = 0;
+    if (cfg.fatias < 1) cfg.fatias = 1;
+    if (cfg.leituras < 0) cfg.leituras = 0;
+    if (cfg.leituras > 100) cfg.leituras = 100;
+    if (cfg.itens < 1) cfg.itens = 1;
+    if (cfg.semente == 0) cfg.semente = 1; // xorshift não aceita estado zero
+    if (cfg.threads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        cfg.threads = nucleos > 0 ? (int)nucleos : 1;
+    }
+
+    MotorMultijogador motor;
+    PoolThreads pool;
+    if (!multijogadorCriar(&motor, cfg.fatias)) {
+        fprintf(stderr, "ERRO: Memoria insuficiente para o motor.\n");
+        return 1;
+    }
+    if (!poolCriar(&pool, cfg.threads)) {
+        fprintf(stderr, "ERRO: Nao foi possivel criar %d threads.\n", cfg.threads);
+        multijogadorDestruir(&motor);
+        return 1;
+    }
+
+    TarefaCarga *tarefas = malloc((size_t)cfg.threads * sizeof(TarefaCarga));
+    Metricas *porThread = malloc((size_t)cfg.threads * sizeof(Metricas));
+    Metricas *total = malloc(sizeof(Metricas));
+    int sucesso = tarefas != NULL && porThread != NULL && total != NULL && povoarMotor(&motor, &cfg);
+
+    if (sucesso) {
+        for (int t = 0; t < cfg.threads; t++) {
+            metricasInicializar(&porThread[t], NOMES_OPERACOES, TOTAL_OPERACOES, NOMES_CONTADORES, TOTAL_CONTADORES);
+            tarefas[t].motor = &motor;
+            tarefas[t].cfg = &cfg;
+            tarefas[t].estado = cfg.semente + (unsigned int)t * 0x9e3779b9u;
+            if (tarefas[t].estado == 0) tarefas[t].estado = 1;
+            tarefas[t].metricas = &porThread[t];
+        }
+
+        fprintf(stderr, "Simulando %d jogadores com %d threads (%d operacoes cada, %d fatias)...\n",
+                cfg.jogadores, cfg.threads, cfg.operacoes, motor.totalFatias);
+        uint64_t inicio = metricasAgoraNs();
+        poolExecutar(&pool, executarCarga, tarefas, sizeof(TarefaCarga), cfg.threads);
+        double segundos = (double)(metricasAgoraNs() - inicio) / 1e9;
+
+        metricasInicializar(total, NOMES_OPERACOES, TOTAL_OPERACOES, NOMES_CONTADORES, TOTAL_CONTADORES);
+        for (int t = 0; t < cfg.threads; t++) metricasCombinar(total, &porThread[t]);
+
+        long long operacoes = (long long)cfg.threads * cfg.operacoes;
+        printf("CARGA jogadores=%d threads=%d fatias=%d leituras=%d%% operacoes=%lld tempo=%.6f s (%.0f operacoes/s)\n",
+               cfg.jogadores, cfg.threads, motor.totalFatias, cfg.leituras, operacoes, segundos,
+               segundos > 0 ? operacoes / segundos : 0.0);
+        printf("Componentes nas mochilas ao final: %lld\n", multijogadorTotalComponentes(&motor));
+        metricasExibir(total);
+
+        if (!metricasSalvar(total, cfg.caminhoSaida)) {
+            fprintf(stderr, "ERRO: Nao foi possivel gravar \"%s\".\n", cfg.caminhoSaida);
+            sucesso = 0;
+        }
+    } else {
+        fprintf(stderr, "ERRO: Memoria insuficiente para preparar a carga.\n");
+    }
+
+    free(tarefas);
+    free(porThread);
+    free(total);
+    poolDestruir(&pool);
+    multijogadorDestruir(&motor);
+    return sucesso ? 0 : 1;
+}
@@ -1,21 +1,72 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h> // Necessário para strcpy, strcmp, strcspn
+#include <limits.h> // INT_MAX (limite de uma pilha de itens)
+#include <time.h>   // clock_gettime (resumo do modo lote)
+#include <unistd.h> // sysconf (núcleos disponíveis para a importação CSV)
+#include "inventario.h" // Núcleo da mochila: vetor, índices, empilhamento e snapshot
+#include "saida_buffer.h"
+#include "metricas.h"
+#include "csv_inventario.h"
 
 // ---------------------------------------------
 // REQUISITO 1: Criação da Struct Item
 // ---------------------------------------------
 
-// Define a capacidade máxima da mochila (Lista Sequencial Estática)
-#define CAPACIDADE_MAXIMA 10 
-// Define o tamanho máximo de caracteres para o nome do item
-#define NOME_MAX 30
-// Define o tamanho máximo de caracteres para o tipo do item
-#define TIPO_MAX 20 
+// Define a reserva inicial da mochila (Lista Sequencial Dinâmica, alterável com --reserva N)
+#define RESERVA_INICIAL_PADRAO 10
+// Define o tamanho máximo de caracteres para o nome do item (o do tipo é TIPO_MAX, de componente.h)
+#define NOME_ITEM_MAX 30
+// Tamanho máximo de uma linha de comando no modo lote
+#define LINHA_LOTE_MAX 256
+// Arquivo de snapshot padrão (alterável com --snapshot caminho, desativável com --sem-snapshot)
+#define SNAPSHOT_PADRAO "mochila_aventureiro.snap"
+// Percentual de lápides (slots removidos) que dispara a compactação automática
+#define LIMIAR_COMPACTACAO_PADRAO 25
+// Arquivo CSV das métricas gravado ao sair (alterável com --metricas caminho, desativável com --sem-metricas)
+#define METRICAS_PADRAO "metricas_aventureiro.csv"
 
-// Estrutura que representa um item dentro da mochila
+// Códigos de retorno das operações da mochila (os da biblioteca de inventário)
+#define OPERACAO_OK INVENTARIO_OK
+#define ERRO_MEMORIA INVENTARIO_ERRO_MEMORIA
+#define ERRO_QUANTIDADE INVENTARIO_ERRO_VALOR
+#define ERRO_NOME_INVALIDO INVENTARIO_ERRO_NOME_INVALIDO
+#define ERRO_NAO_ENCONTRADO INVENTARIO_ERRO_NAO_ENCONTRADO
+#define ERRO_TIPOS_ESGOTADOS INVENTARIO_ERRO_TIPOS_ESGOTADOS   // Dicionário de tipos cheio (TIPOS_DISTINTOS_MAX)
+#define ERRO_TIPO_DIVERGENTE INVENTARIO_ERRO_TIPO_DIVERGENTE   // O nome já está na mochila com outro tipo (não empilha)
+
+// Operações com histograma de latência próprio (a ordem segue NOMES_OPERACOES)
+typedef enum {
+    OPERACAO_INSERIR,
+    OPERACAO_REMOVER,
+    OPERACAO_BUSCAR,
+    OPERACAO_LISTAR,
+    OPERACAO_COMPACTAR,
+    OPERACAO_CONSULTA_TIPO,
+    OPERACAO_CARGA_LOTE,
+    OPERACAO_IMPORTAR_CSV,
+    OPERACAO_EXPORTAR_CSV,
+    TOTAL_OPERACOES
+} OperacaoMedida;
+
+static const char *const NOMES_OPERACOES[TOTAL_OPERACOES] = {
+    "inserir", "remover", "buscar", "listar", "compactar", "consulta_tipo", "carga_lote",
+    "importar_csv", "exportar_csv"
+};
+
+// Contadores acumulados (o nível Aventureiro não ordena: só há deslocamentos de itens)
+typedef enum {
+    CONTADOR_MOVIMENTACOES,  // Itens deslocados pela compactação
+    CONTADOR_EMPILHADOS,     // Loots somados a um item que já existia (sem ocupar slot novo)
+    TOTAL_CONTADORES
+} ContadorMedido;
+
+static const char *const NOMES_CONTADORES[TOTAL_CONTADORES] = { "movimentacoes", "empilhados" };
+
+// Estrutura de um item lido de um arquivo de loot. Também é o registro dos snapshots
+// gravados antes da biblioteca de inventário, que são convertidos na carga.
 typedef struct {
-    char nome[NOME_MAX];       // Nome do item (ex: KitMedico, Municao)
+    char nome[NOME_ITEM_MAX];  // Nome do item (ex: KitMedico, Municao)
     char tipo[TIPO_MAX];       // Tipo do item (ex: cura, municao, arma)
     int quantidade;            // Quantidade deste item
 } Item;
@@ -24,11 +75,35 @@ typedef struct {
 // REQUISITO 2: Vetor de Structs e Variáveis de Controle
 // ---------------------------------------------
 
-// A mochila é representada por um vetor de structs Item.
-Item mochila[CAPACIDADE_MAXIMA];
+// A mochila é um inventário da biblioteca (inventario.h) em que o valor de cada
+// componente é a quantidade e os nomes repetidos empilham. O vetor com lápides
+// (dobra ao encher, cai pela metade com 1/4 de ocupação), o índice hash de nomes,
+// o índice de tipos com as quantidades e o snapshot mapeado ficam dentro dele.
+Inventario mochila;
+// Trabalho interno da biblioteca já passado às métricas (ver acompanharInventario)
+ContadoresInventario contadoresVistos;
+
+// Persistência: caminho do snapshot (NULL = desativada)
+const char *caminhoSnapshot = SNAPSHOT_PADRAO;
+
+// Listagem montada em um buffer reaproveitado e escrita de uma vez.
+// --pagina N mostra N itens por vez (o cursor guarda onde a próxima página começa);
+// --silencioso desliga a listagem automática após inserir/remover.
+BufferSaida bufferListagem;
+int linhasPorPagina = 0;       // 0 = tabela inteira
+int cursorListagem = 0;        // Slot em que a próxima página começa
+int linhasJaListadas = 0;      // Linhas exibidas antes do cursor
+int listagemAutomatica = 1;
+
+// Latência de cada operação e contadores (opção 7 do menu, "stats" no modo lote)
+Metricas metricas;
+const char *caminhoMetricas = METRICAS_PADRAO;
 
-// Variável de controle: rastreia quantos itens (slots) estão ocupados na mochila.
-int totalItens = 0; 
+// Importação CSV: pool de threads que analisa e valida as linhas, criado no primeiro uso
+// (--threads N; 0 = um thread por núcleo disponível)
+int threadsImportacao = 0;
+PoolThreads poolImportacao;
+int poolImportacaoCriado = 0;
 
 // ---------------------------------------------
 // PROTÓTIPOS DAS FUNÇÕES OBRIGATÓRIAS
@@ -37,30 +112,154 @@ int totalItens = 0;
 void inserirItem();
 void removerItem();
 void listarItens();
+int montarLinhasItens(int slotInicial, int maximoLinhas, int formatoLote, int *linhasMontadas);
+int listarPaginaItens(int slotInicial);
+void navegarListagem();
 void buscarItem();
+void carregarLoot();
+void menuArquivosCsv();
+void resumoPorTipo();
+void exibirMetricas();
 void limparBuffer();
 void pausarSistema();
+void registrarOperacao(OperacaoMedida operacao, uint64_t inicioNs);
+void acompanharInventario();
+void liberarMochila();
+int compactarMochila();
+void executarCompactacao();
+int carregarSnapshotMochila();
+int converterSnapshotAntigo();
+int salvarSnapshotMochila();
+const char *descreverErro(int codigo);
+int adicionarItemNaMochila(const char *nome, const char *tipo, int quantidade, int *empilhado);
+int removerItemPorNome(const char *nome);
+int carregarItensEmLote(const Item *registros, int total, ResultadoLote *resultado);
+int lerArquivoLoot(const char *caminho, Item **registros, int *total, int *linhaInvalida);
+PoolThreads *obterPoolImportacao();
+int importarItensCsv(const char *caminho, ResumoImportacaoCsv *resumo);
+int exportarItensCsv(const char *caminho, int *exportados);
+int executarModoLote(FILE *entrada);
 
 // ---------------------------------------------
 // FUNÇÃO PRINCIPAL (main)
 // ---------------------------------------------
 
-int main() {
+int main(int argc, char *argv[]) {
     int opcao;
+    // Modo lote: ativado por --lote [arquivo] ou pela variável MOCHILA_LOTE ("-" = stdin)
+    const char *arquivoLote = getenv("MOCHILA_LOTE");
+    // Regras do nível Aventureiro: a quantidade vai de 1 a INT_MAX e nomes repetidos empilham
+    ConfiguracaoInventario configuracao;
+    inventarioConfiguracaoPadrao(&configuracao);
+    configuracao.reservaInicial = RESERVA_INICIAL_PADRAO;
+    configuracao.limiarCompactacao = LIMIAR_COMPACTACAO_PADRAO;
+    configuracao.valorMinimo = 1;
+    configuracao.valorMaximo = INT_MAX;
+    configuracao.nomeMax = NOME_ITEM_MAX;
+    configuracao.empilhar = 1;
+    configuracao.indicesPorValor = 0;
+
+    // Argumentos opcionais:
+    //   --reserva N         quantidade de slots pré-alocados
+    //   --lote [arquivo]    executa comandos de um arquivo (ou stdin) sem o menu
+    //   --snapshot caminho  arquivo de snapshot (padrão: mochila_aventureiro.snap)
+    //   --sem-snapshot      não carrega nem salva o snapshot
+    //   --limiar-compactacao P  compacta quando as lápides passam de P% dos slots (0 = só manual)
+    //   --pagina N          lista N itens por página (0 = tabela inteira)
+    //   --silencioso        não lista a mochila após inserir ou remover
+    //   --metricas caminho  CSV das métricas gravado ao sair (padrão: metricas_aventureiro.csv)
+    //   --sem-metricas      não grava o CSV das métricas
+    //   --threads N         threads da importação CSV (padrão: núcleos disponíveis)
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--lote") == 0) {
+            arquivoLote = (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) ? argv[++i] : "-";
+        } else if (strcmp(argv[i], "--reserva") == 0 && i + 1 < argc) {
+            int valor = atoi(argv[++i]);
+            if (valor > 0) configuracao.reservaInicial = valor;
+        } else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            caminhoSnapshot = argv[++i];
+        } else if (strcmp(argv[i], "--sem-snapshot") == 0) {
+            caminhoSnapshot = NULL;
+        } else if (strcmp(argv[i], "--limiar-compactacao") == 0 && i + 1 < argc) {
+            int valor = atoi(argv[++i]);
+            if (valor >= 0 && valor <= 100) configuracao.limiarCompactacao = valor;
+        } else if (strcmp(argv[i], "--pagina") == 0 && i + 1 < argc) {
+            int valor = atoi(argv[++i]);
+            if (valor >= 0) linhasPorPagina = valor;
+        } else if (strcmp(argv[i], "--silencioso") == 0) {
+            listagemAutomatica = 0;
+        } else if (strcmp(argv[i], "--metricas") == 0 && i + 1 < argc) {
+            caminhoMetricas = argv[++i];
+        } else if (strcmp(argv[i], "--sem-metricas") == 0) {
+            caminhoMetricas = NULL;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            int valor = atoi(argv[++i]);
+            if (valor > 0) threadsImportacao = valor;
+        }
+    }
+
+    if (threadsImportacao <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        threadsImportacao = nucleos > 0 ? (int)nucleos : 1;
+    }
+
+    if (!inventarioCriar(&mochila, &configuracao)) {
+        printf("ERRO: Memoria insuficiente para reservar a mochila.\n");
+        return 1;
+    }
+    bufferSaidaInicializar(&bufferListagem);
+    metricasInicializar(&metricas, NOMES_OPERACOES, TOTAL_OPERACOES, NOMES_CONTADORES, TOTAL_CONTADORES);
 
-    // A mochila começa vazia (totalItens = 0)
+    // Carga instantânea do inventário salvo na última execução
+    int resultadoCarga = carregarSnapshotMochila();
+    contadoresVistos = mochila.contadores; // A conversão de um snapshot antigo não entra nas métricas
+    if (resultadoCarga == SNAPSHOT_INVALIDO) {
+        printf("AVISO: Snapshot \"%s\" invalido ou de outra versao. Iniciando com a mochila vazia.\n", caminhoSnapshot);
+    }
+
+    if (arquivoLote != NULL) {
+        FILE *entrada = strcmp(arquivoLote, "-") == 0 ? stdin : fopen(arquivoLote, "r");
+        int erros = 1;
+        if (entrada == NULL) {
+            printf("ERRO: Nao foi possivel abrir o arquivo de lote \"%s\".\n", arquivoLote);
+        } else {
+            erros = executarModoLote(entrada);
+            if (entrada != stdin) fclose(entrada);
+            if (!salvarSnapshotMochila()) {
+                printf("ERRO: Nao foi possivel salvar o snapshot \"%s\".\n", caminhoSnapshot);
+                erros++;
+            }
+            if (!metricasSalvar(&metricas, caminhoMetricas)) {
+                printf("ERRO: Nao foi possivel gravar as metricas em \"%s\".\n", caminhoMetricas);
+                erros++;
+            }
+        }
+        liberarMochila();
+        return entrada == NULL ? 1 : (erros > 0 ? 2 : 0);
+    }
+
+    // A mochila começa vazia (mochila.totalComponentes = 0), a menos que exista um snapshot
     printf("--- INICIANDO JOGO: CODIGO DA ILHA ---\n");
+    if (resultadoCarga == SNAPSHOT_OK) {
+        printf("Snapshot \"%s\" carregado: %d itens.\n", caminhoSnapshot, mochila.totalComponentes);
+    }
     
     do {
         // --- REQUISITO: Usabilidade (Interface Clara) ---
         printf("\n============================================\n");
         printf("MOCHILA DE SOBREVIVENCIA - CODIGO DA ILHA\n");
         printf("============================================\n");
-        printf("Itens na Mochila: %d/%d\n", totalItens, CAPACIDADE_MAXIMA);
+        printf("Itens na Mochila: %d (capacidade alocada: %d, lapides: %d)\n", mochila.totalComponentes, mochila.capacidade,
+               mochila.slotsUsados - mochila.totalComponentes);
         printf("1. Adicionar Item (Loot)\n");
         printf("2. Remover Item\n");
         printf("3. Listar Itens na Mochila\n");
         printf("4. Buscar Item por Nome\n");
+        printf("5. Compactar Mochila (remover lapides)\n");
+        printf("6. Resumo por Tipo (quantidades)\n");
+        printf("7. Estatisticas de Desempenho (latencia por operacao)\n");
+        printf("8. Carregar Loot em Lote (arquivo)\n");
+        printf("9. Importar/Exportar CSV\n");
         printf("0. Sair\n");
         printf("--------------------------------------------\n");
         printf("Escolha uma opcao: ");
@@ -79,14 +278,42 @@ int main() {
                 removerItem();
                 break;
             case 3:
-                listarItens();
-                pausarSistema();
+                navegarListagem();
                 break;
             case 4:
                 buscarItem();
                 pausarSistema();
                 break;
+            case 5:
+                executarCompactacao();
+                break;
+            case 6:
+                resumoPorTipo();
+                pausarSistema();
+                break;
+            case 7:
+                exibirMetricas();
+                pausarSistema();
+                break;
+            case 8:
+                carregarLoot();
+                pausarSistema();
+                break;
+            case 9:
+                menuArquivosCsv();
+                pausarSistema();
+                break;
             case 0:
+                if (!salvarSnapshotMochila()) {
+                    printf("\nERRO: Nao foi possivel salvar o snapshot \"%s\".\n", caminhoSnapshot);
+                } else if (caminhoSnapshot != NULL) {
+                    printf("\nMochila salva em \"%s\".\n", caminhoSnapshot);
+                }
+                if (!metricasSalvar(&metricas, caminhoMetricas)) {
+                    printf("ERRO: Nao foi possivel gravar as metricas em \"%s\".\n", caminhoMetricas);
+                } else if (caminhoMetricas != NULL) {
+                    printf("Metricas gravadas em \"%s\".\n", caminhoMetricas);
+                }
                 printf("\nFechando inventário. Sobrevivência concluída!\n");
                 break;
             default:
@@ -94,6 +321,7 @@ int main() {
         }
     } while (opcao != 0);
 
+    liberarMochila();
     return 0;
 }
 
@@ -120,26 +348,297 @@ void pausarSistema() {
 }
 
 /**
- * @brief Cadastra um novo item na mochila (Lista Sequencial).
+ * @brief Registra a latência de uma operação iniciada em inicioNs (metricasAgoraNs).
  */
-void inserirItem() {
-    // Verifica se a mochila está cheia
-    if (totalItens >= CAPACIDADE_MAXIMA) {
-        printf("\nERRO: Mochila cheia! (%d/%d) Nao e possivel adicionar mais itens.\n", totalItens, CAPACIDADE_MAXIMA);
-        return;
+void registrarOperacao(OperacaoMedida operacao, uint64_t inicioNs) {
+    metricasRegistrar(&metricas, operacao, metricasAgoraNs() - inicioNs);
+    acompanharInventario();
+}
+
+/**
+ * @brief Passa às métricas o trabalho que a biblioteca fez por dentro desde a última
+ * chamada: itens deslocados, loots empilhados e, se houve compactação, a duração dela.
+ */
+void acompanharInventario() {
+    const ContadoresInventario *atual = &mochila.contadores;
+    metricasSomar(&metricas, CONTADOR_MOVIMENTACOES, atual->movimentacoes - contadoresVistos.movimentacoes);
+    metricasSomar(&metricas, CONTADOR_EMPILHADOS, atual->empilhados - contadoresVistos.empilhados);
+    if (atual->compactacoes != contadoresVistos.compactacoes) {
+        metricasRegistrar(&metricas, OPERACAO_COMPACTAR, atual->nsUltimaCompactacao);
+    }
+    contadoresVistos = *atual;
+}
+
+/**
+ * @brief Libera a mochila (heap ou mapeamento do snapshot), o buffer e o pool.
+ */
+void liberarMochila() {
+    if (poolImportacaoCriado) {
+        poolDestruir(&poolImportacao);
+        poolImportacaoCriado = 0;
+    }
+    bufferSaidaLiberar(&bufferListagem);
+    inventarioDestruir(&mochila);
+}
+
+/**
+ * @brief Remove as lápides movendo os itens para frente, na mesma ordem.
+ * @return Quantidade de slots recuperados.
+ */
+int compactarMochila() {
+    int recuperados = inventarioCompactar(&mochila);
+    acompanharInventario();
+    return recuperados;
+}
+
+/**
+ * @brief Compacta a mochila sob demanda e informa quantos slots foram recuperados.
+ */
+void executarCompactacao() {
+    int recuperados = compactarMochila();
+    if (recuperados == 0) {
+        printf("\nNenhuma lapide na mochila. Nada para compactar.\n");
+    } else {
+        printf("\nSUCESSO: %d slot(s) recuperados. Capacidade alocada: %d.\n", recuperados, mochila.capacidade);
     }
+}
+
+/**
+ * @brief Carrega a mochila do snapshot mapeado em memória (sem parsing nem cópia).
+ * Um snapshot antigo, de registros Item, é convertido (ver converterSnapshotAntigo).
+ * @return SNAPSHOT_OK, SNAPSHOT_INEXISTENTE ou SNAPSHOT_INVALIDO.
+ */
+int carregarSnapshotMochila() {
+    if (caminhoSnapshot == NULL) return SNAPSHOT_INEXISTENTE;
+
+    int resultado = inventarioCarregarSnapshot(&mochila, caminhoSnapshot, NULL);
+    if (resultado == SNAPSHOT_INVALIDO) resultado = converterSnapshotAntigo();
+    return resultado;
+}
+
+/**
+ * @brief Lê um snapshot do formato antigo (um Item por registro) e carrega os itens
+ * pela carga em lote. O arquivo só é regravado no formato novo ao sair.
+ * @return SNAPSHOT_OK, ou SNAPSHOT_INVALIDO se o arquivo também não for do formato antigo.
+ */
+int converterSnapshotAntigo() {
+    SnapshotMapeado snapshot;
+    if (abrirSnapshot(caminhoSnapshot, SNAPSHOT_REGISTRO_ITEM, sizeof(Item), &snapshot) != SNAPSHOT_OK ||
+        snapshot.totalRegistros > (size_t)0x7fffffff) {
+        return SNAPSHOT_INVALIDO;
+    }
+
+    // Os textos do mapeamento podem não ter '\0' se o arquivo estiver corrompido
+    const Item *itens = snapshot.registros;
+    int valido = 1;
+    for (size_t i = 0; i < snapshot.totalRegistros && valido; i++) {
+        valido = memchr(itens[i].nome, '\0', NOME_ITEM_MAX) != NULL && memchr(itens[i].tipo, '\0', TIPO_MAX) != NULL;
+    }
+    ResultadoLote resultado;
+    if (valido) valido = carregarItensEmLote(itens, (int)snapshot.totalRegistros, &resultado) == OPERACAO_OK;
+    fecharSnapshot(&snapshot);
+    return valido ? SNAPSHOT_OK : SNAPSHOT_INVALIDO;
+}
+
+/**
+ * @brief Grava a mochila atual no snapshot (chamado ao sair), já sem lápides.
+ * @return 1 em caso de sucesso ou persistência desativada, 0 em caso de erro.
+ */
+int salvarSnapshotMochila() {
+    if (caminhoSnapshot == NULL) return 1;
+    int sucesso = inventarioSalvarSnapshot(&mochila, caminhoSnapshot, 0);
+    acompanharInventario(); // A gravação compacta a mochila antes
+    return sucesso;
+}
+
+/**
+ * @brief Texto curto de um código de erro das operações da mochila (menu e modo lote).
+ */
+const char *descreverErro(int codigo) {
+    switch (codigo) {
+        case ERRO_QUANTIDADE: return "quantidade invalida ou pilha acima do limite";
+        case ERRO_NOME_INVALIDO: return "nome vazio ou nome/tipo muito longo";
+        case ERRO_NAO_ENCONTRADO: return "item nao encontrado";
+        case ERRO_TIPO_DIVERGENTE: return "o nome ja existe com outro tipo";
+        case ERRO_TIPOS_ESGOTADOS: return "limite de tipos distintos atingido";
+        default: return "memoria insuficiente";
+    }
+}
+
+/**
+ * @brief Guarda um loot na mochila (sem interação). Se o nome já está na mochila, a
+ * quantidade é somada ao item existente (empilha); senão, o item entra no fim.
+ * A localização usa o índice de nomes, então os dois casos custam O(1) esperado.
+ * @param empilhado Recebe 1 se a quantidade foi somada a um item existente (pode ser NULL).
+ * @return O slot do item (>= 0) ou um código de erro (< 0).
+ */
+int adicionarItemNaMochila(const char *nome, const char *tipo, int quantidade, int *empilhado) {
+    uint64_t inicio = metricasAgoraNs();
+    int slot = inventarioAdicionar(&mochila, nome, tipo, quantidade, empilhado);
+    if (slot >= 0) registrarOperacao(OPERACAO_INSERIR, inicio);
+    return slot;
+}
+
+/**
+ * @brief Remove o item com o nome informado (sem interação).
+ * O slot vira uma lápide em O(1); a compactação roda quando as lápides passam do limiar.
+ * @return O slot que o item ocupava (>= 0), ERRO_NAO_ENCONTRADO ou ERRO_MEMORIA.
+ */
+int removerItemPorNome(const char *nome) {
+    uint64_t inicio = metricasAgoraNs();
+    int slot = inventarioRemover(&mochila, nome);
+    if (slot != ERRO_MEMORIA) registrarOperacao(OPERACAO_REMOVER, inicio);
+    return slot;
+}
+
+/**
+ * @brief Carrega um lote inteiro de loots de uma vez, com a mesma regra de empilhar do
+ * adicionarItemNaMochila, em tempo linear no tamanho do lote (inventarioCarregarLote).
+ * Qualquer registro inválido ou falta de memória deixa a mochila exatamente como estava.
+ * @param resultado Recebe as contagens e, em caso de erro, o registro que o causou.
+ * @return OPERACAO_OK ou o código de erro do primeiro registro que impediu a carga.
+ */
+int carregarItensEmLote(const Item *registros, int total, ResultadoLote *resultado) {
+    uint64_t inicio = metricasAgoraNs();
+    RegistroInventario *lote = malloc((size_t)(total > 0 ? total : 1) * sizeof(RegistroInventario));
+    if (lote == NULL) {
+        memset(resultado, 0, sizeof(*resultado));
+        resultado->registros = total;
+        resultado->registroInvalido = -1;
+        return ERRO_MEMORIA;
+    }
+    for (int i = 0; i < total; i++) {
+        lote[i] = (RegistroInventario){ registros[i].nome, registros[i].tipo, registros[i].quantidade };
+    }
+    int codigo = inventarioCarregarLote(&mochila, lote, total, resultado);
+    free(lote);
+    if (codigo == OPERACAO_OK && total > 0) registrarOperacao(OPERACAO_CARGA_LOTE, inicio);
+    return codigo;
+}
+
+/**
+ * @brief Lê um arquivo de loot (uma linha "nome tipo quantidade" por registro; linhas
+ * vazias e iniciadas por '#' são ignoradas) para um vetor de registros.
+ * @param registros Recebe o vetor alocado (liberar com free, mesmo vazio).
+ * @param linhaInvalida Recebe a linha com formato inválido ou texto longo demais.
+ * @return OPERACAO_OK, ERRO_NAO_ENCONTRADO (arquivo não abriu), ERRO_NOME_INVALIDO
+ * (linha inválida) ou ERRO_MEMORIA.
+ */
+int lerArquivoLoot(const char *caminho, Item **registros, int *total, int *linhaInvalida) {
+    *registros = NULL;
+    *total = 0;
+    *linhaInvalida = 0;
+    FILE *arquivo = fopen(caminho, "r");
+    if (arquivo == NULL) return ERRO_NAO_ENCONTRADO;
+
+    char linha[LINHA_LOTE_MAX];
+    int capacidade = 0;
+    int numeroLinha = 0;
+    int codigo = OPERACAO_OK;
+    while (codigo == OPERACAO_OK && fgets(linha, sizeof(linha), arquivo) != NULL) {
+        numeroLinha++;
+        char *nome = strtok(linha, " \t\r\n");
+        if (nome == NULL || nome[0] == '#') continue;
+        char *tipo = strtok(NULL, " \t\r\n");
+        char *quantidade = strtok(NULL, " \t\r\n");
+        if (quantidade == NULL || strlen(nome) >= NOME_ITEM_MAX || strlen(tipo) >= TIPO_MAX) {
+            *linhaInvalida = numeroLinha;
+            codigo = ERRO_NOME_INVALIDO;
+            break;
+        }
+
+        if (*total == capacidade) {
+            int novaCapacidade = capacidade > 0 ? capacidade * 2 : RESERVA_INICIAL_PADRAO;
+            Item *novos = realloc(*registros, (size_t)novaCapacidade * sizeof(Item));
+            if (novos == NULL) {
+                codigo = ERRO_MEMORIA;
+                break;
+            }
+            *registros = novos;
+            capacidade = novaCapacidade;
+        }
+        Item *registro = &(*registros)[(*total)++];
+        strcpy(registro->nome, nome);
+        strcpy(registro->tipo, tipo);
+        registro->quantidade = atoi(quantidade);
+    }
+    fclose(arquivo);
+    return codigo;
+}
+
+/**
+ * @brief Pool da importação CSV, criado no primeiro uso.
+ * @return O pool, ou NULL se não foi possível criar as threads (a importação roda sem elas).
+ */
+PoolThreads *obterPoolImportacao() {
+    if (!poolImportacaoCriado) {
+        if (!poolCriar(&poolImportacao, threadsImportacao)) return NULL;
+        poolImportacaoCriado = 1;
+    }
+    return &poolImportacao;
+}
+
+/**
+ * @brief Acrescenta à mochila um registro já validado pela importação CSV (empilhando).
+ */
+static int aceitarItemCsv(void *contexto, const RegistroCsv *registro) {
+    (void)contexto;
+    return adicionarItemNaMochila(registro->nome, registro->tipo, registro->valor, NULL) >= 0;
+}
+
+/**
+ * @brief Importa itens de um CSV "nome,tipo,quantidade" direto para a mochila.
+ * As linhas são analisadas e validadas pelas threads do pool; cada linha aceita passa
+ * por adicionarItemNaMochila (nomes repetidos empilham, tipo divergente é rejeitado).
+ * @return CSV_OK, CSV_ERRO_ARQUIVO ou CSV_ERRO_MEMORIA.
+ */
+int importarItensCsv(const char *caminho, ResumoImportacaoCsv *resumo) {
+    RegrasCsv regras = { NOME_ITEM_MAX, TIPO_MAX, 1, INT_MAX };
+    uint64_t inicio = metricasAgoraNs();
+    int resultado = csvImportar(caminho, obterPoolImportacao(), &regras, aceitarItemCsv, NULL, resumo);
+    registrarOperacao(OPERACAO_IMPORTAR_CSV, inicio);
+    return resultado;
+}
+
+/**
+ * @brief Exporta os itens vivos, na ordem da mochila, para um CSV que importarItensCsv lê de volta.
+ * @return CSV_OK ou CSV_ERRO_ARQUIVO.
+ */
+int exportarItensCsv(const char *caminho, int *exportados) {
+    uint64_t inicio = metricasAgoraNs();
+    *exportados = 0;
+    FILE *saida = fopen(caminho, "w");
+    if (saida == NULL) return CSV_ERRO_ARQUIVO;
+    setvbuf(saida, NULL, _IOFBF, 1 << 16);
+
+    int sucesso = csvEscreverCabecalho(saida, "quantidade");
+    for (int slot = 0; slot < mochila.slotsUsados && sucesso; slot++) {
+        if (!inventarioSlotVivo(&mochila, slot)) continue;
+        sucesso = csvEscreverRegistro(saida, inventarioNome(&mochila, slot), inventarioTipo(&mochila, slot),
+                                      inventarioValor(&mochila, slot));
+        if (sucesso) (*exportados)++;
+    }
+    if (fclose(saida) != 0) sucesso = 0;
+    registrarOperacao(OPERACAO_EXPORTAR_CSV, inicio);
+    return sucesso ? CSV_OK : CSV_ERRO_ARQUIVO;
+}
 
+/**
+ * @brief Cadastra um novo item na mochila (Lista Sequencial).
+ */
+void inserirItem() {
     // --- REQUISITO: Leitura de dados (fgets para strings seguras) ---
 
-    // Posição de inserção é o primeiro índice livre (totalItens)
-    Item *novoItem = &mochila[totalItens];
+    // Os dados são lidos em uma struct local e inseridos no fim da mochila
+    Item lido;
+    Item *novoItem = &lido;
 
     printf("\n--- ADICIONAR ITEM (LOOT) ---\n");
 
     // Lendo o Nome
-    printf("Nome do Item (max %d): ", NOME_MAX - 1);
+    printf("Nome do Item (max %d): ", NOME_ITEM_MAX - 1);
     // Uso de fgets para leitura segura e prevenção de buffer overflow
-    if (fgets(novoItem->nome, NOME_MAX, stdin) == NULL) return;
+    if (fgets(novoItem->nome, NOME_ITEM_MAX, stdin) == NULL) return;
     // Remove o caractere de nova linha '\n' adicionado pelo fgets
     novoItem->nome[strcspn(novoItem->nome, "\n")] = 0; 
 
@@ -157,10 +656,35 @@ void inserirItem() {
     }
     limparBuffer(); // Limpa o buffer após scanf
 
-    // Incrementa o contador da mochila
-    totalItens++;
-    printf("\nSUCESSO: Item \"%s\" adicionado a mochila!\n", novoItem->nome);
-    listarItens(); // --- REQUISITO: Listar após cada operação ---
+    int empilhado;
+    int resultado = adicionarItemNaMochila(novoItem->nome, novoItem->tipo, novoItem->quantidade, &empilhado);
+    if (resultado == ERRO_NOME_INVALIDO) {
+        printf("ERRO: %s. Cancelando insercao.\n", descreverErro(resultado));
+        return;
+    }
+    if (resultado == ERRO_TIPO_DIVERGENTE) {
+        printf("ERRO: Ja existe um item \"%s\" de outro tipo na mochila. Cancelando insercao.\n", novoItem->nome);
+        return;
+    }
+    if (resultado == ERRO_QUANTIDADE) {
+        printf("ERRO: A pilha de \"%s\" passaria do limite de %d unidades. Cancelando insercao.\n", novoItem->nome, INT_MAX);
+        return;
+    }
+    if (resultado == ERRO_TIPOS_ESGOTADOS) {
+        printf("ERRO: Limite de %d tipos distintos atingido. Cancelando insercao.\n", TIPOS_DISTINTOS_MAX);
+        return;
+    }
+    if (resultado < 0) {
+        printf("ERRO: Memoria insuficiente para indexar o item. Cancelando insercao.\n");
+        return;
+    }
+
+    if (empilhado) {
+        printf("\nSUCESSO: Item \"%s\" empilhado: agora ha %d na mochila!\n", novoItem->nome, inventarioValor(&mochila, resultado));
+    } else {
+        printf("\nSUCESSO: Item \"%s\" adicionado a mochila!\n", novoItem->nome);
+    }
+    if (listagemAutomatica) listarItens(); // --- REQUISITO: Listar após cada operação ---
     pausarSistema();
 }
 
@@ -168,43 +692,26 @@ void inserirItem() {
  * @brief Remove um item da mochila pelo nome (Busca Sequencial e Deslocamento).
  */
 void removerItem() {
-    if (totalItens == 0) {
+    if (mochila.totalComponentes == 0) {
         printf("\nERRO: A mochila esta vazia. Nao ha o que remover.\n");
         return;
     }
 
-    char nomeBusca[NOME_MAX];
+    char nomeBusca[NOME_ITEM_MAX];
     int posEncontrada = -1; // Posição do item a ser removido
 
     printf("\n--- REMOVER ITEM ---\n");
     printf("Digite o nome exato do item para remover: ");
     
     // Leitura do nome a ser buscado
-    if (fgets(nomeBusca, NOME_MAX, stdin) == NULL) return;
+    if (fgets(nomeBusca, NOME_ITEM_MAX, stdin) == NULL) return;
     nomeBusca[strcspn(nomeBusca, "\n")] = 0;
 
-    // --- REQUISITO: Uso de Laços (for) para percorrer o vetor ---
-    for (int i = 0; i < totalItens; i++) {
-        // strcmp retorna 0 se as strings forem idênticas
-        if (strcmp(mochila[i].nome, nomeBusca) == 0) {
-            posEncontrada = i;
-            break; // Item encontrado, para a busca
-        }
-    }
-
-    if (posEncontrada != -1) {
-        printf("\nSUCESSO: Item \"%s\" removido da posicao %d.\n", mochila[posEncontrada].nome, posEncontrada + 1);
-
-        // Deslocamento dos elementos:
-        // Move cada item subsequente uma posição para trás, fechando o "buraco".
-        for (int i = posEncontrada; i < totalItens - 1; i++) {
-            // Copia a struct completa (ou campo por campo)
-            mochila[i] = mochila[i+1]; 
-        }
+    posEncontrada = removerItemPorNome(nomeBusca);
 
-        // Decrementa o contador da mochila
-        totalItens--;
-        listarItens(); // --- REQUISITO: Listar após cada operação ---
+    if (posEncontrada >= 0) {
+        printf("\nSUCESSO: Item \"%s\" removido da posicao %d.\n", nomeBusca, posEncontrada + 1);
+        if (listagemAutomatica) listarItens(); // --- REQUISITO: Listar após cada operação ---
         pausarSistema();
     } else {
         printf("\nERRO: Item \"%s\" nao encontrado na mochila.\n", nomeBusca);
@@ -212,64 +719,475 @@ void removerItem() {
 }
 
 /**
- * @brief Lista todos os itens e seus dados na mochila.
+ * @brief Lista todos os itens e seus dados na mochila (primeira página, se houver paginação).
  */
 void listarItens() {
-    if (totalItens == 0) {
+    listarPaginaItens(0);
+}
+
+/**
+ * @brief Acrescenta ao buffer de listagem as linhas dos itens vivos a partir de um slot.
+ * @param maximoLinhas Limite de linhas (0 = até o fim da mochila).
+ * @param formatoLote 1 = "nome tipo quantidade" (modo lote), 0 = linha da tabela.
+ * @param linhasMontadas Recebe a quantidade de linhas acrescentadas.
+ * @return Slot em que a próxima página começa (mochila.slotsUsados quando não há mais linhas).
+ */
+int montarLinhasItens(int slotInicial, int maximoLinhas, int formatoLote, int *linhasMontadas) {
+    int linhas = 0;
+    int slot = slotInicial;
+
+    for (; slot < mochila.slotsUsados && (maximoLinhas <= 0 || linhas < maximoLinhas); slot++) {
+        if (!inventarioSlotVivo(&mochila, slot)) continue;
+        const char *nome = inventarioNome(&mochila, slot);
+        const char *tipo = inventarioTipo(&mochila, slot);
+        if (formatoLote) {
+            bufferSaidaFormatar(&bufferListagem, "%s %s %d\n", nome, tipo, inventarioValor(&mochila, slot));
+        } else {
+            bufferSaidaFormatar(&bufferListagem, "| %-*s | %-*s | %-10d |\n",
+                                NOME_ITEM_MAX - 1, nome, TIPO_MAX - 1, tipo, inventarioValor(&mochila, slot));
+        }
+        linhas++;
+    }
+    // Pula as lápides seguintes para o cursor indicar se ainda há linhas
+    while (slot < mochila.slotsUsados && !inventarioSlotVivo(&mochila, slot)) slot++;
+
+    *linhasMontadas = linhas;
+    return slot;
+}
+
+/**
+ * @brief Exibe uma página da tabela (ou a tabela inteira, sem paginação) com uma única escrita.
+ * @param slotInicial 0 para a primeira página, ou cursorListagem para continuar.
+ * @return 1 se ainda houver páginas depois desta.
+ */
+int listarPaginaItens(int slotInicial) {
+    if (mochila.totalComponentes == 0) {
         printf("\n--- MOCHILA VAZIA ---\n");
-        return;
+        return 0;
     }
+    if (slotInicial == 0) linhasJaListadas = 0;
+    uint64_t inicio = metricasAgoraNs();
 
     // --- REQUISITO: Saída formatada como na imagem de exemplo ---
-    printf("\n--------------------------------------------\n");
-    printf("| %-*s | %-*s | %-*s |\n", NOME_MAX - 1, "NOME", TIPO_MAX - 1, "TIPO", 10, "QUANTIDADE");
-    printf("--------------------------------------------\n");
+    bufferSaidaFormatar(&bufferListagem, "\n--------------------------------------------\n");
+    bufferSaidaFormatar(&bufferListagem, "| %-*s | %-*s | %-*s |\n",
+                        NOME_ITEM_MAX - 1, "NOME", TIPO_MAX - 1, "TIPO", 10, "QUANTIDADE");
+    bufferSaidaFormatar(&bufferListagem, "--------------------------------------------\n");
+
+    int linhas;
+    cursorListagem = montarLinhasItens(slotInicial, linhasPorPagina, 0, &linhas);
+    int haMais = cursorListagem < mochila.slotsUsados;
 
-    for (int i = 0; i < totalItens; i++) {
-        printf("| %-*s | %-*s | %-10d |\n", 
-               NOME_MAX - 1, mochila[i].nome, 
-               TIPO_MAX - 1, mochila[i].tipo, 
-               mochila[i].quantidade);
+    bufferSaidaFormatar(&bufferListagem, "--------------------------------------------\n");
+    if (linhasPorPagina > 0) {
+        bufferSaidaFormatar(&bufferListagem, "Exibindo %d-%d de %d itens%s.\n", linhasJaListadas + 1,
+                            linhasJaListadas + linhas, mochila.totalComponentes, haMais ? " (ha mais paginas)" : "");
+    } else {
+        bufferSaidaFormatar(&bufferListagem, "Total de %d itens diferentes na mochila.\n", mochila.totalComponentes);
     }
-    printf("--------------------------------------------\n");
-    printf("Total de %d itens diferentes na mochila.\n", totalItens);
+    linhasJaListadas += linhas;
+    bufferSaidaDescarregar(&bufferListagem);
+    registrarOperacao(OPERACAO_LISTAR, inicio);
+    return haMais;
+}
+
+/**
+ * @brief Lista a mochila página por página (opção 3 do menu).
+ */
+void navegarListagem() {
+    int haMais = listarPaginaItens(0);
+
+    while (haMais) {
+        char resposta[8];
+        printf("\nEnter = proxima pagina, 0 = voltar ao menu: ");
+        if (fgets(resposta, sizeof(resposta), stdin) == NULL || resposta[0] == '0') return;
+        haMais = listarPaginaItens(cursorListagem);
+    }
+    pausarSistema();
 }
 
 /**
  * @brief Busca um item pelo nome e exibe seus dados.
  */
 void buscarItem() {
-    if (totalItens == 0) {
+    if (mochila.totalComponentes == 0) {
         printf("\nERRO: A mochila esta vazia. Nada para buscar.\n");
         return;
     }
 
-    char nomeBusca[NOME_MAX];
+    char nomeBusca[NOME_ITEM_MAX];
     int posEncontrada = -1;
 
-    printf("\n--- BUSCA SEQUENCIAL ---\n");
+    printf("\n--- BUSCA POR NOME (INDICE HASH) ---\n");
     printf("Digite o nome exato do item para buscar: ");
     
     // Leitura do nome a ser buscado
-    if (fgets(nomeBusca, NOME_MAX, stdin) == NULL) return;
+    if (fgets(nomeBusca, NOME_ITEM_MAX, stdin) == NULL) return;
     nomeBusca[strcspn(nomeBusca, "\n")] = 0;
 
-    // --- REQUISITO: Busca Sequencial ---
-    for (int i = 0; i < totalItens; i++) {
-        if (strcmp(mochila[i].nome, nomeBusca) == 0) {
-            posEncontrada = i;
-            break;
-        }
-    }
+    // Busca em O(1) esperado pelo índice hash (mesmo resultado da busca sequencial)
+    uint64_t inicio = metricasAgoraNs();
+    posEncontrada = inventarioBuscar(&mochila, nomeBusca);
+    registrarOperacao(OPERACAO_BUSCAR, inicio);
 
-    if (posEncontrada != -1) {
-        Item *item = &mochila[posEncontrada];
+    if (posEncontrada >= 0) {
         printf("\n--- ITEM ENCONTRADO ---\n");
-        printf("Nome: %s\n", item->nome);
-        printf("Tipo: %s\n", item->tipo);
-        printf("Quantidade: %d\n", item->quantidade);
+        printf("Nome: %s\n", inventarioNome(&mochila, posEncontrada));
+        printf("Tipo: %s\n", inventarioTipo(&mochila, posEncontrada));
+        printf("Quantidade: %d\n", inventarioValor(&mochila, posEncontrada));
         printf("Posicao no Inventario (Indice): %d\n", posEncontrada);
     } else {
         printf("\nRESULTADO: Item \"%s\" nao foi encontrado na mochila.\n", nomeBusca);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Mostra, para cada tipo, quantos itens diferentes e quantas unidades há na mochila.
+ * Usa o índice secundário: o custo depende só do número de tipos (e do tipo listado).
+ */
+void resumoPorTipo() {
+    if (mochila.totalComponentes == 0) {
+        printf("\nERRO: A mochila esta vazia. Nada para resumir.\n");
+        return;
+    }
+    const IndiceTipo *indiceTipos = inventarioTipos(&mochila);
+    if (indiceTipos == NULL) {
+        printf("\nERRO: Memoria insuficiente para montar o indice de tipos.\n");
+        return;
+    }
+
+    printf("\n--------------------------------------------\n");
+    printf("| %-*s | %-5s | %-10s |\n", TIPO_MAX - 1, "TIPO", "ITENS", "QUANTIDADE");
+    printf("--------------------------------------------\n");
+    for (int g = 0; g < indiceTipos->totalGrupos; g++) {
+        const GrupoTipo *grupo = &indiceTipos->grupos[g];
+        if (grupo->vivos > 0) {
+            printf("| %-*s | %-5d | %-10lld |\n", TIPO_MAX - 1, grupo->tipo, grupo->vivos, grupo->quantidadeTotal);
+        }
+    }
+    printf("--------------------------------------------\n");
+
+    char tipoBusca[TIPO_MAX];
+    printf("Tipo para listar (Enter para voltar): ");
+    if (fgets(tipoBusca, TIPO_MAX, stdin) == NULL) return;
+    tipoBusca[strcspn(tipoBusca, "\n")] = 0;
+    if (tipoBusca[0] == '\0') return;
+
+    uint64_t inicio = metricasAgoraNs();
+    const GrupoTipo *grupo = indiceTipoBuscar(indiceTipos, tipoBusca);
+    int total = grupo != NULL ? grupo->vivos : 0;
+    int *slots = malloc((size_t)total * sizeof(int) + 1);
+    if (slots == NULL) {
+        printf("ERRO: Memoria insuficiente para listar o resultado.\n");
+        return;
+    }
+    int encontrados = indiceTipoListar(indiceTipos, tipoBusca, slots, total);
+    registrarOperacao(OPERACAO_CONSULTA_TIPO, inicio);
+    if (encontrados == 0) printf("Nenhum item do tipo \"%s\" na mochila.\n", tipoBusca);
+    for (int i = 0; i < encontrados; i++) {
+        printf("| %-*s | %-*s | %-10d |\n", NOME_ITEM_MAX - 1, inventarioNome(&mochila, slots[i]), TIPO_MAX - 1,
+               inventarioTipo(&mochila, slots[i]), inventarioValor(&mochila, slots[i]));
+    }
+    free(slots);
+}
+
+/**
+ * @brief Carrega um arquivo de loot inteiro de uma vez (opção 8 do menu).
+ */
+void carregarLoot() {
+    char caminho[LINHA_LOTE_MAX];
+    printf("\n--- CARREGAR LOOT EM LOTE ---\n");
+    printf("Arquivo (uma linha \"nome tipo quantidade\" por item): ");
+    if (fgets(caminho, sizeof(caminho), stdin) == NULL) return;
+    caminho[strcspn(caminho, "\n")] = 0;
+
+    Item *registros;
+    int total, linhaInvalida;
+    int codigo = lerArquivoLoot(caminho, &registros, &total, &linhaInvalida);
+    if (codigo == ERRO_NAO_ENCONTRADO) {
+        printf("ERRO: Nao foi possivel abrir o arquivo \"%s\".\n", caminho);
+    } else if (codigo == ERRO_NOME_INVALIDO) {
+        printf("ERRO: Linha %d invalida (esperado: nome tipo quantidade). Nada foi carregado.\n", linhaInvalida);
+    } else if (codigo != OPERACAO_OK) {
+        printf("ERRO: Memoria insuficiente para ler o arquivo. Nada foi carregado.\n");
+    } else {
+        ResultadoLote resultado;
+        codigo = carregarItensEmLote(registros, total, &resultado);
+        if (codigo == OPERACAO_OK) {
+            printf("\nSUCESSO: %d registro(s) carregados: %d item(ns) novo(s), %d empilhado(s). Itens na mochila: %d.\n",
+                   resultado.registros, resultado.novos, resultado.empilhados, mochila.totalComponentes);
+        } else if (resultado.registroInvalido >= 0) {
+            printf("ERRO: Registro %d (\"%s\") recusado: %s. Nada foi carregado.\n", resultado.registroInvalido + 1,
+                   registros[resultado.registroInvalido].nome, descreverErro(codigo));
+        } else {
+            printf("ERRO: Lote recusado: %s. Nada foi carregado.\n", descreverErro(codigo));
+        }
+    }
+    free(registros);
+}
+
+/**
+ * @brief Importa ou exporta a mochila em CSV (opção 9 do menu).
+ */
+void menuArquivosCsv() {
+    int opcao;
+    printf("\n--- ARQUIVOS CSV (nome,tipo,quantidade) ---\n");
+    printf("1. Importar (acrescenta a mochila)\n2. Exportar\n");
+    printf("Opcao: ");
+    if (scanf("%d", &opcao) != 1 || opcao < 1 || opcao > 2) {
+        limparBuffer();
+        printf("Opcao invalida.\n");
+        return;
+    }
+    limparBuffer();
+
+    char caminho[LINHA_LOTE_MAX];
+    printf("Arquivo: ");
+    if (fgets(caminho, sizeof(caminho), stdin) == NULL) return;
+    caminho[strcspn(caminho, "\n")] = 0;
+
+    if (opcao == 2) {
+        int exportados;
+        if (exportarItensCsv(caminho, &exportados) == CSV_OK) {
+            printf("\nSUCESSO: %d item(ns) exportados para \"%s\".\n", exportados, caminho);
+        } else {
+            printf("\nERRO: Nao foi possivel gravar \"%s\".\n", caminho);
+        }
+        return;
+    }
+
+    ResumoImportacaoCsv resumo;
+    int resultado = importarItensCsv(caminho, &resumo);
+    if (resultado == CSV_ERRO_ARQUIVO) {
+        printf("\nERRO: Nao foi possivel ler \"%s\".\n", caminho);
+        return;
+    }
+    if (resultado == CSV_ERRO_MEMORIA) printf("\nERRO: Memoria insuficiente. A importacao parou no meio.\n");
+    printf("\n%lld linha(s): %lld importada(s), %lld rejeitada(s) em %.3f s (%.0f linhas/s, %d thread(s)).\n",
+           resumo.linhas, resumo.aceitos, resumo.rejeitados, resumo.segundos,
+           resumo.segundos > 0 ? resumo.linhas / resumo.segundos : 0.0, threadsImportacao);
+    for (int i = 0; i < resumo.totalRejeicoesGuardadas; i++) {
+        printf("  Linha %lld rejeitada: %s\n", resumo.primeirasRejeicoes[i].linha,
+               csvNomeMotivo(resumo.primeirasRejeicoes[i].motivo));
+    }
+    if (resumo.rejeitados > resumo.totalRejeicoesGuardadas) {
+        printf("  ... e mais %lld.\n", resumo.rejeitados - resumo.totalRejeicoesGuardadas);
+    }
+}
+
+/**
+ * @brief Exibe a latência de cada operação já executada (média, p50, p90, p99 e máximo)
+ * e os contadores acumulados desde o início do programa.
+ */
+void exibirMetricas() {
+    printf("\n--- ESTATISTICAS DE DESEMPENHO ---\n");
+    metricasExibir(&metricas);
+    if (caminhoMetricas != NULL) printf("\nO CSV completo sera gravado em \"%s\" ao sair.\n", caminhoMetricas);
+}
+
+// ---------------------------------------------
+// MODO LOTE (SCRIPT)
+// ---------------------------------------------
+
+/**
+ * @brief Relógio monotônico em segundos (usado no resumo do modo lote).
+ */
+static double agoraSegundos() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Executa um fluxo de comandos sem menu, pausas ou listagens automáticas.
+ *
+ * Um comando por linha (linhas vazias e iniciadas por '#' são ignoradas):
+ *   add <nome> <tipo> <quantidade>   (se o nome já existe, soma a quantidade)
+ *   loot <arquivo>      (carga em lote: linhas "nome tipo quantidade", aplicadas juntas)
+ *   del <nome>
+ *   find <nome>
+ *   list
+ *   page <n>            (primeiras n linhas; "next" mostra as n seguintes)
+ *   next
+ *   compact
+ *   types               (itens e quantidade total de cada tipo)
+ *   type <tipo>         (itens de um tipo, pelo índice secundário)
+ *   stats               (métricas de latência e contadores em CSV)
+ *   import <arquivo.csv>  (acrescenta os registros "nome,tipo,quantidade" válidos, empilhando)
+ *   export <arquivo.csv>  (grava os itens vivos na ordem da mochila)
+ * ("sort" é reconhecido, mas o nível Aventureiro não tem ordenação.)
+ * @return Quantidade de comandos que falharam.
+ */
+int executarModoLote(FILE *entrada) {
+    char linha[LINHA_LOTE_MAX];
+    long long comandos = 0, erros = 0;
+    int numeroLinha = 0;
+
+    // Saída totalmente bufferizada: milhares de resultados viram poucas chamadas de escrita
+    setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+    double inicio = agoraSegundos();
+
+    while (fgets(linha, sizeof(linha), entrada) != NULL) {
+        numeroLinha++;
+        char *comando = strtok(linha, " \t\r\n");
+        if (comando == NULL || comando[0] == '#') continue;
+
+        char *arg1 = strtok(NULL, " \t\r\n");
+        char *arg2 = strtok(NULL, " \t\r\n");
+        char *arg3 = strtok(NULL, " \t\r\n");
+        int sucesso = 0;
+        comandos++;
+
+        if (strcmp(comando, "add") == 0 && arg3 != NULL) {
+            int resultado = adicionarItemNaMochila(arg1, arg2, atoi(arg3), NULL);
+            if (resultado >= 0) {
+                sucesso = 1;
+            } else if (resultado == ERRO_QUANTIDADE) {
+                printf("ERRO linha %d: quantidade invalida \"%s\"\n", numeroLinha, arg3);
+            } else if (resultado == ERRO_NOME_INVALIDO) {
+                printf("ERRO linha %d: nome ou tipo muito longo\n", numeroLinha);
+            } else if (resultado == ERRO_TIPO_DIVERGENTE) {
+                printf("ERRO linha %d: item \"%s\" ja existe com outro tipo\n", numeroLinha, arg1);
+            } else if (resultado == ERRO_TIPOS_ESGOTADOS) {
+                printf("ERRO linha %d: limite de tipos distintos atingido\n", numeroLinha);
+            } else {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            }
+        } else if (strcmp(comando, "loot") == 0 && arg1 != NULL) {
+            Item *registros;
+            int total, linhaInvalida;
+            ResultadoLote resultado;
+            int codigo = lerArquivoLoot(arg1, &registros, &total, &linhaInvalida);
+            if (codigo == ERRO_NAO_ENCONTRADO) {
+                printf("ERRO linha %d: nao foi possivel abrir \"%s\"\n", numeroLinha, arg1);
+            } else if (codigo == ERRO_NOME_INVALIDO) {
+                printf("ERRO linha %d: \"%s\" linha %d invalida\n", numeroLinha, arg1, linhaInvalida);
+            } else if (codigo != OPERACAO_OK) {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            } else if ((codigo = carregarItensEmLote(registros, total, &resultado)) != OPERACAO_OK) {
+                if (resultado.registroInvalido >= 0) {
+                    printf("ERRO linha %d: \"%s\" registro %d recusado: %s\n", numeroLinha, arg1,
+                           resultado.registroInvalido + 1, descreverErro(codigo));
+                } else {
+                    printf("ERRO linha %d: lote \"%s\" recusado: %s\n", numeroLinha, arg1, descreverErro(codigo));
+                }
+            } else {
+                printf("CARGA registros=%d novos=%d empilhados=%d itens=%d\n", resultado.registros, resultado.novos,
+                       resultado.empilhados, mochila.totalComponentes);
+                sucesso = 1;
+            }
+            free(registros);
+        } else if (strcmp(comando, "del") == 0 && arg1 != NULL) {
+            sucesso = removerItemPorNome(arg1) >= 0;
+            if (!sucesso) printf("ERRO linha %d: item \"%s\" nao encontrado\n", numeroLinha, arg1);
+        } else if (strcmp(comando, "find") == 0 && arg1 != NULL) {
+            uint64_t inicioOperacao = metricasAgoraNs();
+            int pos = inventarioBuscar(&mochila, arg1);
+            registrarOperacao(OPERACAO_BUSCAR, inicioOperacao);
+            if (pos >= 0) {
+                printf("ENCONTRADO %s %s %d %d\n", inventarioNome(&mochila, pos), inventarioTipo(&mochila, pos),
+                       inventarioValor(&mochila, pos), pos);
+            } else {
+                printf("NAO_ENCONTRADO %s\n", arg1);
+            }
+            sucesso = 1;
+        } else if (strcmp(comando, "list") == 0) {
+            uint64_t inicioOperacao = metricasAgoraNs();
+            int linhas;
+            montarLinhasItens(0, 0, 1, &linhas);
+            sucesso = bufferSaidaDescarregar(&bufferListagem);
+            registrarOperacao(OPERACAO_LISTAR, inicioOperacao);
+        } else if (strcmp(comando, "page") == 0 || strcmp(comando, "next") == 0) {
+            // "page N" lista as N primeiras linhas; "next" continua do cursor com o mesmo tamanho
+            if (comando[0] == 'p') {
+                linhasPorPagina = arg1 != NULL ? atoi(arg1) : linhasPorPagina;
+                cursorListagem = 0;
+            }
+            uint64_t inicioOperacao = metricasAgoraNs();
+            int linhas;
+            cursorListagem = montarLinhasItens(cursorListagem, linhasPorPagina, 1, &linhas);
+            bufferSaidaFormatar(&bufferListagem, "PAGINA linhas=%d fim=%d\n", linhas, cursorListagem >= mochila.slotsUsados);
+            sucesso = bufferSaidaDescarregar(&bufferListagem);
+            registrarOperacao(OPERACAO_LISTAR, inicioOperacao);
+        } else if (strcmp(comando, "types") == 0) {
+            const IndiceTipo *indiceTipos = inventarioTipos(&mochila);
+            if (indiceTipos != NULL) {
+                for (int g = 0; g < indiceTipos->totalGrupos; g++) {
+                    const GrupoTipo *grupo = &indiceTipos->grupos[g];
+                    if (grupo->vivos > 0) {
+                        printf("TIPO %s itens=%d quantidade=%lld\n", grupo->tipo, grupo->vivos, grupo->quantidadeTotal);
+                    }
+                }
+                sucesso = 1;
+            } else {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            }
+        } else if (strcmp(comando, "type") == 0 && arg1 != NULL) {
+            const IndiceTipo *indiceTipos = inventarioTipos(&mochila);
+            if (indiceTipos == NULL) {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            } else {
+                uint64_t inicioOperacao = metricasAgoraNs();
+                const GrupoTipo *grupo = indiceTipoBuscar(indiceTipos, arg1);
+                int total = grupo != NULL ? grupo->vivos : 0;
+                int *slots = malloc((size_t)total * sizeof(int) + 1);
+                if (slots == NULL) {
+                    printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+                } else {
+                    int encontrados = indiceTipoListar(indiceTipos, arg1, slots, total);
+                    registrarOperacao(OPERACAO_CONSULTA_TIPO, inicioOperacao);
+                    printf("TIPO %s total=%d quantidade=%lld\n", arg1, encontrados,
+                           grupo != NULL ? grupo->quantidadeTotal : 0LL);
+                    for (int i = 0; i < encontrados; i++) {
+                        printf("%s %s %d\n", inventarioNome(&mochila, slots[i]), inventarioTipo(&mochila, slots[i]),
+                               inventarioValor(&mochila, slots[i]));
+                    }
+                    free(slots);
+                    sucesso = 1;
+                }
+            }
+        } else if (strcmp(comando, "compact") == 0) {
+            printf("COMPACTADO recuperados=%d capacidade=%d\n", compactarMochila(), mochila.capacidade);
+            sucesso = 1;
+        } else if (strcmp(comando, "stats") == 0) {
+            // CSV no mesmo formato do arquivo gravado ao sair, depois do que já foi impresso
+            sucesso = metricasExportar(&metricas, stdout);
+        } else if (strcmp(comando, "import") == 0 && arg1 != NULL) {
+            ResumoImportacaoCsv resumo;
+            int resultado = importarItensCsv(arg1, &resumo);
+            if (resultado == CSV_ERRO_ARQUIVO) {
+                printf("ERRO linha %d: nao foi possivel ler \"%s\"\n", numeroLinha, arg1);
+            } else {
+                printf("IMPORTADO linhas=%lld aceitos=%lld rejeitados=%lld tempo=%.6f linhas/s=%.0f\n", resumo.linhas,
+                       resumo.aceitos, resumo.rejeitados, resumo.segundos,
+                       resumo.segundos > 0 ? resumo.linhas / resumo.segundos : 0.0);
+                for (int i = 0; i < resumo.totalRejeicoesGuardadas; i++) {
+                    printf("REJEITADA linha=%lld motivo=%s\n", resumo.primeirasRejeicoes[i].linha,
+                           csvNomeMotivo(resumo.primeirasRejeicoes[i].motivo));
+                }
+                sucesso = resultado == CSV_OK;
+                if (!sucesso) printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            }
+        } else if (strcmp(comando, "export") == 0 && arg1 != NULL) {
+            int exportados;
+            sucesso = exportarItensCsv(arg1, &exportados) == CSV_OK;
+            if (sucesso) {
+                printf("EXPORTADO registros=%d\n", exportados);
+            } else {
+                printf("ERRO linha %d: nao foi possivel gravar \"%s\"\n", numeroLinha, arg1);
+            }
+        } else if (strcmp(comando, "sort") == 0) {
+            printf("ERRO linha %d: ordenacao disponivel apenas no nivel Mestre\n", numeroLinha);
+        } else {
+            printf("ERRO linha %d: comando invalido \"%s\"\n", numeroLinha, comando);
+        }
+
+        if (!sucesso) erros++;
+    }
+
+    double tempoTotal = agoraSegundos() - inicio;
+    printf("RESUMO comandos=%lld erros=%lld itens=%d tempo=%.6f s (%.0f comandos/s)\n",
+           comandos, erros, mochila.totalComponentes, tempoTotal, tempoTotal > 0 ? comandos / tempoTotal : 0.0);
+    fflush(stdout);
+    return (int)(erros > 0x7fffffff ? 0x7fffffff : erros);
+}
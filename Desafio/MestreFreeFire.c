@@ -1,30 +1,136 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h> // Necessário para medir o tempo (clock())
+#include <time.h> // clock_gettime (resumo do modo lote)
+#include <unistd.h> // sysconf (núcleos disponíveis para a ordenação paralela)
+#include "inventario.h" // Núcleo da mochila: vetor, arena, índices, ordenação e snapshot
+#include "diario.h"
+#include "saida_buffer.h"
+#include "metricas.h"
+#include "csv_inventario.h"
 
 // ---------------------------------------------
 // DEFINIÇÕES E ESTRUTURAS
 // ---------------------------------------------
 
-// Capacidade máxima de componentes na mochila
-#define CAPACIDADE_MAXIMA 20 
-// Tamanhos máximos das strings
-#define NOME_MAX 30
-#define TIPO_MAX 20
-
-// Estrutura que representa um Componente da Torre de Fuga
-typedef struct {
-    char nome[NOME_MAX];       // Nome do componente
-    char tipo[TIPO_MAX];       // Tipo do componente (controle, suporte, propulsão, etc.)
-    int prioridade;            // Prioridade de montagem (1 a 10)
-} Componente;
-
-// Variáveis de estado global para controle da mochila
-Componente mochila[CAPACIDADE_MAXIMA];
-int totalComponentes = 0; 
-// Status de ordenação: 0 = NÃO ORDENADO, 1 = ORDENADO POR NOME
-int statusOrdenacao = 0; 
+// Reserva inicial de componentes na mochila (alterável com --reserva N)
+#define RESERVA_INICIAL_PADRAO 16
+// Tamanho máximo de uma linha de comando no modo lote (cabe um nome de NOME_MAX - 1 bytes)
+#define LINHA_LOTE_MAX 1024
+// Largura da coluna de nome nas tabelas (um nome mais longo só alarga a própria linha)
+#define LARGURA_NOME_TABELA 29
+// Arquivo de snapshot padrão (alterável com --snapshot caminho, desativável com --sem-snapshot)
+#define SNAPSHOT_PADRAO "mochila_mestre.snap"
+// Percentual de lápides (slots descartados) que dispara a compactação automática
+#define LIMIAR_COMPACTACAO_PADRAO 25
+// Arquivo CSV das métricas gravado ao sair (alterável com --metricas caminho, desativável com --sem-metricas)
+#define METRICAS_PADRAO "metricas_mestre.csv"
+// Diário de operações reaplicado sobre o snapshot (alterável com --diario caminho, desativável com --sem-diario)
+#define DIARIO_PADRAO "mochila_mestre.diario"
+// Commit em grupo: registros por fdatasync (--grupo-diario N) e espera máxima de um registro pendente
+#define GRUPO_DIARIO_PADRAO 64
+#define INTERVALO_DIARIO_MS 10
+// Registros no diário que disparam um checkpoint (--checkpoint N; 0 = só ao sair)
+#define CHECKPOINT_PADRAO 10000
+
+// Códigos de retorno das operações da mochila (os da biblioteca de inventário)
+#define OPERACAO_OK INVENTARIO_OK
+#define ERRO_MEMORIA INVENTARIO_ERRO_MEMORIA
+#define ERRO_PRIORIDADE INVENTARIO_ERRO_VALOR
+#define ERRO_NOME_INVALIDO INVENTARIO_ERRO_NOME_INVALIDO
+#define ERRO_NAO_ENCONTRADO INVENTARIO_ERRO_NAO_ENCONTRADO
+#define ERRO_TIPOS_ESGOTADOS INVENTARIO_ERRO_TIPOS_ESGOTADOS   // Dicionário de tipos cheio (TIPOS_DISTINTOS_MAX)
+
+// Operações com histograma de latência próprio (a ordem segue NOMES_OPERACOES)
+typedef enum {
+    OPERACAO_ADICIONAR,
+    OPERACAO_DESCARTAR,
+    OPERACAO_BUSCA_HASH,
+    OPERACAO_BUSCA_BINARIA,
+    OPERACAO_ORDENAR,
+    OPERACAO_ORDENAR_PARALELO,
+    OPERACAO_CONSULTA_PRIORIDADE,
+    OPERACAO_MAIOR_PRIORIDADE,
+    OPERACAO_CONSULTA_TIPO,
+    OPERACAO_VISAO,
+    OPERACAO_COMPACTAR,
+    OPERACAO_LISTAR,
+    OPERACAO_PROXIMOS_MONTAGEM,
+    OPERACAO_MONTAR,
+    OPERACAO_ALTERAR_PRIORIDADE,
+    OPERACAO_BUSCA_INTERVALO,
+    OPERACAO_IMPORTAR_CSV,
+    OPERACAO_EXPORTAR_CSV,
+    TOTAL_OPERACOES
+} OperacaoMedida;
+
+static const char *const NOMES_OPERACOES[TOTAL_OPERACOES] = {
+    "adicionar", "descartar", "buscar_hash", "busca_binaria", "ordenar", "ordenar_paralelo",
+    "consulta_prioridade", "maior_prioridade", "consulta_tipo", "visao", "compactar", "listar",
+    "proximos_montagem", "montar", "alterar_prioridade", "busca_intervalo",
+    "importar_csv", "exportar_csv"
+};
+
+// Contadores acumulados de todas as operações
+typedef enum {
+    CONTADOR_COMPARACOES,
+    CONTADOR_TROCAS,         // Trocas e movimentações feitas pelos algoritmos de ordenação
+    CONTADOR_MOVIMENTACOES,  // Componentes deslocados fora da ordenação (compactação, inserção ordenada)
+    CONTADOR_DESEMPATES,     // Comparações de texto que precisaram de strcmp após o prefixo
+    TOTAL_CONTADORES
+} ContadorMedido;
+
+static const char *const NOMES_CONTADORES[TOTAL_CONTADORES] = {
+    "comparacoes", "trocas", "movimentacoes", "desempates_strcmp"
+};
+
+// Registros do diário. Dados: parâmetro a, parâmetro b, parâmetro c, nome\0, tipo\0.
+// A reaplicação chama as mesmas operações do núcleo, então a ordem dos slots
+// (e com ela os desempates por slot) volta exatamente como estava.
+typedef enum {
+    REGISTRO_ADICIONAR = 1,      // a = prioridade, nome, tipo
+    REGISTRO_DESCARTAR,          // nome
+    REGISTRO_ALTERAR_PRIORIDADE, // a = nova prioridade, nome
+    REGISTRO_MONTAR,             // (sem dados) topo da fila de montagem
+    REGISTRO_ORDENAR,            // a = critério, b = algoritmo, c = ordenação indireta
+    REGISTRO_MODO,               // a = modo sempre ordenado
+    REGISTRO_ORDENAR_COMPOSTO    // a = algoritmo, nome = ordem composta ("tipo,-prioridade,nome")
+} TipoRegistroDiario;
+
+// A mochila é um inventário da biblioteca (inventario.h): o vetor com lápides, a arena
+// de nomes, os índices (nomes, baldes de prioridade, tipos e fila de montagem), as
+// visões ordenadas e o snapshot mapeado ficam todos dentro dele. Este arquivo cuida
+// do menu, do modo lote, das métricas e do diário.
+Inventario mochila;
+// Trabalho interno da biblioteca já passado às métricas (ver acompanharInventario)
+ContadoresInventario contadoresVistos;
+// Ordenação paralela: pool de threads criado no primeiro uso e reaproveitado
+// (--threads N; 0 = um thread por núcleo disponível)
+int threadsOrdenacao = 0;
+PoolThreads poolOrdenacao;
+int poolOrdenacaoCriado = 0;
+// Caminho do snapshot binário (NULL = persistência desativada)
+const char *caminhoSnapshot = SNAPSHOT_PADRAO;
+// Listagem: as linhas são montadas em um buffer reaproveitado e escritas de uma vez.
+// Com --pagina N a tabela mostra N linhas por vez e o cursor guarda onde a próxima
+// página começa; --silencioso desliga a listagem automática após adicionar/descartar.
+BufferSaida bufferListagem;
+int linhasPorPagina = 0;       // 0 = tabela inteira
+int cursorListagem = 0;        // Slot em que a próxima página começa
+int linhasJaListadas = 0;      // Linhas exibidas antes do cursor
+int listagemAutomatica = 1;
+// Latência de cada operação e contadores de trabalho (opção 12 do menu, "stats" no modo lote)
+Metricas metricas;
+const char *caminhoMetricas = METRICAS_PADRAO;
+// Diário write-ahead: toda alteração vira um registro; o snapshot é o checkpoint.
+// Ao abrir, o diário da mesma geração do snapshot é reaplicado sobre ele.
+Diario diario;
+int diarioAtivo = 0;
+int reaplicandoDiario = 0;     // Durante a reaplicação nada é registrado de novo
+const char *caminhoDiario = DIARIO_PADRAO;
+int registrosPorGrupo = GRUPO_DIARIO_PADRAO;
+int limiteCheckpoint = CHECKPOINT_PADRAO;
+uint32_t geracaoSnapshot = 0;  // Geração do último checkpoint carregado ou gravado
 
 // ---------------------------------------------
 // PROTÓTIPOS DAS FUNÇÕES
@@ -32,25 +138,75 @@ int statusOrdenacao = 0;
 
 // Funções Auxiliares
 void limparBuffer();
+int lerLinha(char *destino, int tamanho);
 void pausarSistema();
-void trocar(Componente *a, Componente *b); // Implementação movida para o topo
+void registrarOperacao(OperacaoMedida operacao, uint64_t inicioNs);
+void somarEstatisticasOrdenacao(const EstatisticasOrdenacao *estatisticas);
+
+// Acompanhamento do Inventário
+const char *nomeDoComponente(const Componente *componente);
+void acompanharInventario();
+void liberarMochila();
+int compactarMochila();
+
+// Operações da mochila sem interação (núcleo usado pelo menu e pelo modo lote)
+int inserirComponente(const char *nome, const char *tipo, int prioridade);
+int removerComponente(const char *nome);
+int alterarPrioridade(const char *nome, int novaPrioridade);
+int montarProximoComponente(Componente *montado, char *nomeMontado);
+int ordenarMochila(CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo, EstatisticasOrdenacao *estatisticas);
+PoolThreads *obterPoolOrdenacao();
+int ordenarMochilaParalelo(CriterioOrdenacao criterio, EstatisticasOrdenacao *estatisticas, EstatisticasThread *porThread);
+int ordenarMochilaComposta(const OrdemComposta *ordem, AlgoritmoOrdenacao algoritmo, EstatisticasOrdenacao *estatisticas);
+int definirModoSempreOrdenado(int ativo);
+int importarComponentesCsv(const char *caminho, ResumoImportacaoCsv *resumo);
+int exportarComponentesCsv(const char *caminho, int *exportados);
+const VisaoOrdenada *obterVisao(CriterioOrdenacao criterio, EstatisticasOrdenacao *estatisticas);
+int prepararOrdemPorNome();
 
 // Funções de Gerenciamento da Mochila
 void adicionarComponente();
 void descartarComponente();
 void listarComponentes();
+int montarLinhasComponentes(int slotInicial, int maximoLinhas, int formatoLote, int *linhasMontadas);
+int listarPaginaComponentes(int slotInicial);
+void navegarListagem();
 
 // Funções de Ordenação (Medem tempo e comparações)
-void bubbleSortNome();
-void insertionSortTipo();
-void selectionSortPrioridade();
+void executarOrdenacao(CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo);
+void executarOrdenacaoParalela(CriterioOrdenacao criterio);
+void menuOrdenacaoComposta();
 
 // Funções de Busca
+void buscarComponentePorNome();
 void buscaBinariaPorNome();
+void buscarIntervaloNomes();
+void consultarPorPrioridade();
+void consultarPorTipo();
+void exibirFilaMontagem();
+void alterarPrioridadeComponente();
+void exibirVisaoOrdenada();
+
+// Manutenção
+void executarCompactacao();
+void menuArquivosCsv();
+void alternarModoSempreOrdenado();
+void exibirMetricas();
 
 // Menu
 void menuOrganizarMochila();
 
+// Modo Lote
+int executarModoLote(FILE *entrada);
+
+// Persistência (Snapshot)
+int carregarSnapshotMochila(double *tempoMs);
+int salvarSnapshotMochila();
+int abrirDiarioMochila(ReaplicacaoDiario *reaplicacao, double *tempoMs);
+void registrarNoDiario(TipoRegistroDiario tipo, int a, int b, int c, const char *nome, const char *tipoComponente);
+int reaplicarRegistroDiario(uint8_t tipo, const void *dados, size_t tamanho, void *contexto);
+void checkpointSeNecessario();
+
 // ---------------------------------------------
 // IMPLEMENTAÇÃO DAS FUNÇÕES AUXILIARES
 // ---------------------------------------------
@@ -63,6 +219,24 @@ void limparBuffer() {
     while ((c = getchar()) != '\n' && c != EOF) {}
 }
 
+/**
+ * @brief Lê uma linha do stdin sem o '\n'. Uma linha que não cabe no destino é
+ * descartada por inteiro (em vez de truncada e com o resto sobrando na entrada).
+ * @return 1 se a linha foi lida, 0 em fim de arquivo, -1 se ela era longa demais.
+ */
+int lerLinha(char *destino, int tamanho) {
+    if (fgets(destino, tamanho, stdin) == NULL) return 0;
+    size_t comprimento = strcspn(destino, "\n");
+    if (destino[comprimento] == '\n') {
+        destino[comprimento] = '\0';
+        return 1;
+    }
+    if (feof(stdin)) return 1;
+    limparBuffer();
+    destino[0] = '\0';
+    return -1;
+}
+
 /**
  * @brief Pausa o sistema até o usuário pressionar Enter.
  */
@@ -73,36 +247,261 @@ void pausarSistema() {
 }
 
 /**
- * @brief Troca dois componentes de posição na memória.
- * Esta função é crucial para os algoritmos de ordenação.
+ * @brief Registra a latência de uma operação iniciada em inicioNs (metricasAgoraNs).
+ */
+void registrarOperacao(OperacaoMedida operacao, uint64_t inicioNs) {
+    metricasRegistrar(&metricas, operacao, metricasAgoraNs() - inicioNs);
+    acompanharInventario();
+}
+
+/**
+ * @brief Acumula nos contadores o trabalho de uma ordenação ou montagem de visão.
+ */
+void somarEstatisticasOrdenacao(const EstatisticasOrdenacao *estatisticas) {
+    metricasSomar(&metricas, CONTADOR_COMPARACOES, estatisticas->comparacoes);
+    metricasSomar(&metricas, CONTADOR_TROCAS, estatisticas->trocas);
+    metricasSomar(&metricas, CONTADOR_DESEMPATES, estatisticas->desempatesTexto);
+}
+
+// ---------------------------------------------
+// ACOMPANHAMENTO DO INVENTÁRIO
+// ---------------------------------------------
+
+/**
+ * @brief Texto do nome de um componente da mochila (na arena de nomes).
+ * Vale até a próxima inserção ou compactação, que podem mover a arena.
+ */
+const char *nomeDoComponente(const Componente *componente) {
+    return nomeNaArena(&mochila.nomes, componente);
+}
+
+/**
+ * @brief Passa às métricas o trabalho que a biblioteca fez por dentro desde a última
+ * chamada: componentes deslocados e, se a mochila foi compactada, a duração disso.
+ */
+void acompanharInventario() {
+    const ContadoresInventario *atual = &mochila.contadores;
+    metricasSomar(&metricas, CONTADOR_MOVIMENTACOES, atual->movimentacoes - contadoresVistos.movimentacoes);
+    if (atual->compactacoes != contadoresVistos.compactacoes) {
+        metricasRegistrar(&metricas, OPERACAO_COMPACTAR, atual->nsUltimaCompactacao);
+    }
+    contadoresVistos = *atual;
+}
+
+/**
+ * @brief Libera a memória da mochila ao encerrar o programa.
+ */
+void liberarMochila() {
+    if (poolOrdenacaoCriado) {
+        poolDestruir(&poolOrdenacao);
+        poolOrdenacaoCriado = 0;
+    }
+    bufferSaidaLiberar(&bufferListagem);
+    if (diarioAtivo) {
+        diarioFechar(&diario);
+        diarioAtivo = 0;
+    }
+    inventarioDestruir(&mochila);
+}
+
+/**
+ * @brief Remove as lápides (na mesma ordem) e registra a compactação nas métricas.
+ * @return Quantidade de slots recuperados.
  */
-void trocar(Componente *a, Componente *b) {
-    Componente temp = *a;
-    *a = *b;
-    *b = temp;
+int compactarMochila() {
+    int recuperados = inventarioCompactar(&mochila);
+    acompanharInventario();
+    return recuperados;
 }
 
 // ---------------------------------------------
 // FUNÇÃO PRINCIPAL (main)
 // ---------------------------------------------
 
-int main() {
+int main(int argc, char *argv[]) {
     int opcao;
+    // Modo lote: ativado por --lote [arquivo] ou pela variável MOCHILA_LOTE ("-" = stdin)
+    const char *arquivoLote = getenv("MOCHILA_LOTE");
+    ConfiguracaoInventario configuracao;
+    inventarioConfiguracaoPadrao(&configuracao);
+    configuracao.reservaInicial = RESERVA_INICIAL_PADRAO;
+    configuracao.limiarCompactacao = LIMIAR_COMPACTACAO_PADRAO;
+    // Opções que só podem ser aplicadas depois de a mochila existir
+    int modoPedido = 0;
+    int ordenacaoIndireta = 0;
+    AlgoritmoOrdenacao algoritmos[TOTAL_CRITERIOS];
+    int algoritmoEscolhido[TOTAL_CRITERIOS] = { 0 };
+
+    // Argumentos opcionais:
+    //   --reserva N                    quantidade de slots pré-alocados
+    //   --algoritmo-<criterio> <id>    algoritmo padrão do critério (ex: --algoritmo-nome mergesort)
+    //   --lote [arquivo]               executa comandos de um arquivo (ou stdin) sem o menu
+    //   --snapshot caminho             arquivo de snapshot (padrão: mochila_mestre.snap)
+    //   --sem-snapshot                 não carrega nem salva o snapshot
+    //   --limiar-compactacao P         compacta quando as lápides passam de P% dos slots (0 = só manual)
+    //   --sempre-ordenado              mantém a mochila sempre ordenada por nome
+    //   --ordenacao-indireta           ordena índices e aplica a permutação uma vez no final
+    //   --threads N                    threads da ordenação paralela e da importação CSV (padrão: núcleos disponíveis)
+    //   --pagina N                     lista N componentes por página (0 = tabela inteira)
+    //   --silencioso                   não lista a mochila após adicionar ou descartar
+    //   --metricas caminho             CSV das métricas gravado ao sair (padrão: metricas_mestre.csv)
+    //   --sem-metricas                 não grava o CSV das métricas
+    //   --diario caminho               diário de operações (padrão: mochila_mestre.diario)
+    //   --sem-diario                   não registra nem reaplica operações (também desligado com --sem-snapshot)
+    //   --grupo-diario N               registros confirmados por fdatasync (commit em grupo)
+    //   --checkpoint N                 grava o snapshot e recomeça o diário a cada N registros (0 = só ao sair)
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--lote") == 0) {
+            arquivoLote = (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) ? argv[++i] : "-";
+        } else if (strcmp(argv[i], "--reserva") == 0 && i + 1 < argc) {
+            int valor = atoi(argv[++i]);
+            if (valor > 0) configuracao.reservaInicial = valor;
+        } else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            caminhoSnapshot = argv[++i];
+        } else if (strcmp(argv[i], "--sem-snapshot") == 0) {
+            caminhoSnapshot = NULL;
+        } else if (strcmp(argv[i], "--limiar-compactacao") == 0 && i + 1 < argc) {
+            int valor = atoi(argv[++i]);
+            if (valor >= 0 && valor <= 100) configuracao.limiarCompactacao = valor;
+        } else if (strcmp(argv[i], "--sempre-ordenado") == 0) {
+            modoPedido = 1;
+        } else if (strcmp(argv[i], "--ordenacao-indireta") == 0) {
+            ordenacaoIndireta = 1;
+        } else if (strcmp(argv[i], "--pagina") == 0 && i + 1 < argc) {
+            int valor = atoi(argv[++i]);
+            if (valor >= 0) linhasPorPagina = valor;
+        } else if (strcmp(argv[i], "--silencioso") == 0) {
+            listagemAutomatica = 0;
+        } else if (strcmp(argv[i], "--metricas") == 0 && i + 1 < argc) {
+            caminhoMetricas = argv[++i];
+        } else if (strcmp(argv[i], "--sem-metricas") == 0) {
+            caminhoMetricas = NULL;
+        } else if (strcmp(argv[i], "--diario") == 0 && i + 1 < argc) {
+            caminhoDiario = argv[++i];
+        } else if (strcmp(argv[i], "--sem-diario") == 0) {
+            caminhoDiario = NULL;
+        } else if (strcmp(argv[i], "--grupo-diario") == 0 && i + 1 < argc) {
+            int valor = atoi(argv[++i]);
+            if (valor > 0) registrosPorGrupo = valor;
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            int valor = atoi(argv[++i]);
+            if (valor >= 0) limiteCheckpoint = valor;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            int valor = atoi(argv[++i]);
+            if (valor > 0) threadsOrdenacao = valor;
+        } else if (strncmp(argv[i], "--algoritmo-", 12) == 0 && i + 1 < argc) {
+            CriterioOrdenacao criterio;
+            AlgoritmoOrdenacao algoritmo;
+            if (criterioPorNome(argv[i] + 12, &criterio) && algoritmoPorNome(argv[i + 1], &algoritmo) &&
+                algoritmoSuportaCriterio(algoritmo, criterio)) {
+                algoritmos[criterio] = algoritmo;
+                algoritmoEscolhido[criterio] = 1;
+            } else {
+                printf("AVISO: Combinacao invalida \"%s %s\" ignorada.\n", argv[i], argv[i + 1]);
+            }
+            i++;
+        }
+    }
+
+    if (threadsOrdenacao <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        threadsOrdenacao = nucleos > 0 ? (int)nucleos : 1;
+    }
+
+    if (!inventarioCriar(&mochila, &configuracao)) {
+        printf("ERRO: Memoria insuficiente para reservar a mochila.\n");
+        return 1;
+    }
+    for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+        if (algoritmoEscolhido[c]) mochila.algoritmoPorCriterio[c] = algoritmos[c];
+    }
+    mochila.ordenacaoIndireta = ordenacaoIndireta;
+    bufferSaidaInicializar(&bufferListagem);
+    metricasInicializar(&metricas, NOMES_OPERACOES, TOTAL_OPERACOES, NOMES_CONTADORES, TOTAL_CONTADORES);
+
+    double tempoCargaMs = 0.0;
+    int resultadoCarga = carregarSnapshotMochila(&tempoCargaMs);
+    if (resultadoCarga == SNAPSHOT_INVALIDO) {
+        printf("AVISO: Snapshot \"%s\" invalido ou de outra versao. Iniciando com a mochila vazia.\n", caminhoSnapshot);
+    }
+    // O diário reaplica as operações com o modo que estava valendo quando foram feitas;
+    // o modo pedido na linha de comando só entra depois (e fica registrado no diário)
+    int componentesSnapshot = mochila.totalComponentes;
+    ReaplicacaoDiario reaplicacao;
+    double tempoReaplicacaoMs = 0.0;
+    if (!abrirDiarioMochila(&reaplicacao, &tempoReaplicacaoMs)) {
+        printf("AVISO: Nao foi possivel abrir o diario \"%s\". As operacoes desta sessao so serao salvas ao sair.\n",
+               caminhoDiario);
+    } else if (reaplicacao.geracaoDescartada) {
+        printf("AVISO: Diario \"%s\" nao corresponde ao snapshot carregado e foi descartado.\n", caminhoDiario);
+    }
+    if (diarioAtivo && reaplicacao.bytesDescartados > 0) {
+        printf("AVISO: %lld byte(s) incompletos no fim do diario \"%s\" foram descartados.\n",
+               reaplicacao.bytesDescartados, caminhoDiario);
+    }
+    // O modo pedido na linha de comando ordena uma única vez o que veio do snapshot
+    if (mochila.modoSempreOrdenado != modoPedido && !definirModoSempreOrdenado(modoPedido)) {
+        printf("ERRO: Memoria insuficiente para ordenar a mochila.\n");
+        liberarMochila();
+        return 1;
+    }
+
+    if (arquivoLote != NULL) {
+        FILE *entrada = strcmp(arquivoLote, "-") == 0 ? stdin : fopen(arquivoLote, "r");
+        if (entrada == NULL) {
+            printf("ERRO: Nao foi possivel abrir o arquivo de lote \"%s\".\n", arquivoLote);
+            liberarMochila();
+            return 1;
+        }
+        int erros = executarModoLote(entrada);
+        if (entrada != stdin) fclose(entrada);
+        if (diarioAtivo) diarioConfirmar(&diario);
+        if (!salvarSnapshotMochila()) {
+            printf("ERRO: Nao foi possivel salvar o snapshot \"%s\".\n", caminhoSnapshot);
+            erros++;
+        }
+        if (!metricasSalvar(&metricas, caminhoMetricas)) {
+            printf("ERRO: Nao foi possivel gravar as metricas em \"%s\".\n", caminhoMetricas);
+            erros++;
+        }
+        liberarMochila();
+        return erros > 0 ? 2 : 0;
+    }
 
     printf("--- INICIANDO PLANO DE FUGA - CODIGO DA ILHA (NIVEL MESTRE) ---\n");
+    if (resultadoCarga == SNAPSHOT_OK) {
+        printf("Snapshot \"%s\" carregado: %d componentes em %.3f ms.\n", caminhoSnapshot, componentesSnapshot, tempoCargaMs);
+    }
+    if (diarioAtivo && reaplicacao.reaplicados > 0) {
+        printf("Diario \"%s\": %lld operacao(oes) reaplicadas em %.3f ms (mochila com %d componentes).\n",
+               caminhoDiario, reaplicacao.reaplicados, tempoReaplicacaoMs, mochila.totalComponentes);
+    }
     
     do {
         printf("\n======================================================\n");
         printf("PLANO DE FUGA - CODIGO DA ILHA (NIVEL MESTRE)\n");
         printf("======================================================\n");
-        printf("Itens na Mochila: %d/%d\n", totalComponentes, CAPACIDADE_MAXIMA);
-        printf("Status da Ordenacao por Nome: %s\n", statusOrdenacao ? "ORDENADO" : "NAO ORDENADO");
+        printf("Itens na Mochila: %d (capacidade alocada: %d, lapides: %d)\n", mochila.totalComponentes, mochila.capacidade,
+               mochila.slotsUsados - mochila.totalComponentes);
+        printf("Status da Ordenacao por Nome: %s\n",
+               mochila.modoSempreOrdenado ? "SEMPRE ORDENADO" : (mochila.statusOrdenacao ? "ORDENADO" : "NAO ORDENADO"));
         printf("------------------------------------------------------\n");
         printf("1. Adicionar Componente\n");
         printf("2. Descartar Componente\n");
         printf("3. Listar Componentes (Inventario)\n");
         printf("4. Organizar Mochila (Ordenar Componentes)\n");
-        printf("5. Busca Binaria por Componente-Chave (por nome)\n");
+        printf("5. Buscar Componente por Nome (indice hash)\n");
+        printf("6. Busca Binaria por Componente-Chave (por nome)\n");
+        printf("7. Compactar Mochila (remover lapides)\n");
+        printf("8. %s Modo Sempre Ordenado por Nome\n", mochila.modoSempreOrdenado ? "Desativar" : "Ativar");
+        printf("9. Consultar por Prioridade (indice por baldes)\n");
+        printf("10. Ver Mochila Ordenada (visao somente leitura)\n");
+        printf("11. Consultar por Tipo (indice secundario)\n");
+        printf("12. Estatisticas de Desempenho (latencia por operacao)\n");
+        printf("13. Proximos Componentes para Montar (fila por prioridade)\n");
+        printf("14. Alterar Prioridade de um Componente\n");
+        printf("15. Buscar por Prefixo ou Faixa de Nomes\n");
+        printf("16. Importar/Exportar CSV\n");
         printf("0. ATIVAR TORRE DE FUGA (Sair)\n");
         printf("------------------------------------------------------\n");
         printf("Escolha uma opcao: ");
@@ -120,27 +519,304 @@ int main() {
                 descartarComponente();
                 break;
             case 3:
-                listarComponentes();
-                pausarSistema();
+                navegarListagem();
                 break;
             case 4:
                 menuOrganizarMochila();
                 break;
             case 5:
+                buscarComponentePorNome();
+                pausarSistema();
+                break;
+            case 6:
                 buscaBinariaPorNome();
                 pausarSistema();
                 break;
+            case 7:
+                executarCompactacao();
+                break;
+            case 8:
+                alternarModoSempreOrdenado();
+                break;
+            case 9:
+                consultarPorPrioridade();
+                pausarSistema();
+                break;
+            case 10:
+                exibirVisaoOrdenada();
+                pausarSistema();
+                break;
+            case 11:
+                consultarPorTipo();
+                pausarSistema();
+                break;
+            case 12:
+                exibirMetricas();
+                pausarSistema();
+                break;
+            case 13:
+                exibirFilaMontagem();
+                pausarSistema();
+                break;
+            case 14:
+                alterarPrioridadeComponente();
+                break;
+            case 15:
+                buscarIntervaloNomes();
+                pausarSistema();
+                break;
+            case 16:
+                menuArquivosCsv();
+                pausarSistema();
+                break;
             case 0:
+                if (salvarSnapshotMochila()) {
+                    if (caminhoSnapshot != NULL) printf("\nMochila salva em \"%s\".\n", caminhoSnapshot);
+                } else {
+                    printf("\nERRO: Nao foi possivel salvar o snapshot \"%s\".\n", caminhoSnapshot);
+                }
+                if (metricasSalvar(&metricas, caminhoMetricas)) {
+                    if (caminhoMetricas != NULL) printf("Metricas gravadas em \"%s\".\n", caminhoMetricas);
+                } else {
+                    printf("ERRO: Nao foi possivel gravar as metricas em \"%s\".\n", caminhoMetricas);
+                }
                 printf("\n--- ATIVANDO TORRE DE FUGA! O jogo termina aqui. ---\n");
                 break;
             default:
                 printf("Opcao invalida! Tente novamente.\n");
         }
+        // No menu cada operação é confirmada logo (o ritmo humano não forma grupos)
+        if (opcao != 0 && diarioAtivo) {
+            if (!diarioConfirmar(&diario)) {
+                printf("AVISO: Falha ao gravar o diario \"%s\". Ele foi desativado.\n", caminhoDiario);
+                diarioFechar(&diario);
+                diarioAtivo = 0;
+            }
+            checkpointSeNecessario();
+        }
     } while (opcao != 0);
 
+    liberarMochila();
     return 0;
 }
 
+// ---------------------------------------------
+// OPERAÇÕES DA MOCHILA (NÚCLEO SEM INTERAÇÃO)
+// ---------------------------------------------
+// O trabalho é feito pela biblioteca de inventário; aqui cada operação é medida e,
+// se alterou a mochila, registrada no diário.
+
+/**
+ * @brief Insere um componente na mochila (no modo sempre ordenado, na posição ordenada por nome).
+ * @return O slot ocupado (>= 0) ou um código de erro (< 0).
+ */
+int inserirComponente(const char *nome, const char *tipo, int prioridade) {
+    uint64_t inicio = metricasAgoraNs();
+    int slot = inventarioAdicionar(&mochila, nome, tipo, prioridade, NULL);
+    if (slot < 0) return slot;
+    registrarOperacao(OPERACAO_ADICIONAR, inicio);
+    registrarNoDiario(REGISTRO_ADICIONAR, prioridade, 0, 0, nome, tipo);
+    return slot;
+}
+
+/**
+ * @brief Remove o componente com o nome informado (o de menor slot, se houver repetidos).
+ * O slot vira uma lápide em O(1); a compactação roda quando as lápides passam do limiar.
+ * @return O slot que o componente ocupava (>= 0), ERRO_NAO_ENCONTRADO ou ERRO_MEMORIA.
+ */
+int removerComponente(const char *nome) {
+    uint64_t inicio = metricasAgoraNs();
+    int slot = inventarioRemover(&mochila, nome);
+    if (slot == ERRO_MEMORIA) return slot;
+    registrarOperacao(OPERACAO_DESCARTAR, inicio);
+    if (slot >= 0) registrarNoDiario(REGISTRO_DESCARTAR, 0, 0, 0, nome, "");
+    return slot;
+}
+
+/**
+ * @brief Muda a prioridade do componente com o nome informado, sem mudá-lo de slot.
+ * @return O slot do componente (>= 0), ERRO_PRIORIDADE, ERRO_NAO_ENCONTRADO ou ERRO_MEMORIA.
+ */
+int alterarPrioridade(const char *nome, int novaPrioridade) {
+    uint64_t inicio = metricasAgoraNs();
+    int slot = inventarioAlterarValor(&mochila, nome, novaPrioridade);
+    if (slot < 0) return slot;
+    registrarOperacao(OPERACAO_ALTERAR_PRIORIDADE, inicio);
+    registrarNoDiario(REGISTRO_ALTERAR_PRIORIDADE, novaPrioridade, 0, 0, nome, "");
+    return slot;
+}
+
+/**
+ * @brief Tira da mochila o componente do topo da fila de montagem (o mais importante).
+ * @param montado Recebe uma cópia do componente.
+ * @param nomeMontado Recebe o nome (NOME_MAX bytes).
+ * @return O slot que ele ocupava, ERRO_NAO_ENCONTRADO (mochila vazia) ou ERRO_MEMORIA.
+ */
+int montarProximoComponente(Componente *montado, char *nomeMontado) {
+    uint64_t inicio = metricasAgoraNs();
+    int slot = inventarioMontarProximo(&mochila, montado, nomeMontado);
+    if (slot < 0) return slot;
+    registrarOperacao(OPERACAO_MONTAR, inicio);
+    registrarNoDiario(REGISTRO_MONTAR, 0, 0, 0, "", "");
+    return slot;
+}
+
+/**
+ * @brief Ordena a mochila pelo motor de ordenação (direta ou indireta, conforme a opção).
+ * No modo sempre ordenado, ordenar por nome não faz nada e os outros critérios são recusados.
+ * @return 1 em caso de sucesso, 0 se faltar memória ou a combinação for inválida.
+ */
+int ordenarMochila(CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo, EstatisticasOrdenacao *estatisticas) {
+    if (mochila.modoSempreOrdenado) return inventarioOrdenar(&mochila, criterio, algoritmo, estatisticas);
+
+    uint64_t inicio = metricasAgoraNs();
+    if (!inventarioOrdenar(&mochila, criterio, algoritmo, estatisticas)) return 0;
+    somarEstatisticasOrdenacao(estatisticas);
+    registrarOperacao(OPERACAO_ORDENAR, inicio);
+    registrarNoDiario(REGISTRO_ORDENAR, criterio, algoritmo, mochila.ordenacaoIndireta, "", "");
+    return 1;
+}
+
+/**
+ * @brief Pool de threads da ordenação paralela, criado no primeiro uso.
+ * @return O pool, ou NULL se não for possível criar as threads.
+ */
+PoolThreads *obterPoolOrdenacao() {
+    if (!poolOrdenacaoCriado) {
+        if (!poolCriar(&poolOrdenacao, threadsOrdenacao)) return NULL;
+        poolOrdenacaoCriado = 1;
+    }
+    return &poolOrdenacao;
+}
+
+/**
+ * @brief Ordena a mochila com as threads do pool, com as mesmas regras de ordenarMochila.
+ * O resultado é idêntico ao da ordenação serial estável (Merge Sort / Counting Sort).
+ * @param porThread Vetor com threadsOrdenacao posições (pode ser NULL).
+ * @return 1 em caso de sucesso, 0 se faltar memória ou não for possível criar as threads.
+ */
+int ordenarMochilaParalelo(CriterioOrdenacao criterio, EstatisticasOrdenacao *estatisticas, EstatisticasThread *porThread) {
+    if (mochila.modoSempreOrdenado) return inventarioOrdenarParalelo(&mochila, NULL, criterio, estatisticas, porThread);
+
+    PoolThreads *pool = obterPoolOrdenacao();
+    if (pool == NULL) return 0;
+    uint64_t inicio = metricasAgoraNs();
+    if (!inventarioOrdenarParalelo(&mochila, pool, criterio, estatisticas, porThread)) return 0;
+    somarEstatisticasOrdenacao(estatisticas);
+    registrarOperacao(OPERACAO_ORDENAR_PARALELO, inicio);
+    // Na reaplicação basta a versão serial estável, que produz a mesma ordem
+    registrarNoDiario(REGISTRO_ORDENAR, criterio, criterio == CRITERIO_NOME ? ALGORITMO_MERGESORT : ALGORITMO_CONTAGEM,
+                      0, "", "");
+    return 1;
+}
+
+/**
+ * @brief Ordena a mochila por vários critérios de uma vez (ex.: tipo, prioridade
+ * decrescente, nome) com uma única ordenação da chave composta.
+ * No modo sempre ordenado, só é aceita uma ordem que comece por nome crescente.
+ * @return 1 em caso de sucesso, 0 se faltar memória ou a combinação for inválida.
+ */
+int ordenarMochilaComposta(const OrdemComposta *ordem, AlgoritmoOrdenacao algoritmo, EstatisticasOrdenacao *estatisticas) {
+    uint64_t inicio = metricasAgoraNs();
+    if (!inventarioOrdenarComposto(&mochila, ordem, algoritmo, estatisticas)) return 0;
+    somarEstatisticasOrdenacao(estatisticas);
+    registrarOperacao(OPERACAO_ORDENAR, inicio);
+    char texto[ORDEM_COMPOSTA_TEXTO_MAX];
+    ordemCompostaTexto(ordem, texto, sizeof(texto));
+    registrarNoDiario(REGISTRO_ORDENAR_COMPOSTO, algoritmo, 0, 0, texto, "");
+    return 1;
+}
+
+/**
+ * @brief Devolve a visão ordenada do critério (montada de novo só se a mochila mudou).
+ * @param estatisticas Recebe o custo da montagem (zerado se a visão veio do cache).
+ * @return A visão, ou NULL se faltar memória.
+ */
+const VisaoOrdenada *obterVisao(CriterioOrdenacao criterio, EstatisticasOrdenacao *estatisticas) {
+    uint64_t inicio = metricasAgoraNs();
+    const VisaoOrdenada *visao = inventarioVisao(&mochila, criterio, estatisticas);
+    if (visao == NULL) return NULL;
+    somarEstatisticasOrdenacao(estatisticas);
+    registrarOperacao(OPERACAO_VISAO, inicio);
+    return visao;
+}
+
+/**
+ * @brief Deixa pronta a ordem por nome das buscas por prefixo e por faixa: a própria
+ * mochila, se estiver ordenada por nome, ou a visão por nome (montada aqui para que o
+ * custo dela apareça nas métricas).
+ * @return 1 em caso de sucesso, 0 se faltar memória para montar a visão.
+ */
+int prepararOrdemPorNome() {
+    if (mochila.statusOrdenacao) return 1;
+    EstatisticasOrdenacao estatisticas;
+    return obterVisao(CRITERIO_NOME, &estatisticas) != NULL;
+}
+
+/**
+ * @brief Liga ou desliga o modo sempre ordenado por nome.
+ * Ao ligar, a mochila é ordenada uma única vez (se ainda não estiver).
+ * @return 1 em caso de sucesso, 0 se faltar memória para a ordenação inicial.
+ */
+int definirModoSempreOrdenado(int ativo) {
+    if (ativo && !mochila.statusOrdenacao) {
+        // A ordenação inicial passa por ordenarMochila para entrar no diário com o algoritmo usado
+        EstatisticasOrdenacao estatisticas;
+        inventarioDefinirModoSempreOrdenado(&mochila, 0);
+        if (!ordenarMochila(CRITERIO_NOME, mochila.algoritmoPorCriterio[CRITERIO_NOME], &estatisticas)) return 0;
+    }
+    if (!inventarioDefinirModoSempreOrdenado(&mochila, ativo)) return 0;
+    registrarNoDiario(REGISTRO_MODO, ativo, 0, 0, "", "");
+    return 1;
+}
+
+/**
+ * @brief Acrescenta à mochila um registro já validado pela importação CSV.
+ */
+static int aceitarComponenteCsv(void *contexto, const RegistroCsv *registro) {
+    (void)contexto;
+    return inserirComponente(registro->nome, registro->tipo, registro->valor) >= 0;
+}
+
+/**
+ * @brief Importa componentes de um CSV "nome,tipo,prioridade" direto para a mochila.
+ * A análise e a validação (tamanhos e prioridade 1..10) rodam no pool da ordenação
+ * paralela; cada linha aceita passa por inserirComponente, como um "add" do modo lote
+ * (índices, modo sempre ordenado e diário continuam valendo).
+ * @return CSV_OK, CSV_ERRO_ARQUIVO ou CSV_ERRO_MEMORIA.
+ */
+int importarComponentesCsv(const char *caminho, ResumoImportacaoCsv *resumo) {
+    RegrasCsv regras = { NOME_MAX, TIPO_MAX, PRIORIDADE_MIN, PRIORIDADE_MAX };
+    uint64_t inicio = metricasAgoraNs();
+    int resultado = csvImportar(caminho, obterPoolOrdenacao(), &regras, aceitarComponenteCsv, NULL, resumo);
+    registrarOperacao(OPERACAO_IMPORTAR_CSV, inicio);
+    return resultado;
+}
+
+/**
+ * @brief Exporta os componentes vivos, na ordem atual da mochila, para um CSV
+ * que importarComponentesCsv lê de volta.
+ * @return CSV_OK ou CSV_ERRO_ARQUIVO.
+ */
+int exportarComponentesCsv(const char *caminho, int *exportados) {
+    uint64_t inicio = metricasAgoraNs();
+    *exportados = 0;
+    FILE *saida = fopen(caminho, "w");
+    if (saida == NULL) return CSV_ERRO_ARQUIVO;
+    setvbuf(saida, NULL, _IOFBF, 1 << 16);
+
+    int sucesso = csvEscreverCabecalho(saida, "prioridade");
+    for (int slot = 0; slot < mochila.slotsUsados && sucesso; slot++) {
+        if (!inventarioSlotVivo(&mochila, slot)) continue;
+        sucesso = csvEscreverRegistro(saida, inventarioNome(&mochila, slot), inventarioTipo(&mochila, slot),
+                                      inventarioValor(&mochila, slot));
+        if (sucesso) (*exportados)++;
+    }
+    if (fclose(saida) != 0) sucesso = 0;
+    registrarOperacao(OPERACAO_EXPORTAR_CSV, inicio);
+    return sucesso ? CSV_OK : CSV_ERRO_ARQUIVO;
+}
+
 // ---------------------------------------------
 // FUNÇÕES DE GERENCIAMENTO (CRUD)
 // ---------------------------------------------
@@ -149,39 +825,52 @@ int main() {
  * @brief Cadastra um novo componente na mochila.
  */
 void adicionarComponente() {
-    if (totalComponentes >= CAPACIDADE_MAXIMA) {
-        printf("\nERRO: Mochila cheia! (%d/%d) Nao e possivel adicionar mais componentes.\n", totalComponentes, CAPACIDADE_MAXIMA);
-        return;
-    }
-
-    Componente *novoComp = &mochila[totalComponentes];
+    char nome[NOME_MAX];
+    char tipo[TIPO_MAX];
+    int prioridade;
 
     printf("\n--- ADICIONAR NOVO COMPONENTE ---\n");
 
     // Lendo o Nome
     printf("Nome do Componente (max %d): ", NOME_MAX - 1);
-    if (fgets(novoComp->nome, NOME_MAX, stdin) == NULL) return;
-    novoComp->nome[strcspn(novoComp->nome, "\n")] = 0; 
+    int leitura = lerLinha(nome, NOME_MAX);
+    if (leitura == 0) return;
+    if (leitura < 0) {
+        printf("ERRO: Nome maior que %d caracteres. Cancelando insercao.\n", NOME_MAX - 1);
+        return;
+    }
 
     // Lendo o Tipo
     printf("Tipo do Componente (ex: controle, suporte - max %d): ", TIPO_MAX - 1);
-    if (fgets(novoComp->tipo, TIPO_MAX, stdin) == NULL) return;
-    novoComp->tipo[strcspn(novoComp->tipo, "\n")] = 0;
+    if (fgets(tipo, TIPO_MAX, stdin) == NULL) return;
+    tipo[strcspn(tipo, "\n")] = 0;
 
     // Lendo a Prioridade
     printf("Prioridade (1 a 10): ");
     // Correção: Garantir que o buffer seja limpo em caso de falha no scanf
-    if (scanf("%d", &novoComp->prioridade) != 1 || novoComp->prioridade < 1 || novoComp->prioridade > 10) {
+    if (scanf("%d", &prioridade) != 1 || prioridade < 1 || prioridade > 10) {
         printf("ERRO: Prioridade invalida (deve ser entre 1 e 10). Cancelando insercao.\n");
         limparBuffer();
         return; 
     }
     limparBuffer(); 
 
-    statusOrdenacao = 0;
-    totalComponentes++;
-    printf("\nSUCESSO: Componente \"%s\" adicionado a mochila!\n", novoComp->nome);
-    listarComponentes();
+    int resultado = inserirComponente(nome, tipo, prioridade);
+    if (resultado == ERRO_NOME_INVALIDO) {
+        printf("ERRO: Nome vazio ou nome/tipo muito longo. Cancelando insercao.\n");
+        return;
+    }
+    if (resultado == ERRO_TIPOS_ESGOTADOS) {
+        printf("ERRO: Limite de %d tipos distintos atingido. Cancelando insercao.\n", TIPOS_DISTINTOS_MAX);
+        return;
+    }
+    if (resultado < 0) {
+        printf("ERRO: Memoria insuficiente para indexar o componente. Cancelando insercao.\n");
+        return;
+    }
+
+    printf("\nSUCESSO: Componente \"%s\" adicionado a mochila!\n", nome);
+    if (listagemAutomatica) listarComponentes();
     pausarSistema();
 }
 
@@ -189,41 +878,59 @@ void adicionarComponente() {
  * @brief Remove um componente da mochila pelo nome.
  */
 void descartarComponente() {
-    if (totalComponentes == 0) {
+    if (mochila.totalComponentes == 0) {
         printf("\nERRO: A mochila esta vazia. Nao ha o que descartar.\n");
         return;
     }
 
     char nomeBusca[NOME_MAX];
-    int posEncontrada = -1; 
+    int posEncontrada; 
 
     printf("\n--- DESCARTAR COMPONENTE ---\n");
     printf("Digite o nome exato do componente para descartar: ");
     
-    if (fgets(nomeBusca, NOME_MAX, stdin) == NULL) return;
-    nomeBusca[strcspn(nomeBusca, "\n")] = 0;
+    if (lerLinha(nomeBusca, NOME_MAX) == 0) return;
 
-    for (int i = 0; i < totalComponentes; i++) {
-        if (strcmp(mochila[i].nome, nomeBusca) == 0) {
-            posEncontrada = i;
-            break; 
-        }
+    posEncontrada = removerComponente(nomeBusca);
+
+    if (posEncontrada >= 0) {
+        printf("\nSUCESSO: Componente \"%s\" descartado.\n", nomeBusca);
+        if (listagemAutomatica) listarComponentes();
+        pausarSistema();
+    } else {
+        printf("\nERRO: Componente \"%s\" nao encontrado na mochila.\n", nomeBusca);
+    }
+}
+
+/**
+ * @brief Muda a prioridade de um componente pelo nome (a fila de montagem se ajusta em O(log n)).
+ */
+void alterarPrioridadeComponente() {
+    if (mochila.totalComponentes == 0) {
+        printf("\nERRO: A mochila esta vazia. Nada para alterar.\n");
+        return;
     }
 
-    if (posEncontrada != -1) {
-        printf("\nSUCESSO: Componente \"%s\" descartado.\n", mochila[posEncontrada].nome);
+    char nomeBusca[NOME_MAX];
+    int novaPrioridade;
 
-        // Deslocamento dos elementos
-        for (int i = posEncontrada; i < totalComponentes - 1; i++) {
-            mochila[i] = mochila[i+1]; 
-        }
+    printf("\n--- ALTERAR PRIORIDADE ---\n");
+    printf("Nome do componente: ");
+    if (lerLinha(nomeBusca, NOME_MAX) == 0) return;
 
-        totalComponentes--;
-        statusOrdenacao = 0; 
-        listarComponentes();
-        pausarSistema();
-    } else {
+    printf("Nova prioridade (1 a 10): ");
+    if (scanf("%d", &novaPrioridade) != 1) novaPrioridade = 0;
+    limparBuffer();
+
+    int resultado = alterarPrioridade(nomeBusca, novaPrioridade);
+    if (resultado == ERRO_PRIORIDADE) {
+        printf("ERRO: Prioridade invalida (deve ser entre 1 e 10).\n");
+    } else if (resultado == ERRO_NAO_ENCONTRADO) {
         printf("\nERRO: Componente \"%s\" nao encontrado na mochila.\n", nomeBusca);
+    } else if (resultado < 0) {
+        printf("\nERRO: Memoria insuficiente para reconstruir o indice de nomes.\n");
+    } else {
+        printf("\nSUCESSO: \"%s\" agora tem prioridade %d.\n", nomeBusca, novaPrioridade);
     }
 }
 
@@ -231,27 +938,88 @@ void descartarComponente() {
  * @brief Lista todos os componentes na mochila.
  */
 void listarComponentes() {
-    if (totalComponentes == 0) {
+    listarPaginaComponentes(0);
+}
+
+/**
+ * @brief Acrescenta ao buffer de listagem as linhas dos componentes vivos a partir de um slot.
+ * @param maximoLinhas Limite de linhas (0 = até o fim da mochila).
+ * @param formatoLote 1 = "nome tipo prioridade" (modo lote), 0 = linha da tabela.
+ * @param linhasMontadas Recebe a quantidade de linhas acrescentadas.
+ * @return Slot em que a próxima página começa (mochila.slotsUsados quando não há mais linhas).
+ */
+int montarLinhasComponentes(int slotInicial, int maximoLinhas, int formatoLote, int *linhasMontadas) {
+    int linhas = 0;
+    int slot = slotInicial;
+
+    for (; slot < mochila.slotsUsados && (maximoLinhas <= 0 || linhas < maximoLinhas); slot++) {
+        const Componente *c = &mochila.componentes[slot];
+        if (COMPONENTE_REMOVIDO(c)) continue;
+        if (formatoLote) {
+            bufferSaidaFormatar(&bufferListagem, "%s %s %d\n", nomeDoComponente(c), tipoDoComponente(c), c->prioridade);
+        } else {
+            // Correção: Alinhamento da coluna QTD para 3 caracteres
+            bufferSaidaFormatar(&bufferListagem, "| %-*s | %-*s | %-10d | %-3d |\n",
+                                LARGURA_NOME_TABELA, nomeDoComponente(c), TIPO_MAX - 1, tipoDoComponente(c), c->prioridade, 1);
+        }
+        linhas++;
+    }
+    // Pula as lápides seguintes para o cursor indicar se ainda há linhas
+    while (slot < mochila.slotsUsados && COMPONENTE_REMOVIDO(&mochila.componentes[slot])) slot++;
+
+    *linhasMontadas = linhas;
+    return slot;
+}
+
+/**
+ * @brief Exibe uma página da tabela (ou a tabela inteira, sem paginação) com uma única escrita.
+ * @param slotInicial 0 para a primeira página, ou cursorListagem para continuar.
+ * @return 1 se ainda houver páginas depois desta.
+ */
+int listarPaginaComponentes(int slotInicial) {
+    if (mochila.totalComponentes == 0) {
         printf("\n--- INVENTARIO VAZIO ---\n");
-        return;
+        return 0;
     }
+    if (slotInicial == 0) linhasJaListadas = 0;
+    uint64_t inicio = metricasAgoraNs();
 
-    printf("\n----------------------------------------------------------------\n");
+    bufferSaidaFormatar(&bufferListagem, "\n----------------------------------------------------------------\n");
     // Correção: Uso correto do especificador de largura para "QTD"
-    printf("| %-*s | %-*s | %-*s | %s |\n", NOME_MAX - 1, "NOME", TIPO_MAX - 1, "TIPO", 10, "PRIORIDADE", "QTD");
-    printf("----------------------------------------------------------------\n");
+    bufferSaidaFormatar(&bufferListagem, "| %-*s | %-*s | %-*s | %s |\n",
+                        LARGURA_NOME_TABELA, "NOME", TIPO_MAX - 1, "TIPO", 10, "PRIORIDADE", "QTD");
+    bufferSaidaFormatar(&bufferListagem, "----------------------------------------------------------------\n");
+
+    int linhas;
+    cursorListagem = montarLinhasComponentes(slotInicial, linhasPorPagina, 0, &linhas);
+    int haMais = cursorListagem < mochila.slotsUsados;
+
+    bufferSaidaFormatar(&bufferListagem, "----------------------------------------------------------------\n");
+    if (linhasPorPagina > 0) {
+        bufferSaidaFormatar(&bufferListagem, "Exibindo %d-%d de %d componentes%s.\n", linhasJaListadas + 1,
+                            linhasJaListadas + linhas, mochila.totalComponentes, haMais ? " (ha mais paginas)" : "");
+    } else {
+        bufferSaidaFormatar(&bufferListagem, "Total de %d componentes diferentes na mochila.\n", mochila.totalComponentes);
+    }
+    linhasJaListadas += linhas;
+    bufferSaidaDescarregar(&bufferListagem);
+    registrarOperacao(OPERACAO_LISTAR, inicio);
+    return haMais;
+}
 
-    for (int i = 0; i < totalComponentes; i++) {
-        // Correção: Alinhamento da coluna QTD para 3 caracteres
-        printf("| %-*s | %-*s | %-10d | %-3d |\n", 
-               NOME_MAX - 1, mochila[i].nome, 
-               TIPO_MAX - 1, mochila[i].tipo, 
-               mochila[i].prioridade, 
-               1
-        );
+/**
+ * @brief Lista a mochila página por página (opção 3 do menu).
+ */
+void navegarListagem() {
+    int haMais = listarPaginaComponentes(0);
+
+    while (haMais) {
+        char resposta[8];
+        printf("\nEnter = proxima pagina, 0 = voltar ao menu: ");
+        if (fgets(resposta, sizeof(resposta), stdin) == NULL || resposta[0] == '0') return;
+        haMais = listarPaginaComponentes(cursorListagem);
     }
-    printf("----------------------------------------------------------------\n");
-    printf("Total de %d componentes diferentes na mochila.\n", totalComponentes);
+    pausarSistema();
 }
 
 // ---------------------------------------------
@@ -259,16 +1027,17 @@ void listarComponentes() {
 // ---------------------------------------------
 
 /**
- * @brief Menu para escolher o método de ordenação.
+ * @brief Menu para escolher o critério e o algoritmo de ordenação.
  */
 void menuOrganizarMochila() {
     int opcao;
     
     printf("\n--- ORGANIZAR MOCHILA (ORDENAR COMPONENTES) ---\n");
     printf("Escolha o criterio de organizacao:\n");
-    printf("1. Bubble Sort por Nome (para Busca Binaria)\n");
-    printf("2. Insertion Sort por Tipo\n");
-    printf("3. Selection Sort por Prioridade\n");
+    printf("1. Por Nome (para Busca Binaria) [padrao: %s]\n", nomeAlgoritmo(mochila.algoritmoPorCriterio[CRITERIO_NOME]));
+    printf("2. Por Tipo [padrao: %s]\n", nomeAlgoritmo(mochila.algoritmoPorCriterio[CRITERIO_TIPO]));
+    printf("3. Por Prioridade [padrao: %s]\n", nomeAlgoritmo(mochila.algoritmoPorCriterio[CRITERIO_PRIORIDADE]));
+    printf("4. Por Varios Criterios (ex: tipo, prioridade decrescente, nome)\n");
     printf("0. Cancelar\n");
     printf("Opcao: ");
 
@@ -279,148 +1048,236 @@ void menuOrganizarMochila() {
     }
     limparBuffer();
 
+    if (opcao == 0) {
+        printf("Organizacao cancelada.\n");
+        return;
+    }
+    if (opcao < 1 || opcao > TOTAL_CRITERIOS + 1) {
+        printf("Opcao invalida.\n");
+        return;
+    }
+
     // Verificação para evitar que o algoritmo rode em um vetor vazio
-    if (totalComponentes < 1 && opcao != 0) {
+    if (mochila.totalComponentes < 1) {
         printf("\nERRO: E necessario ter pelo menos 1 componente para ordenar.\n");
         return;
     }
-
-    switch (opcao) {
-        case 1:
-            bubbleSortNome();
-            break;
-        case 2:
-            insertionSortTipo();
-            break;
-        case 3:
-            selectionSortPrioridade();
-            break;
-        case 0:
-            printf("Organizacao cancelada.\n");
-            break;
-        default:
-            printf("Opcao invalida.\n");
+    if (opcao == TOTAL_CRITERIOS + 1) {
+        menuOrdenacaoComposta();
+        return;
     }
-}
-
-/**
- * @brief Implementa o Bubble Sort para ordenar por Nome (string).
- */
-void bubbleSortNome() {
-    if (totalComponentes <= 1) return;
 
-    int comparacoes = 0;
-    clock_t inicio = clock(); 
+    CriterioOrdenacao criterio = (CriterioOrdenacao)(opcao - 1);
 
-    for (int i = 0; i < totalComponentes - 1; i++) {
-        for (int j = 0; j < totalComponentes - 1 - i; j++) {
-            comparacoes++; 
-            if (strcmp(mochila[j].nome, mochila[j+1].nome) > 0) {
-                trocar(&mochila[j], &mochila[j+1]);
-            }
+    printf("\nEscolha o algoritmo:\n");
+    printf("0. Padrao do criterio (%s)\n", nomeAlgoritmo(mochila.algoritmoPorCriterio[criterio]));
+    for (int a = 0; a < TOTAL_ALGORITMOS; a++) {
+        if (algoritmoSuportaCriterio((AlgoritmoOrdenacao)a, criterio)) {
+            printf("%d. %s\n", a + 1, nomeAlgoritmo((AlgoritmoOrdenacao)a));
         }
     }
+    printf("%d. Merge paralelo (%d threads)\n", TOTAL_ALGORITMOS + 1, threadsOrdenacao);
+    printf("Opcao: ");
+
+    if (scanf("%d", &opcao) != 1) {
+        limparBuffer();
+        printf("Opcao invalida.\n");
+        return;
+    }
+    limparBuffer();
 
-    clock_t fim = clock();
-    double tempo_execucao = (double)(fim - inicio) / CLOCKS_PER_SEC;
+    if (opcao == TOTAL_ALGORITMOS + 1) {
+        executarOrdenacaoParalela(criterio);
+        return;
+    }
 
-    statusOrdenacao = 1;
+    AlgoritmoOrdenacao algoritmo = mochila.algoritmoPorCriterio[criterio];
+    if (opcao != 0) {
+        algoritmo = (AlgoritmoOrdenacao)(opcao - 1);
+        if (!algoritmoSuportaCriterio(algoritmo, criterio)) {
+            printf("Opcao invalida.\n");
+            return;
+        }
+    }
 
-    printf("\n--- ORDENACAO CONCLUIDA (Bubble Sort por Nome) ---\n");
-    listarComponentes(); 
-    printf("\n--- DESEMPENHO EDUCAIONAL ---\n");
-    printf("Comparacoes realizadas: %d\n", comparacoes);
-    printf("Tempo de execucao: %.6f segundos\n", tempo_execucao);
-    pausarSistema();
+    executarOrdenacao(criterio, algoritmo);
 }
 
 /**
- * @brief Implementa o Insertion Sort para ordenar por Tipo (string).
+ * @brief Ordena a mochila pelo motor de ordenação e exibe o desempenho.
  */
-void insertionSortTipo() {
-    if (totalComponentes <= 1) return;
-
-    int comparacoes = 0;
-    clock_t inicio = clock(); 
+void executarOrdenacao(CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo) {
+    if (mochila.totalComponentes <= 1) return;
 
-    for (int i = 1; i < totalComponentes; i++) {
-        Componente chave = mochila[i];
-        int j = i - 1;
-
-        while (j >= 0) {
-            comparacoes++; 
-            if (strcmp(mochila[j].tipo, chave.tipo) > 0) {
-                mochila[j+1] = mochila[j];
-                j--;
-            } else {
-                break;
-            }
-        }
-        mochila[j+1] = chave;
+    if (mochila.modoSempreOrdenado && criterio != CRITERIO_NOME) {
+        printf("\nERRO: O modo sempre ordenado por nome esta ativo. Desative-o (Opcao 8) para ordenar por %s.\n",
+               nomeCriterio(criterio));
+        return;
     }
 
-    clock_t fim = clock();
-    double tempo_execucao = (double)(fim - inicio) / CLOCKS_PER_SEC;
-
-    statusOrdenacao = 0; 
+    EstatisticasOrdenacao estatisticas;
+    if (!ordenarMochila(criterio, algoritmo, &estatisticas)) {
+        printf("\nERRO: Nao foi possivel ordenar (memoria insuficiente ou algoritmo invalido).\n");
+        return;
+    }
 
-    printf("\n--- ORDENACAO CONCLUIDA (Insertion Sort por Tipo) ---\n");
+    printf("\n--- ORDENACAO CONCLUIDA (%s por %s) ---\n", nomeAlgoritmo(algoritmo), nomeCriterio(criterio));
     listarComponentes();
     printf("\n--- DESEMPENHO EDUCAIONAL ---\n");
-    printf("Comparacoes realizadas: %d\n", comparacoes);
-    printf("Tempo de execucao: %.6f segundos\n", tempo_execucao);
+    printf("Comparacoes realizadas: %lld\n", estatisticas.comparacoes);
+    if (criterio != CRITERIO_PRIORIDADE) {
+        printf("  Resolvidas pelo prefixo: %lld | Desempates por strcmp: %lld\n",
+               estatisticas.acertosPrefixo, estatisticas.desempatesTexto);
+    }
+    printf("Trocas/movimentacoes: %lld\n", estatisticas.trocas);
+    printf("Tempo de execucao: %.6f segundos\n", estatisticas.tempoSegundos);
     pausarSistema();
 }
 
 /**
- * @brief Implementa o Selection Sort para ordenar por Prioridade (int).
+ * @brief Lê a ordem composta ("tipo,-prioridade,nome") e o algoritmo, ordena e exibe o desempenho.
  */
-void selectionSortPrioridade() {
-    if (totalComponentes <= 1) return;
+void menuOrdenacaoComposta() {
+    char texto[LINHA_LOTE_MAX];
+    OrdemComposta ordem;
+    printf("\nCriterios em ordem, separados por virgula ('-' = decrescente).\n");
+    printf("Ex: tipo,-prioridade,nome (tipo A-Z, depois prioridade 10-1, depois nome A-Z)\n");
+    printf("Ordem: ");
+    if (fgets(texto, sizeof(texto), stdin) == NULL) return;
+    texto[strcspn(texto, "\n")] = 0;
+    if (!ordemCompostaPorTexto(texto, &ordem)) {
+        printf("Ordem invalida (use nome, tipo e prioridade, cada um no maximo uma vez).\n");
+        return;
+    }
+    if (mochila.modoSempreOrdenado &&
+        (ordem.campos[0].criterio != CRITERIO_NOME || ordem.campos[0].decrescente)) {
+        printf("\nERRO: O modo sempre ordenado por nome esta ativo. Desative-o (Opcao 8) ou comece a ordem por nome.\n");
+        return;
+    }
 
-    int comparacoes = 0;
-    clock_t inicio = clock(); 
+    int opcao;
+    printf("\nEscolha o algoritmo:\n");
+    printf("0. Padrao (%s, uma passada sobre a chave composta)\n", nomeAlgoritmo(ALGORITMO_RADIX));
+    for (int a = 0; a < TOTAL_ALGORITMOS; a++) {
+        if (algoritmoSuportaOrdemComposta((AlgoritmoOrdenacao)a)) printf("%d. %s\n", a + 1, nomeAlgoritmo((AlgoritmoOrdenacao)a));
+    }
+    printf("Opcao: ");
+    if (scanf("%d", &opcao) != 1) {
+        limparBuffer();
+        printf("Opcao invalida.\n");
+        return;
+    }
+    limparBuffer();
 
-    for (int i = 0; i < totalComponentes - 1; i++) {
-        int min_idx = i;
-        for (int j = i + 1; j < totalComponentes; j++) {
-            comparacoes++; 
-            if (mochila[j].prioridade < mochila[min_idx].prioridade) {
-                min_idx = j;
-            }
-        }
-        if (min_idx != i) {
-            trocar(&mochila[min_idx], &mochila[i]);
+    AlgoritmoOrdenacao algoritmo = ALGORITMO_RADIX;
+    if (opcao != 0) {
+        algoritmo = (AlgoritmoOrdenacao)(opcao - 1);
+        if (!algoritmoSuportaOrdemComposta(algoritmo)) {
+            printf("Opcao invalida.\n");
+            return;
         }
     }
 
-    clock_t fim = clock();
-    double tempo_execucao = (double)(fim - inicio) / CLOCKS_PER_SEC;
-
-    statusOrdenacao = 0; 
+    EstatisticasOrdenacao estatisticas;
+    if (!ordenarMochilaComposta(&ordem, algoritmo, &estatisticas)) {
+        printf("\nERRO: Nao foi possivel ordenar (memoria insuficiente).\n");
+        return;
+    }
 
-    printf("\n--- ORDENACAO CONCLUIDA (Selection Sort por Prioridade) ---\n");
+    ordemCompostaTexto(&ordem, texto, sizeof(texto));
+    printf("\n--- ORDENACAO CONCLUIDA (%s por %s) ---\n", nomeAlgoritmo(algoritmo), texto);
     listarComponentes();
     printf("\n--- DESEMPENHO EDUCAIONAL ---\n");
-    printf("Comparacoes realizadas: %d\n", comparacoes);
-    printf("Tempo de execucao: %.6f segundos\n", tempo_execucao);
+    printf("Comparacoes realizadas: %lld\n", estatisticas.comparacoes);
+    printf("Trocas/movimentacoes: %lld\n", estatisticas.trocas);
+    printf("Tempo de execucao: %.6f segundos\n", estatisticas.tempoSegundos);
     pausarSistema();
 }
 
-// ---------------------------------------------
-// FUNÇÃO DE BUSCA BINÁRIA
-// ---------------------------------------------
-
 /**
- * @brief Implementa a Busca Binária por Nome (string).
+ * @brief Ordena a mochila com as threads do pool e exibe o desempenho de cada thread.
  */
-void buscaBinariaPorNome() {
-    if (totalComponentes == 0) {
+void executarOrdenacaoParalela(CriterioOrdenacao criterio) {
+    if (mochila.totalComponentes <= 1) return;
+
+    if (mochila.modoSempreOrdenado && criterio != CRITERIO_NOME) {
+        printf("\nERRO: O modo sempre ordenado por nome esta ativo. Desative-o (Opcao 8) para ordenar por %s.\n",
+               nomeCriterio(criterio));
+        return;
+    }
+
+    EstatisticasOrdenacao estatisticas;
+    EstatisticasThread *porThread = calloc((size_t)threadsOrdenacao, sizeof(EstatisticasThread));
+    if (porThread == NULL || !ordenarMochilaParalelo(criterio, &estatisticas, porThread)) {
+        printf("\nERRO: Nao foi possivel ordenar (memoria insuficiente ou falha ao criar as threads).\n");
+        free(porThread);
+        return;
+    }
+
+    printf("\n--- ORDENACAO CONCLUIDA (Merge paralelo por %s, %d threads) ---\n", nomeCriterio(criterio), threadsOrdenacao);
+    listarComponentes();
+    printf("\n--- DESEMPENHO EDUCAIONAL ---\n");
+    printf("Comparacoes realizadas: %lld\n", estatisticas.comparacoes);
+    if (criterio != CRITERIO_PRIORIDADE) {
+        printf("  Resolvidas pelo prefixo: %lld | Desempates por strcmp: %lld\n",
+               estatisticas.acertosPrefixo, estatisticas.desempatesTexto);
+    }
+    printf("Trocas/movimentacoes: %lld\n", estatisticas.trocas);
+    printf("Tempo de execucao (parede): %.6f segundos\n", estatisticas.tempoSegundos);
+    printf("%-8s | %-8s | %-14s | %-14s | %s\n", "THREAD", "TAREFAS", "COMPARACOES", "MOVIMENTOS", "TEMPO (s)");
+    for (int t = 0; t < threadsOrdenacao; t++) {
+        printf("%-8d | %-8d | %-14lld | %-14lld | %.6f\n", t, porThread[t].tarefas, porThread[t].comparacoes,
+               porThread[t].trocas, porThread[t].tempoSegundos);
+    }
+    free(porThread);
+    pausarSistema();
+}
+
+// ---------------------------------------------
+// FUNÇÕES DE BUSCA
+// ---------------------------------------------
+
+/**
+ * @brief Busca exata por nome através do índice hash.
+ * Funciona em O(1) esperado e não depende da mochila estar ordenada.
+ */
+void buscarComponentePorNome() {
+    if (mochila.totalComponentes == 0) {
         printf("\nERRO: Mochila vazia. Nada para buscar.\n");
         return;
     }
 
-    if (statusOrdenacao == 0) {
+    char nomeBusca[NOME_MAX];
+    printf("\n--- Busca por Componente (Indice Hash) ---\n");
+    printf("Nome do componente a buscar: ");
+
+    if (lerLinha(nomeBusca, NOME_MAX) == 0) return;
+
+    uint64_t inicio = metricasAgoraNs();
+    int posEncontrada = inventarioBuscar(&mochila, nomeBusca);
+    registrarOperacao(OPERACAO_BUSCA_HASH, inicio);
+
+    printf("\n--- RESULTADO DA BUSCA ---\n");
+    if (posEncontrada >= 0) {
+        Componente *item = &mochila.componentes[posEncontrada];
+        printf("--- Componente Encontrado! ---\n");
+        printf("Nome: %s, Tipo: %s, Prioridade: %d, Qtd: 1\n", nomeDoComponente(item), tipoDoComponente(item), item->prioridade);
+        printf("Posicao no Inventario (Indice): %d\n", posEncontrada);
+    } else {
+        printf("ERRO: Componente \"%s\" nao foi encontrado na mochila.\n", nomeBusca);
+    }
+}
+
+/**
+ * @brief Implementa a Busca Binária por Nome (string).
+ */
+void buscaBinariaPorNome() {
+    if (mochila.totalComponentes == 0) {
+        printf("\nERRO: Mochila vazia. Nada para buscar.\n");
+        return;
+    }
+
+    if (mochila.statusOrdenacao == 0) {
         printf("\nERRO: A busca binaria por nome so pode ser executada APOS a ordenacao por Nome (Opcao 4 -> 1).\n");
         return;
     }
@@ -429,41 +1286,948 @@ void buscaBinariaPorNome() {
     printf("\n--- Busca Binaria por Componente-Chave ---\n");
     printf("Nome do componente a buscar: ");
     
-    if (fgets(nomeBusca, NOME_MAX, stdin) == NULL) return;
-    nomeBusca[strcspn(nomeBusca, "\n")] = 0;
-
-    int inicio = 0;
-    int fim = totalComponentes - 1;
-    int posEncontrada = -1;
-    int comparacoes = 0;
-
-    // Implementação da Busca Binária
-    while (inicio <= fim) {
-        int meio = inicio + (fim - inicio) / 2;
-        int resultado = strcmp(mochila[meio].nome, nomeBusca);
-        comparacoes++;
-
-        if (resultado == 0) {
-            posEncontrada = meio; // Componente encontrado
-            break;
-        } else if (resultado < 0) {
-            inicio = meio + 1; // Buscar na metade direita
-        } else {
-            fim = meio - 1; // Buscar na metade esquerda
-        }
-    }
+    if (lerLinha(nomeBusca, NOME_MAX) == 0) return;
+
+    long long comparacoes = 0;
+    long long desempates = 0;
+
+    // Implementação da Busca Binária (compartilhada com o benchmark)
+    uint64_t inicio = metricasAgoraNs();
+    int posEncontrada = inventarioBuscaBinaria(&mochila, nomeBusca, &comparacoes, &desempates);
+    registrarOperacao(OPERACAO_BUSCA_BINARIA, inicio);
+    metricasSomar(&metricas, CONTADOR_COMPARACOES, comparacoes);
+    metricasSomar(&metricas, CONTADOR_DESEMPATES, desempates);
 
     // Exibir resultado e desempenho
     printf("\n--- RESULTADO DA BUSCA BINARIA ---\n");
-    if (posEncontrada != -1) {
-        Componente *item = &mochila[posEncontrada];
+    if (posEncontrada >= 0) {
+        Componente *item = &mochila.componentes[posEncontrada];
         printf("--- Componente-Chave Encontrado! ---\n");
-        printf("Nome: %s, Tipo: %s, Prioridade: %d, Qtd: 1\n", item->nome, item->tipo, item->prioridade);
+        printf("Nome: %s, Tipo: %s, Prioridade: %d, Qtd: 1\n", nomeDoComponente(item), tipoDoComponente(item), item->prioridade);
         printf("Posicao no Inventario (Indice): %d\n", posEncontrada);
     } else {
         printf("ERRO: Componente \"%s\" nao foi encontrado na mochila.\n", nomeBusca);
     }
 
     printf("\n--- DESEMPENHO ---\n");
-    printf("Comparacoes de strings realizadas: %d\n", comparacoes);
-}
\ No newline at end of file
+    printf("Comparacoes de strings realizadas: %lld\n", comparacoes);
+    printf("  Resolvidas pelo prefixo: %lld | Desempates por strcmp: %lld\n", comparacoes - desempates, desempates);
+}
+
+/**
+ * @brief Lista, em ordem alfabética, os componentes cujo nome começa com um prefixo
+ * ou está entre dois nomes (inclusive). Não exige a mochila ordenada: sem ela,
+ * usa a visão por nome. Cada consulta custa O(log n + k).
+ */
+void buscarIntervaloNomes() {
+    if (mochila.totalComponentes == 0) {
+        printf("\nERRO: Mochila vazia. Nada para buscar.\n");
+        return;
+    }
+
+    int opcao;
+    printf("\n--- Busca por Prefixo ou Faixa de Nomes ---\n");
+    printf("1. Por Prefixo (ex.: Kit ou Kit*)\n2. Por Faixa (de um nome ate outro)\n");
+    printf("Opcao: ");
+    if (scanf("%d", &opcao) != 1 || opcao < 1 || opcao > 2) {
+        limparBuffer();
+        printf("Opcao invalida.\n");
+        return;
+    }
+    limparBuffer();
+
+    char de[NOME_MAX];
+    char ate[NOME_MAX];
+    printf(opcao == 1 ? "Prefixo: " : "De (nome inicial): ");
+    if (lerLinha(de, NOME_MAX) <= 0) {
+        printf("ERRO: Texto ausente ou maior que %d caracteres.\n", NOME_MAX - 1);
+        return;
+    }
+    if (opcao == 1) {
+        size_t tamanho = strlen(de);
+        if (tamanho > 0 && de[tamanho - 1] == '*') de[tamanho - 1] = '\0';
+    } else {
+        printf("Ate (nome final): ");
+        if (lerLinha(ate, NOME_MAX) <= 0) {
+            printf("ERRO: Texto ausente ou maior que %d caracteres.\n", NOME_MAX - 1);
+            return;
+        }
+    }
+
+    long long comparacoes = 0;
+    long long desempates = 0;
+    IteradorNomes iterador;
+    uint64_t inicio = metricasAgoraNs();
+    if (!prepararOrdemPorNome()) {
+        printf("\nERRO: Memoria insuficiente para montar a ordem por nome.\n");
+        return;
+    }
+    if (opcao == 1) {
+        inventarioIteradorPrefixo(&mochila, &iterador, de, &comparacoes, &desempates);
+    } else {
+        inventarioIteradorFaixa(&mochila, &iterador, de, ate, &comparacoes, &desempates);
+    }
+    registrarOperacao(OPERACAO_BUSCA_INTERVALO, inicio);
+    metricasSomar(&metricas, CONTADOR_COMPARACOES, comparacoes);
+    metricasSomar(&metricas, CONTADOR_DESEMPATES, desempates);
+
+    printf("\n----------------------------------------------------------------\n");
+    printf("| %-*s | %-*s | %-*s |\n", LARGURA_NOME_TABELA, "NOME", TIPO_MAX - 1, "TIPO", 10, "PRIORIDADE");
+    printf("----------------------------------------------------------------\n");
+    int encontrados = 0;
+    int slot;
+    while ((slot = iteradorNomesProximo(&iterador)) >= 0) {
+        const Componente *c = &mochila.componentes[slot];
+        printf("| %-*s | %-*s | %-10d |\n", LARGURA_NOME_TABELA, nomeDoComponente(c), TIPO_MAX - 1, tipoDoComponente(c), c->prioridade);
+        encontrados++;
+    }
+    printf("----------------------------------------------------------------\n");
+    printf("%d componente(s) encontrados com %lld comparacoes de nome (%lld por strcmp).\n",
+           encontrados, comparacoes, desempates);
+}
+
+/**
+ * @brief Lista os componentes com prioridade mínima informada, da maior para a menor,
+ * usando os baldes de prioridade (custo proporcional ao resultado).
+ */
+void consultarPorPrioridade() {
+    if (mochila.totalComponentes == 0) {
+        printf("\nERRO: Mochila vazia. Nada para consultar.\n");
+        return;
+    }
+
+    int prioridadeMinima;
+    printf("\n--- Consulta por Prioridade ---\n");
+    printf("Prioridade minima (1 a 10): ");
+    if (scanf("%d", &prioridadeMinima) != 1 || prioridadeMinima < PRIORIDADE_MIN || prioridadeMinima > PRIORIDADE_MAX) {
+        printf("ERRO: Prioridade invalida (deve ser entre 1 e 10).\n");
+        limparBuffer();
+        return;
+    }
+    limparBuffer();
+
+    uint64_t inicio = metricasAgoraNs();
+    int topo = inventarioTopo(&mochila);
+    if (topo < 0) return;
+    registrarOperacao(OPERACAO_MAIOR_PRIORIDADE, inicio);
+    printf("\nComponente mais importante: %s (%s, prioridade %d)\n",
+           nomeDoComponente(&mochila.componentes[topo]), tipoDoComponente(&mochila.componentes[topo]), mochila.componentes[topo].prioridade);
+
+    inicio = metricasAgoraNs();
+    int total = inventarioContarPorValor(&mochila, prioridadeMinima);
+    if (total < 0) return;
+    printf("Componentes com prioridade >= %d: %d\n", prioridadeMinima, total);
+    if (total == 0) return;
+
+    int *slots = malloc((size_t)total * sizeof(int));
+    if (slots == NULL) {
+        printf("ERRO: Memoria insuficiente para listar o resultado.\n");
+        return;
+    }
+    int encontrados = inventarioListarPorValor(&mochila, prioridadeMinima, slots, total);
+    registrarOperacao(OPERACAO_CONSULTA_PRIORIDADE, inicio);
+    for (int i = 0; i < encontrados; i++) {
+        const Componente *c = &mochila.componentes[slots[i]];
+        printf("| %-*s | %-*s | %-10d |\n", LARGURA_NOME_TABELA, nomeDoComponente(c), TIPO_MAX - 1, tipoDoComponente(c), c->prioridade);
+    }
+    free(slots);
+}
+
+/**
+ * @brief Mostra quantos componentes há de cada tipo e lista os membros de um tipo,
+ * usando o índice secundário (a ordem da mochila não muda).
+ */
+void consultarPorTipo() {
+    if (mochila.totalComponentes == 0) {
+        printf("\nERRO: Mochila vazia. Nada para consultar.\n");
+        return;
+    }
+    const IndiceTipo *indiceTipos = inventarioTipos(&mochila);
+    if (indiceTipos == NULL) return;
+
+    printf("\n--- Componentes por Tipo ---\n");
+    for (int g = 0; g < indiceTipos->totalGrupos; g++) {
+        const GrupoTipo *grupo = &indiceTipos->grupos[g];
+        if (grupo->vivos > 0) printf("%-*s: %d componente(s)\n", TIPO_MAX - 1, grupo->tipo, grupo->vivos);
+    }
+
+    char tipoBusca[TIPO_MAX];
+    printf("\nTipo para listar (Enter para voltar): ");
+    if (fgets(tipoBusca, TIPO_MAX, stdin) == NULL) return;
+    tipoBusca[strcspn(tipoBusca, "\n")] = 0;
+    if (tipoBusca[0] == '\0') return;
+
+    uint64_t inicio = metricasAgoraNs();
+    const GrupoTipo *grupo = indiceTipoBuscar(indiceTipos, tipoBusca);
+    int total = grupo != NULL ? grupo->vivos : 0;
+    if (total == 0) {
+        registrarOperacao(OPERACAO_CONSULTA_TIPO, inicio);
+        printf("Nenhum componente do tipo \"%s\" na mochila.\n", tipoBusca);
+        return;
+    }
+
+    int *slots = malloc((size_t)total * sizeof(int));
+    if (slots == NULL) {
+        printf("ERRO: Memoria insuficiente para listar o resultado.\n");
+        return;
+    }
+    int encontrados = indiceTipoListar(indiceTipos, tipoBusca, slots, total);
+    registrarOperacao(OPERACAO_CONSULTA_TIPO, inicio);
+    for (int i = 0; i < encontrados; i++) {
+        const Componente *c = &mochila.componentes[slots[i]];
+        printf("| %-*s | %-*s | %-10d |\n", LARGURA_NOME_TABELA, nomeDoComponente(c), TIPO_MAX - 1, tipoDoComponente(c), c->prioridade);
+    }
+    free(slots);
+}
+
+/**
+ * @brief Mostra os próximos componentes a montar (os mais importantes, pela fila de montagem)
+ * sem ordenar a mochila, e permite montar o primeiro, que sai da mochila.
+ */
+void exibirFilaMontagem() {
+    if (mochila.totalComponentes == 0) {
+        printf("\nERRO: Mochila vazia. Nada para montar.\n");
+        return;
+    }
+
+    int quantidade;
+    printf("\n--- Fila de Montagem (maior prioridade primeiro) ---\n");
+    printf("Quantos componentes exibir: ");
+    if (scanf("%d", &quantidade) != 1 || quantidade < 1) {
+        printf("ERRO: Quantidade invalida.\n");
+        limparBuffer();
+        return;
+    }
+    limparBuffer();
+    if (quantidade > mochila.totalComponentes) quantidade = mochila.totalComponentes;
+
+    int *slots = malloc((size_t)quantidade * sizeof(int));
+    uint64_t inicio = metricasAgoraNs();
+    int encontrados = slots != NULL ? inventarioMaiores(&mochila, quantidade, slots) : ERRO_MEMORIA;
+    registrarOperacao(OPERACAO_PROXIMOS_MONTAGEM, inicio);
+    if (encontrados < 0) {
+        printf("ERRO: Memoria insuficiente para consultar a fila.\n");
+        free(slots);
+        return;
+    }
+
+    for (int i = 0; i < encontrados; i++) {
+        const Componente *c = &mochila.componentes[slots[i]];
+        printf("%3d. | %-*s | %-*s | %-10d |\n", i + 1, LARGURA_NOME_TABELA, nomeDoComponente(c), TIPO_MAX - 1, tipoDoComponente(c), c->prioridade);
+    }
+    free(slots);
+
+    char resposta[8];
+    printf("\nMontar o primeiro da fila agora (sai da mochila)? (s/N): ");
+    if (fgets(resposta, sizeof(resposta), stdin) == NULL || (resposta[0] != 's' && resposta[0] != 'S')) return;
+
+    Componente montado;
+    char nomeMontado[NOME_MAX];
+    if (montarProximoComponente(&montado, nomeMontado) >= 0) {
+        printf("\nSUCESSO: \"%s\" (prioridade %d) montado na torre de fuga.\n", nomeMontado, montado.prioridade);
+    } else {
+        printf("\nERRO: Nao foi possivel montar o componente.\n");
+    }
+}
+
+/**
+ * @brief Exibe a mochila em outra ordem sem reorganizar o vetor (e sem perder a ordem por nome).
+ */
+void exibirVisaoOrdenada() {
+    if (mochila.totalComponentes == 0) {
+        printf("\n--- INVENTARIO VAZIO ---\n");
+        return;
+    }
+
+    int opcao;
+    printf("\n--- VISAO ORDENADA (SOMENTE LEITURA) ---\n");
+    printf("1. Por Nome\n2. Por Tipo\n3. Por Prioridade\n");
+    printf("Opcao: ");
+    if (scanf("%d", &opcao) != 1 || opcao < 1 || opcao > TOTAL_CRITERIOS) {
+        limparBuffer();
+        printf("Opcao invalida.\n");
+        return;
+    }
+    limparBuffer();
+
+    CriterioOrdenacao criterio = (CriterioOrdenacao)(opcao - 1);
+    EstatisticasOrdenacao estatisticas;
+    const VisaoOrdenada *visao = obterVisao(criterio, &estatisticas);
+    if (visao == NULL) {
+        printf("\nERRO: Memoria insuficiente para montar a visao.\n");
+        return;
+    }
+
+    printf("\n----------------------------------------------------------------\n");
+    printf("| %-*s | %-*s | %-*s |\n", LARGURA_NOME_TABELA, "NOME", TIPO_MAX - 1, "TIPO", 10, "PRIORIDADE");
+    printf("----------------------------------------------------------------\n");
+    for (int i = 0; i < visao->total; i++) {
+        const Componente *c = &mochila.componentes[visao->slots[i]];
+        printf("| %-*s | %-*s | %-10d |\n", LARGURA_NOME_TABELA, nomeDoComponente(c), TIPO_MAX - 1, tipoDoComponente(c), c->prioridade);
+    }
+    printf("----------------------------------------------------------------\n");
+    if (estatisticas.comparacoes == 0 && estatisticas.trocas == 0) {
+        printf("Visao por %s reaproveitada (mochila inalterada desde a montagem).\n", nomeCriterio(criterio));
+    } else {
+        printf("Visao por %s montada com %s: %lld comparacoes, %lld movimentacoes de indices.\n",
+               nomeCriterio(criterio), nomeAlgoritmo(mochila.algoritmoPorCriterio[criterio]),
+               estatisticas.comparacoes, estatisticas.trocas);
+    }
+}
+
+// ---------------------------------------------
+// MANUTENÇÃO
+// ---------------------------------------------
+
+/**
+ * @brief Importa ou exporta a mochila em CSV (opção 16 do menu).
+ */
+void menuArquivosCsv() {
+    int opcao;
+    printf("\n--- ARQUIVOS CSV (nome,tipo,prioridade) ---\n");
+    printf("1. Importar (acrescenta a mochila)\n2. Exportar\n");
+    printf("Opcao: ");
+    if (scanf("%d", &opcao) != 1 || opcao < 1 || opcao > 2) {
+        limparBuffer();
+        printf("Opcao invalida.\n");
+        return;
+    }
+    limparBuffer();
+
+    char caminho[LINHA_LOTE_MAX];
+    printf("Arquivo: ");
+    if (lerLinha(caminho, sizeof(caminho)) <= 0 || caminho[0] == '\0') {
+        printf("ERRO: Caminho invalido.\n");
+        return;
+    }
+
+    if (opcao == 2) {
+        int exportados;
+        if (exportarComponentesCsv(caminho, &exportados) == CSV_OK) {
+            printf("\nSUCESSO: %d componente(s) exportados para \"%s\".\n", exportados, caminho);
+        } else {
+            printf("\nERRO: Nao foi possivel gravar \"%s\".\n", caminho);
+        }
+        return;
+    }
+
+    ResumoImportacaoCsv resumo;
+    int resultado = importarComponentesCsv(caminho, &resumo);
+    if (resultado == CSV_ERRO_ARQUIVO) {
+        printf("\nERRO: Nao foi possivel ler \"%s\".\n", caminho);
+        return;
+    }
+    if (resultado == CSV_ERRO_MEMORIA) printf("\nERRO: Memoria insuficiente. A importacao parou no meio.\n");
+    printf("\n%lld linha(s): %lld importada(s), %lld rejeitada(s) em %.3f s (%.0f linhas/s, %d thread(s)).\n",
+           resumo.linhas, resumo.aceitos, resumo.rejeitados, resumo.segundos,
+           resumo.segundos > 0 ? resumo.linhas / resumo.segundos : 0.0, threadsOrdenacao);
+    for (int i = 0; i < resumo.totalRejeicoesGuardadas; i++) {
+        printf("  Linha %lld rejeitada: %s\n", resumo.primeirasRejeicoes[i].linha,
+               csvNomeMotivo(resumo.primeirasRejeicoes[i].motivo));
+    }
+    if (resumo.rejeitados > resumo.totalRejeicoesGuardadas) {
+        printf("  ... e mais %lld.\n", resumo.rejeitados - resumo.totalRejeicoesGuardadas);
+    }
+}
+
+/**
+ * @brief Compacta a mochila sob demanda e informa quantos slots foram recuperados.
+ */
+void executarCompactacao() {
+    int recuperados = compactarMochila();
+    if (recuperados == 0) {
+        printf("\nNenhuma lapide na mochila. Nada para compactar.\n");
+    } else {
+        printf("\nSUCESSO: %d slot(s) recuperados. Capacidade alocada: %d. Nomes na arena: %u bytes.\n", recuperados,
+               mochila.capacidade, mochila.nomes.usado);
+    }
+}
+
+/**
+ * @brief Liga/desliga o modo sempre ordenado por nome pelo menu.
+ */
+void alternarModoSempreOrdenado() {
+    if (!definirModoSempreOrdenado(!mochila.modoSempreOrdenado)) {
+        printf("\nERRO: Memoria insuficiente para ordenar a mochila.\n");
+        return;
+    }
+    if (mochila.modoSempreOrdenado) {
+        printf("\nModo sempre ordenado ATIVO: novos componentes entram na posicao ordenada por nome.\n");
+    } else {
+        printf("\nModo sempre ordenado DESATIVADO: novos componentes voltam a entrar no fim da mochila.\n");
+    }
+}
+
+/**
+ * @brief Exibe a latência de cada operação já executada (média, p50, p90, p99 e máximo)
+ * e os contadores acumulados desde o início do programa.
+ */
+void exibirMetricas() {
+    printf("\n--- ESTATISTICAS DE DESEMPENHO ---\n");
+    metricasExibir(&metricas);
+    if (caminhoMetricas != NULL) printf("\nO CSV completo sera gravado em \"%s\" ao sair.\n", caminhoMetricas);
+}
+// ---------------------------------------------
+// PERSISTÊNCIA (SNAPSHOT BINÁRIO)
+// ---------------------------------------------
+
+/**
+ * @brief Carrega a mochila do snapshot mapeado em memória (sem parsing nem cópia).
+ * Os registros e os nomes mapeados só são copiados para o heap quando precisarem
+ * crescer; os índices ficam pendentes até o primeiro uso.
+ * @param tempoMs Recebe o tempo total da carga em milissegundos.
+ * @return SNAPSHOT_OK, SNAPSHOT_INEXISTENTE ou SNAPSHOT_INVALIDO.
+ */
+int carregarSnapshotMochila(double *tempoMs) {
+    if (caminhoSnapshot == NULL) return SNAPSHOT_INEXISTENTE;
+
+    uint64_t inicio = metricasAgoraNs();
+    int resultado = inventarioCarregarSnapshot(&mochila, caminhoSnapshot, &geracaoSnapshot);
+    *tempoMs = (double)(metricasAgoraNs() - inicio) / 1e6;
+    return resultado;
+}
+
+/**
+ * @brief Checkpoint: grava a mochila atual no snapshot, já sem lápides, com a geração
+ * seguinte, e só então recomeça o diário nessa geração. Uma queda entre os dois passos
+ * deixa o diário antigo com a geração anterior, e ele é ignorado na próxima abertura.
+ * Chamado ao sair e sempre que o diário passa de limiteCheckpoint registros.
+ * @return 1 em caso de sucesso ou persistência desativada, 0 em caso de erro.
+ */
+int salvarSnapshotMochila() {
+    if (caminhoSnapshot == NULL) return 1;
+    uint32_t novaGeracao = geracaoSnapshot + 1;
+    int sucesso = inventarioSalvarSnapshot(&mochila, caminhoSnapshot, novaGeracao);
+    acompanharInventario(); // A gravação compacta a mochila antes
+    if (!sucesso) return 0;
+    geracaoSnapshot = novaGeracao;
+    if (diarioAtivo && !diarioReiniciar(&diario, novaGeracao)) {
+        printf("AVISO: Nao foi possivel recomecar o diario \"%s\". Ele foi desativado.\n", caminhoDiario);
+        diarioFechar(&diario);
+        diarioAtivo = 0;
+    }
+    // O snapshot não guarda o modo da sessão: o diário novo começa dizendo qual é
+    if (mochila.modoSempreOrdenado) registrarNoDiario(REGISTRO_MODO, 1, 0, 0, "", "");
+    return 1;
+}
+
+/**
+ * @brief Grava um checkpoint quando o diário acumulou limiteCheckpoint registros,
+ * para que a reaplicação na próxima abertura continue curta.
+ */
+void checkpointSeNecessario() {
+    if (!diarioAtivo || limiteCheckpoint == 0 || diario.registrosDesdeCheckpoint < limiteCheckpoint) return;
+    if (diarioConfirmar(&diario) && salvarSnapshotMochila()) return;
+    // Sem checkpoint o diário continua valendo; a próxima tentativa vem no próximo registro
+    printf("AVISO: Nao foi possivel gravar o checkpoint em \"%s\".\n", caminhoSnapshot);
+}
+
+// ---------------------------------------------
+// PERSISTÊNCIA (DIÁRIO DE OPERAÇÕES)
+// ---------------------------------------------
+
+/**
+ * @brief Abre o diário da geração do snapshot carregado e reaplica as operações dele.
+ * Sem snapshot não há checkpoint, então o diário também fica desligado.
+ * @param tempoMs Recebe o tempo da reaplicação em milissegundos.
+ * @return 1 se o diário está ativo (ou desligado por opção), 0 em caso de erro de E/S.
+ */
+int abrirDiarioMochila(ReaplicacaoDiario *reaplicacao, double *tempoMs) {
+    memset(reaplicacao, 0, sizeof(*reaplicacao));
+    if (caminhoSnapshot == NULL || caminhoDiario == NULL) return 1;
+
+    uint64_t inicio = metricasAgoraNs();
+    reaplicandoDiario = 1;
+    int resultado = diarioAbrir(&diario, caminhoDiario, geracaoSnapshot, registrosPorGrupo,
+                                (uint64_t)INTERVALO_DIARIO_MS * 1000000u, reaplicarRegistroDiario, NULL, reaplicacao);
+    reaplicandoDiario = 0;
+    *tempoMs = (double)(metricasAgoraNs() - inicio) / 1e6;
+
+    // A reaplicação passa pelas operações medidas; as métricas da sessão começam do zero
+    metricasInicializar(&metricas, NOMES_OPERACOES, TOTAL_OPERACOES, NOMES_CONTADORES, TOTAL_CONTADORES);
+    contadoresVistos = mochila.contadores;
+    diarioAtivo = resultado == DIARIO_OK;
+    return diarioAtivo;
+}
+
+/**
+ * @brief Acrescenta uma operação já aplicada ao diário (nada acontece durante a reaplicação).
+ * Se o disco falhar, o diário é desligado e a mochila só será salva no próximo checkpoint.
+ */
+void registrarNoDiario(TipoRegistroDiario tipo, int a, int b, int c, const char *nome, const char *tipoComponente) {
+    if (!diarioAtivo || reaplicandoDiario) return;
+
+    unsigned char dados[3 + NOME_MAX + TIPO_MAX];
+    size_t tamanhoNome = strlen(nome) + 1;
+    size_t tamanhoTipo = strlen(tipoComponente) + 1;
+    dados[0] = (unsigned char)a;
+    dados[1] = (unsigned char)b;
+    dados[2] = (unsigned char)c;
+    memcpy(dados + 3, nome, tamanhoNome);
+    memcpy(dados + 3 + tamanhoNome, tipoComponente, tamanhoTipo);
+
+    if (!diarioRegistrar(&diario, (uint8_t)tipo, dados, 3 + tamanhoNome + tamanhoTipo)) {
+        printf("AVISO: Falha ao gravar o diario \"%s\". Ele foi desativado.\n", caminhoDiario);
+        diarioFechar(&diario);
+        diarioAtivo = 0;
+    }
+}
+
+/**
+ * @brief Refaz uma operação lida do diário pelas mesmas funções do núcleo.
+ * @return 1 se a operação foi aplicada, 0 se o registro é inválido ou falhou.
+ */
+int reaplicarRegistroDiario(uint8_t tipo, const void *dados, size_t tamanho, void *contexto) {
+    const unsigned char *bytes = dados;
+    (void)contexto;
+
+    // Valida o formato: três parâmetros e dois textos terminados em '\0'
+    if (tamanho < 5) return 0;
+    const char *nome = (const char *)bytes + 3;
+    const char *fimNome = memchr(nome, '\0', tamanho - 3);
+    if (fimNome == NULL) return 0;
+    const char *tipoComponente = fimNome + 1;
+    size_t restante = tamanho - 3 - (size_t)(tipoComponente - nome);
+    if (restante == 0 || memchr(tipoComponente, '\0', restante) == NULL) return 0;
+
+    switch (tipo) {
+        case REGISTRO_ADICIONAR:
+            return inserirComponente(nome, tipoComponente, bytes[0]) >= 0;
+        case REGISTRO_DESCARTAR:
+            return removerComponente(nome) >= 0;
+        case REGISTRO_ALTERAR_PRIORIDADE:
+            return alterarPrioridade(nome, bytes[0]) >= 0;
+        case REGISTRO_MONTAR: {
+            Componente montado;
+            char nomeMontado[NOME_MAX];
+            return montarProximoComponente(&montado, nomeMontado) >= 0;
+        }
+        case REGISTRO_ORDENAR: {
+            if (bytes[0] >= TOTAL_CRITERIOS || bytes[1] >= TOTAL_ALGORITMOS ||
+                !algoritmoSuportaCriterio((AlgoritmoOrdenacao)bytes[1], (CriterioOrdenacao)bytes[0])) {
+                return 0;
+            }
+            EstatisticasOrdenacao estatisticas;
+            int indiretaAtual = mochila.ordenacaoIndireta;
+            mochila.ordenacaoIndireta = bytes[2] != 0;
+            int sucesso = ordenarMochila((CriterioOrdenacao)bytes[0], (AlgoritmoOrdenacao)bytes[1], &estatisticas);
+            mochila.ordenacaoIndireta = indiretaAtual;
+            return sucesso;
+        }
+        case REGISTRO_MODO:
+            return definirModoSempreOrdenado(bytes[0] != 0);
+        case REGISTRO_ORDENAR_COMPOSTO: {
+            OrdemComposta ordem;
+            if (!ordemCompostaPorTexto(nome, &ordem) || !algoritmoSuportaOrdemComposta((AlgoritmoOrdenacao)bytes[0])) {
+                return 0;
+            }
+            EstatisticasOrdenacao estatisticas;
+            return ordenarMochilaComposta(&ordem, (AlgoritmoOrdenacao)bytes[0], &estatisticas);
+        }
+        default:
+            return 0;
+    }
+}
+
+// ---------------------------------------------
+// MODO LOTE (SCRIPT)
+// ---------------------------------------------
+
+/**
+ * @brief Relógio monotônico em segundos (usado no resumo do modo lote).
+ */
+static double agoraSegundos() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Executa um fluxo de comandos sem menu, pausas ou listagens automáticas.
+ *
+ * Um comando por linha (linhas vazias e iniciadas por '#' são ignoradas):
+ *   add <nome> <tipo> <prioridade>
+ *   del <nome>
+ *   sort <nome|tipo|prioridade> [algoritmo|paralelo]
+ *   sort <criterio,criterio,...> [algoritmo]   (ordem composta, '-' = decrescente:
+ *                       "sort tipo,-prioridade,nome"; padrão radix, numa só passada)
+ *   find <nome>
+ *   bfind <nome>        (busca binária; exige a mochila ordenada por nome)
+ *   prefix <prefixo>    (nomes que começam com o prefixo, em ordem alfabética)
+ *   range <de> <ate>    (nomes entre de e ate, inclusive, em ordem alfabética)
+ *   mode <ordenado|livre>
+ *   prio <minima>       (componentes com prioridade >= minima, da maior para a menor)
+ *   view <nome|tipo|prioridade>   (lista em outra ordem sem reorganizar a mochila)
+ *   types               (quantidade de componentes de cada tipo)
+ *   type <tipo>         (componentes de um tipo, pelo índice secundário)
+ *   top                 (componente mais importante, topo da fila de montagem)
+ *   topk <k>            (os k próximos componentes a montar, sem ordenar a mochila)
+ *   pop                 (monta o topo da fila: o componente sai da mochila)
+ *   setprio <nome> <prioridade>
+ *   list
+ *   page <n>            (primeiras n linhas; "next" mostra as n seguintes)
+ *   next
+ *   compact
+ *   stats               (métricas de latência e contadores em CSV)
+ *   import <arquivo.csv>  (acrescenta os registros "nome,tipo,prioridade" válidos)
+ *   export <arquivo.csv>  (grava os componentes vivos na ordem atual)
+ * Apenas os resultados são impressos, seguidos de um resumo com o tempo total.
+ * @return Quantidade de comandos que falharam.
+ */
+int executarModoLote(FILE *entrada) {
+    char linha[LINHA_LOTE_MAX];
+    long long comandos = 0, erros = 0;
+    int numeroLinha = 0;
+
+    // Saída totalmente bufferizada: milhares de resultados viram poucas chamadas de escrita
+    setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+    double inicio = agoraSegundos();
+
+    while (fgets(linha, sizeof(linha), entrada) != NULL) {
+        numeroLinha++;
+        // Uma linha que não coube no buffer é recusada inteira (o resto não vira outro comando)
+        if (strchr(linha, '\n') == NULL && !feof(entrada)) {
+            int c;
+            while ((c = fgetc(entrada)) != '\n' && c != EOF) {}
+            printf("ERRO linha %d: linha maior que %d caracteres\n", numeroLinha, LINHA_LOTE_MAX - 2);
+            comandos++;
+            erros++;
+            continue;
+        }
+        char *comando = strtok(linha, " \t\r\n");
+        if (comando == NULL || comando[0] == '#') continue;
+
+        char *arg1 = strtok(NULL, " \t\r\n");
+        char *arg2 = strtok(NULL, " \t\r\n");
+        char *arg3 = strtok(NULL, " \t\r\n");
+        int sucesso = 0;
+        comandos++;
+
+        if (strcmp(comando, "add") == 0 && arg3 != NULL) {
+            int resultado = inserirComponente(arg1, arg2, atoi(arg3));
+            if (resultado >= 0) {
+                sucesso = 1;
+            } else if (resultado == ERRO_PRIORIDADE) {
+                printf("ERRO linha %d: prioridade invalida \"%s\" (1 a 10)\n", numeroLinha, arg3);
+            } else if (resultado == ERRO_NOME_INVALIDO) {
+                printf("ERRO linha %d: nome ou tipo muito longo\n", numeroLinha);
+            } else if (resultado == ERRO_TIPOS_ESGOTADOS) {
+                printf("ERRO linha %d: limite de %d tipos distintos atingido\n", numeroLinha, TIPOS_DISTINTOS_MAX);
+            } else {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            }
+        } else if (strcmp(comando, "del") == 0 && arg1 != NULL) {
+            sucesso = removerComponente(arg1) >= 0;
+            if (!sucesso) printf("ERRO linha %d: componente \"%s\" nao encontrado\n", numeroLinha, arg1);
+        } else if (strcmp(comando, "find") == 0 && arg1 != NULL) {
+            uint64_t inicioOperacao = metricasAgoraNs();
+            int pos = inventarioBuscar(&mochila, arg1);
+            registrarOperacao(OPERACAO_BUSCA_HASH, inicioOperacao);
+            if (pos >= 0) {
+                printf("ENCONTRADO %s %s %d %d\n", nomeDoComponente(&mochila.componentes[pos]), tipoDoComponente(&mochila.componentes[pos]), mochila.componentes[pos].prioridade, pos);
+            } else {
+                printf("NAO_ENCONTRADO %s\n", arg1);
+            }
+            sucesso = 1;
+        } else if (strcmp(comando, "sort") == 0 && arg1 != NULL) {
+            CriterioOrdenacao criterio;
+            AlgoritmoOrdenacao algoritmo;
+            EstatisticasOrdenacao estatisticas;
+            OrdemComposta ordem;
+            if (!criterioPorNome(arg1, &criterio) && ordemCompostaPorTexto(arg1, &ordem)) {
+                char texto[ORDEM_COMPOSTA_TEXTO_MAX];
+                ordemCompostaTexto(&ordem, texto, sizeof(texto));
+                algoritmo = ALGORITMO_RADIX;
+                if (arg2 != NULL && (!algoritmoPorNome(arg2, &algoritmo) || !algoritmoSuportaOrdemComposta(algoritmo))) {
+                    printf("ERRO linha %d: algoritmo invalido para ordem composta \"%s\"\n", numeroLinha, arg2);
+                } else if (!(sucesso = ordenarMochilaComposta(&ordem, algoritmo, &estatisticas))) {
+                    if (mochila.modoSempreOrdenado) {
+                        printf("ERRO linha %d: modo sempre ordenado ativo (use \"mode livre\" antes)\n", numeroLinha);
+                    } else {
+                        printf("ERRO linha %d: nao foi possivel ordenar por \"%s\"\n", numeroLinha, texto);
+                    }
+                } else {
+                    printf("ORDENADO %s %s comparacoes=%lld prefixo=%lld strcmp=%lld trocas=%lld tempo=%.6f\n", texto,
+                           idAlgoritmo(algoritmo), estatisticas.comparacoes, estatisticas.acertosPrefixo,
+                           estatisticas.desempatesTexto, estatisticas.trocas, estatisticas.tempoSegundos);
+                }
+            } else if (!criterioPorNome(arg1, &criterio)) {
+                printf("ERRO linha %d: criterio desconhecido \"%s\"\n", numeroLinha, arg1);
+            } else if (arg2 != NULL && strcmp(arg2, "paralelo") != 0 && !algoritmoPorNome(arg2, &algoritmo)) {
+                printf("ERRO linha %d: algoritmo desconhecido \"%s\"\n", numeroLinha, arg2);
+            } else if (mochila.modoSempreOrdenado && criterio != CRITERIO_NOME) {
+                printf("ERRO linha %d: modo sempre ordenado ativo (use \"mode livre\" antes)\n", numeroLinha);
+            } else if (arg2 != NULL && strcmp(arg2, "paralelo") == 0) {
+                EstatisticasThread *porThread = calloc((size_t)threadsOrdenacao, sizeof(EstatisticasThread));
+                sucesso = porThread != NULL && ordenarMochilaParalelo(criterio, &estatisticas, porThread);
+                if (sucesso) {
+                    printf("ORDENADO %s paralelo comparacoes=%lld prefixo=%lld strcmp=%lld trocas=%lld tempo=%.6f threads=%d\n",
+                           nomeCriterio(criterio), estatisticas.comparacoes, estatisticas.acertosPrefixo,
+                           estatisticas.desempatesTexto, estatisticas.trocas, estatisticas.tempoSegundos, threadsOrdenacao);
+                    for (int t = 0; t < threadsOrdenacao; t++) {
+                        printf("THREAD %d tarefas=%d comparacoes=%lld trocas=%lld tempo=%.6f\n", t, porThread[t].tarefas,
+                               porThread[t].comparacoes, porThread[t].trocas, porThread[t].tempoSegundos);
+                    }
+                } else {
+                    printf("ERRO linha %d: nao foi possivel ordenar em paralelo\n", numeroLinha);
+                }
+                free(porThread);
+            } else {
+                if (arg2 == NULL) algoritmo = mochila.algoritmoPorCriterio[criterio];
+                sucesso = ordenarMochila(criterio, algoritmo, &estatisticas);
+                if (sucesso) {
+                    printf("ORDENADO %s %s comparacoes=%lld prefixo=%lld strcmp=%lld trocas=%lld tempo=%.6f\n",
+                           nomeCriterio(criterio), idAlgoritmo(algoritmo), estatisticas.comparacoes,
+                           estatisticas.acertosPrefixo, estatisticas.desempatesTexto, estatisticas.trocas,
+                           estatisticas.tempoSegundos);
+                } else {
+                    printf("ERRO linha %d: nao foi possivel ordenar com \"%s\"\n", numeroLinha, idAlgoritmo(algoritmo));
+                }
+            }
+        } else if (strcmp(comando, "list") == 0) {
+            uint64_t inicioOperacao = metricasAgoraNs();
+            int linhas;
+            montarLinhasComponentes(0, 0, 1, &linhas);
+            sucesso = bufferSaidaDescarregar(&bufferListagem);
+            registrarOperacao(OPERACAO_LISTAR, inicioOperacao);
+        } else if (strcmp(comando, "page") == 0 || strcmp(comando, "next") == 0) {
+            // "page N" lista as N primeiras linhas; "next" continua do cursor com o mesmo tamanho
+            if (comando[0] == 'p') {
+                linhasPorPagina = arg1 != NULL ? atoi(arg1) : linhasPorPagina;
+                cursorListagem = 0;
+            }
+            uint64_t inicioOperacao = metricasAgoraNs();
+            int linhas;
+            cursorListagem = montarLinhasComponentes(cursorListagem, linhasPorPagina, 1, &linhas);
+            bufferSaidaFormatar(&bufferListagem, "PAGINA linhas=%d fim=%d\n", linhas, cursorListagem >= mochila.slotsUsados);
+            sucesso = bufferSaidaDescarregar(&bufferListagem);
+            registrarOperacao(OPERACAO_LISTAR, inicioOperacao);
+        } else if (strcmp(comando, "bfind") == 0 && arg1 != NULL) {
+            if (!mochila.statusOrdenacao) {
+                printf("ERRO linha %d: busca binaria exige a mochila ordenada por nome\n", numeroLinha);
+            } else {
+                long long comparacoes = 0, desempates = 0;
+                uint64_t inicioOperacao = metricasAgoraNs();
+                int pos = inventarioBuscaBinaria(&mochila, arg1, &comparacoes, &desempates);
+                registrarOperacao(OPERACAO_BUSCA_BINARIA, inicioOperacao);
+                metricasSomar(&metricas, CONTADOR_COMPARACOES, comparacoes);
+                metricasSomar(&metricas, CONTADOR_DESEMPATES, desempates);
+                if (pos >= 0) {
+                    printf("ENCONTRADO %s %s %d %d comparacoes=%lld strcmp=%lld\n", nomeDoComponente(&mochila.componentes[pos]), tipoDoComponente(&mochila.componentes[pos]),
+                           mochila.componentes[pos].prioridade, pos, comparacoes, desempates);
+                } else {
+                    printf("NAO_ENCONTRADO %s comparacoes=%lld strcmp=%lld\n", arg1, comparacoes, desempates);
+                }
+                sucesso = 1;
+            }
+        } else if ((strcmp(comando, "prefix") == 0 && arg1 != NULL) || (strcmp(comando, "range") == 0 && arg2 != NULL)) {
+            int porPrefixo = strcmp(comando, "prefix") == 0;
+            long long comparacoes = 0, desempates = 0;
+            IteradorNomes iterador;
+            uint64_t inicioOperacao = metricasAgoraNs();
+            if (!prepararOrdemPorNome()) {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            } else {
+                if (porPrefixo) {
+                    inventarioIteradorPrefixo(&mochila, &iterador, arg1, &comparacoes, &desempates);
+                } else {
+                    inventarioIteradorFaixa(&mochila, &iterador, arg1, arg2, &comparacoes, &desempates);
+                }
+                registrarOperacao(OPERACAO_BUSCA_INTERVALO, inicioOperacao);
+                metricasSomar(&metricas, CONTADOR_COMPARACOES, comparacoes);
+                metricasSomar(&metricas, CONTADOR_DESEMPATES, desempates);
+
+                // Uma passada numa cópia do iterador conta os vivos para o cabeçalho
+                IteradorNomes contagem = iterador;
+                int encontrados = 0;
+                while (iteradorNomesProximo(&contagem) >= 0) encontrados++;
+                if (porPrefixo) {
+                    printf("PREFIXO %s total=%d comparacoes=%lld strcmp=%lld\n", arg1, encontrados, comparacoes, desempates);
+                } else {
+                    printf("FAIXA %s %s total=%d comparacoes=%lld strcmp=%lld\n", arg1, arg2, encontrados, comparacoes,
+                           desempates);
+                }
+                int slot;
+                while ((slot = iteradorNomesProximo(&iterador)) >= 0) {
+                    const Componente *c = &mochila.componentes[slot];
+                    printf("%s %s %d\n", nomeDoComponente(c), tipoDoComponente(c), c->prioridade);
+                }
+                sucesso = 1;
+            }
+        } else if (strcmp(comando, "mode") == 0 && arg1 != NULL &&
+                   (strcmp(arg1, "ordenado") == 0 || strcmp(arg1, "livre") == 0)) {
+            sucesso = definirModoSempreOrdenado(strcmp(arg1, "ordenado") == 0);
+            if (!sucesso) printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+        } else if (strcmp(comando, "prio") == 0 && arg1 != NULL) {
+            int minima = atoi(arg1);
+            int *slots = NULL;
+            // A contagem (que pode reconstruir os baldes) entra na latência da consulta
+            uint64_t inicioOperacao = metricasAgoraNs();
+            int total = -1;
+            if (minima < PRIORIDADE_MIN || minima > PRIORIDADE_MAX) {
+                printf("ERRO linha %d: prioridade invalida \"%s\" (1 a 10)\n", numeroLinha, arg1);
+            } else if ((total = inventarioContarPorValor(&mochila, minima)) < 0 ||
+                       (slots = malloc((size_t)total * sizeof(int) + 1)) == NULL) {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            } else {
+                int encontrados = inventarioListarPorValor(&mochila, minima, slots, total);
+                registrarOperacao(OPERACAO_CONSULTA_PRIORIDADE, inicioOperacao);
+                printf("PRIORIDADE >=%d total=%d\n", minima, encontrados);
+                for (int i = 0; i < encontrados; i++) {
+                    const Componente *c = &mochila.componentes[slots[i]];
+                    printf("%s %s %d\n", nomeDoComponente(c), tipoDoComponente(c), c->prioridade);
+                }
+                free(slots);
+                sucesso = 1;
+            }
+        } else if (strcmp(comando, "view") == 0 && arg1 != NULL) {
+            CriterioOrdenacao criterio;
+            EstatisticasOrdenacao estatisticas;
+            const VisaoOrdenada *visao = NULL;
+            if (!criterioPorNome(arg1, &criterio)) {
+                printf("ERRO linha %d: criterio desconhecido \"%s\"\n", numeroLinha, arg1);
+            } else if ((visao = obterVisao(criterio, &estatisticas)) == NULL) {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            } else {
+                printf("VISAO %s total=%d comparacoes=%lld\n", nomeCriterio(criterio), visao->total, estatisticas.comparacoes);
+                for (int i = 0; i < visao->total; i++) {
+                    const Componente *c = &mochila.componentes[visao->slots[i]];
+                    printf("%s %s %d\n", nomeDoComponente(c), tipoDoComponente(c), c->prioridade);
+                }
+                sucesso = 1;
+            }
+        } else if (strcmp(comando, "types") == 0) {
+            const IndiceTipo *indiceTipos = inventarioTipos(&mochila);
+            if (indiceTipos != NULL) {
+                for (int g = 0; g < indiceTipos->totalGrupos; g++) {
+                    const GrupoTipo *grupo = &indiceTipos->grupos[g];
+                    if (grupo->vivos > 0) printf("TIPO %s componentes=%d\n", grupo->tipo, grupo->vivos);
+                }
+                sucesso = 1;
+            } else {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            }
+        } else if (strcmp(comando, "type") == 0 && arg1 != NULL) {
+            const IndiceTipo *indiceTipos = inventarioTipos(&mochila);
+            if (indiceTipos == NULL) {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            } else {
+                uint64_t inicioOperacao = metricasAgoraNs();
+                const GrupoTipo *grupo = indiceTipoBuscar(indiceTipos, arg1);
+                int total = grupo != NULL ? grupo->vivos : 0;
+                int *slots = malloc((size_t)total * sizeof(int) + 1);
+                if (slots == NULL) {
+                    printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+                } else {
+                    int encontrados = indiceTipoListar(indiceTipos, arg1, slots, total);
+                    registrarOperacao(OPERACAO_CONSULTA_TIPO, inicioOperacao);
+                    printf("TIPO %s total=%d\n", arg1, encontrados);
+                    for (int i = 0; i < encontrados; i++) {
+                        const Componente *c = &mochila.componentes[slots[i]];
+                        printf("%s %s %d\n", nomeDoComponente(c), tipoDoComponente(c), c->prioridade);
+                    }
+                    free(slots);
+                    sucesso = 1;
+                }
+            }
+        } else if (strcmp(comando, "top") == 0) {
+            uint64_t inicioOperacao = metricasAgoraNs();
+            int pos = inventarioTopo(&mochila);
+            registrarOperacao(OPERACAO_MAIOR_PRIORIDADE, inicioOperacao);
+            if (pos >= 0) {
+                printf("TOPO %s %s %d %d\n", nomeDoComponente(&mochila.componentes[pos]), tipoDoComponente(&mochila.componentes[pos]), mochila.componentes[pos].prioridade, pos);
+            } else {
+                printf("TOPO vazio\n");
+            }
+            sucesso = 1;
+        } else if (strcmp(comando, "stats") == 0) {
+            // CSV no mesmo formato do arquivo gravado ao sair, depois do que já foi impresso
+            sucesso = metricasExportar(&metricas, stdout);
+        } else if (strcmp(comando, "topk") == 0 && arg1 != NULL) {
+            int k = atoi(arg1);
+            int *slots = NULL;
+            int encontrados = -1;
+            if (k < 1) {
+                printf("ERRO linha %d: quantidade invalida \"%s\"\n", numeroLinha, arg1);
+            } else {
+                if (k > mochila.totalComponentes) k = mochila.totalComponentes;
+                uint64_t inicioOperacao = metricasAgoraNs();
+                slots = malloc((size_t)k * sizeof(int) + 1);
+                if (slots != NULL) encontrados = inventarioMaiores(&mochila, k, slots);
+                registrarOperacao(OPERACAO_PROXIMOS_MONTAGEM, inicioOperacao);
+                if (encontrados < 0) {
+                    printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+                } else {
+                    printf("FILA total=%d\n", encontrados);
+                    for (int i = 0; i < encontrados; i++) {
+                        const Componente *c = &mochila.componentes[slots[i]];
+                        printf("%s %s %d\n", nomeDoComponente(c), tipoDoComponente(c), c->prioridade);
+                    }
+                    sucesso = 1;
+                }
+                free(slots);
+            }
+        } else if (strcmp(comando, "pop") == 0) {
+            Componente montado;
+            char nomeMontado[NOME_MAX];
+            int resultado = montarProximoComponente(&montado, nomeMontado);
+            if (resultado >= 0) {
+                printf("MONTADO %s %s %d %d\n", nomeMontado, tipoDoComponente(&montado), montado.prioridade, resultado);
+                sucesso = 1;
+            } else if (resultado == ERRO_NAO_ENCONTRADO) {
+                printf("ERRO linha %d: mochila vazia\n", numeroLinha);
+            } else {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            }
+        } else if (strcmp(comando, "setprio") == 0 && arg2 != NULL) {
+            int resultado = alterarPrioridade(arg1, atoi(arg2));
+            if (resultado >= 0) {
+                sucesso = 1;
+            } else if (resultado == ERRO_PRIORIDADE) {
+                printf("ERRO linha %d: prioridade invalida \"%s\" (1 a 10)\n", numeroLinha, arg2);
+            } else if (resultado == ERRO_NAO_ENCONTRADO) {
+                printf("ERRO linha %d: componente \"%s\" nao encontrado\n", numeroLinha, arg1);
+            } else {
+                printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            }
+        } else if (strcmp(comando, "compact") == 0) {
+            printf("COMPACTADO recuperados=%d capacidade=%d\n", compactarMochila(), mochila.capacidade);
+            sucesso = 1;
+        } else if (strcmp(comando, "import") == 0 && arg1 != NULL) {
+            ResumoImportacaoCsv resumo;
+            int resultado = importarComponentesCsv(arg1, &resumo);
+            if (resultado == CSV_ERRO_ARQUIVO) {
+                printf("ERRO linha %d: nao foi possivel ler \"%s\"\n", numeroLinha, arg1);
+            } else {
+                printf("IMPORTADO linhas=%lld aceitos=%lld rejeitados=%lld tempo=%.6f linhas/s=%.0f\n", resumo.linhas,
+                       resumo.aceitos, resumo.rejeitados, resumo.segundos,
+                       resumo.segundos > 0 ? resumo.linhas / resumo.segundos : 0.0);
+                for (int i = 0; i < resumo.totalRejeicoesGuardadas; i++) {
+                    printf("REJEITADA linha=%lld motivo=%s\n", resumo.primeirasRejeicoes[i].linha,
+                           csvNomeMotivo(resumo.primeirasRejeicoes[i].motivo));
+                }
+                sucesso = resultado == CSV_OK;
+                if (!sucesso) printf("ERRO linha %d: memoria insuficiente\n", numeroLinha);
+            }
+        } else if (strcmp(comando, "export") == 0 && arg1 != NULL) {
+            int exportados;
+            sucesso = exportarComponentesCsv(arg1, &exportados) == CSV_OK;
+            if (sucesso) {
+                printf("EXPORTADO registros=%d\n", exportados);
+            } else {
+                printf("ERRO linha %d: nao foi possivel gravar \"%s\"\n", numeroLinha, arg1);
+            }
+        } else {
+            printf("ERRO linha %d: comando invalido \"%s\"\n", numeroLinha, comando);
+        }
+
+        if (!sucesso) erros++;
+        checkpointSeNecessario();
+    }
+
+    double tempoTotal = agoraSegundos() - inicio;
+    printf("RESUMO comandos=%lld erros=%lld componentes=%d tempo=%.6f s (%.0f comandos/s)\n",
+           comandos, erros, mochila.totalComponentes, tempoTotal, tempoTotal > 0 ? comandos / tempoTotal : 0.0);
+    fflush(stdout);
+    return (int)(erros > 0x7fffffff ? 0x7fffffff : erros);
+}
@@ -0,0 +1,184 @@
+#include <stdlib.h>
+#include <string.h>
+#include "arena_nomes.h"
+#include "prefixo_chave.h"
+
+// Capacidade inicial do bloco (cresce dobrando)
+#define ARENA_CAPACIDADE_MINIMA 1024
+// Maior bloco endereçável pelo deslocamento de 32 bits do componente
+#define ARENA_CAPACIDADE_MAXIMA 0xFFFFFFFFu
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Capacidade (dobrando a partir da atual) que comporta o total necessário.
+ * @return A capacidade, ou 0 se passar do limite do deslocamento de 32 bits.
+ */
+static uint32_t capacidadePara(uint32_t atual, uint64_t necessario) {
+    if (necessario > ARENA_CAPACIDADE_MAXIMA) return 0;
+    uint64_t capacidade = atual > 0 ? atual : ARENA_CAPACIDADE_MINIMA;
+    while (capacidade < necessario) capacidade *= 2;
+    return capacidade > ARENA_CAPACIDADE_MAXIMA ? ARENA_CAPACIDADE_MAXIMA : (uint32_t)capacidade;
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Deixa a arena vazia (o bloco só é alocado ao guardar o primeiro nome).
+ */
+void arenaNomesInicializar(ArenaNomes *arena) {
+    memset(arena, 0, sizeof(*arena));
+}
+
+/**
+ * @brief Usa um bloco de nomes de outro dono sem copiá-lo (ex.: o bloco de um snapshot mapeado).
+ * O bloco precisa continuar válido até arenaNomesTornarPropria ou arenaNomesLiberar.
+ */
+void arenaNomesAdotar(ArenaNomes *arena, const char *dados, size_t tamanho) {
+    arena->dados = (char *)dados;
+    arena->usado = (uint32_t)tamanho;
+    arena->capacidade = (uint32_t)tamanho;
+    arena->descartados = 0;
+    arena->emprestado = 1;
+}
+
+/**
+ * @brief Copia um bloco emprestado para o heap (antes de o dono dele ser liberado).
+ * @return 1 em caso de sucesso (ou se o bloco já era próprio), 0 se não houver memória.
+ */
+int arenaNomesTornarPropria(ArenaNomes *arena) {
+    if (!arena->emprestado) return 1;
+    uint32_t capacidade = capacidadePara(0, arena->usado);
+    char *copia = malloc(capacidade);
+    if (copia == NULL) return 0;
+    if (arena->usado > 0) memcpy(copia, arena->dados, arena->usado);
+    arena->dados = copia;
+    arena->capacidade = capacidade;
+    arena->emprestado = 0;
+    return 1;
+}
+
+/**
+ * @brief Libera o bloco (se for próprio) e deixa a arena vazia.
+ */
+void arenaNomesLiberar(ArenaNomes *arena) {
+    if (!arena->emprestado) free(arena->dados);
+    arenaNomesInicializar(arena);
+}
+
+/**
+ * @brief Garante espaço para mais "bytes" bytes de nomes sem mover o bloco depois
+ * (ex.: uma carga em lote que não pode falhar no meio). Um bloco emprestado vira próprio.
+ * @return 1 em caso de sucesso, 0 se não houver memória (a arena fica como estava).
+ */
+int arenaNomesReservar(ArenaNomes *arena, size_t bytes) {
+    uint64_t necessario = (uint64_t)arena->usado + bytes;
+    if (!arena->emprestado && necessario <= arena->capacidade) return 1;
+
+    uint32_t capacidade = capacidadePara(arena->capacidade, necessario);
+    if (capacidade == 0) return 0;
+    char *novo;
+    if (arena->emprestado) {
+        novo = malloc(capacidade);
+        if (novo != NULL && arena->usado > 0) memcpy(novo, arena->dados, arena->usado);
+    } else {
+        novo = realloc(arena->dados, capacidade);
+    }
+    if (novo == NULL) return 0;
+    arena->dados = novo;
+    arena->capacidade = capacidade;
+    arena->emprestado = 0;
+    return 1;
+}
+
+/**
+ * @brief Copia um texto (mais o '\0') para o fim da arena, crescendo o bloco se preciso.
+ * @param deslocamento Recebe a posição do texto na arena.
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int arenaNomesGuardar(ArenaNomes *arena, const char *texto, size_t tamanho, uint32_t *deslocamento) {
+    uint64_t necessario = (uint64_t)arena->usado + tamanho + 1;
+    if (!arenaNomesReservar(arena, tamanho + 1)) return 0;
+
+    *deslocamento = arena->usado;
+    memcpy(arena->dados + arena->usado, texto, tamanho);
+    arena->dados[arena->usado + tamanho] = '\0';
+    arena->usado = (uint32_t)necessario;
+    return 1;
+}
+
+/**
+ * @brief Conta os bytes do nome de um componente descartado (recuperados na compactação).
+ * O texto continua legível até lá.
+ */
+void arenaNomesDescartar(ArenaNomes *arena, const Componente *componente) {
+    arena->descartados += (uint32_t)componente->tamanhoNome + 1;
+}
+
+/**
+ * @brief Guarda o nome na arena e preenche deslocamento, tamanho e prefixo do componente.
+ * @return 1 em caso de sucesso, 0 se o nome for longo demais ou não houver memória.
+ */
+int arenaNomesAtribuir(ArenaNomes *arena, Componente *componente, const char *nome) {
+    size_t tamanho = strlen(nome);
+    if (tamanho >= NOME_MAX) return 0;
+    uint32_t deslocamento;
+    if (!arenaNomesGuardar(arena, nome, tamanho, &deslocamento)) return 0;
+    componente->deslocamentoNome = deslocamento;
+    componente->tamanhoNome = (uint16_t)tamanho;
+    componente->prefixoNome = prefixoChave(nome);
+    return 1;
+}
+
+/**
+ * @brief Copia para um bloco novo só os nomes dos componentes informados, na ordem do
+ * vetor (quem vem em seguida no vetor também fica em seguida na arena), e corrige os
+ * deslocamentos. Os nomes de quem não está no vetor (descartados) são recuperados.
+ * Chamar depois de remover as lápides, cujos nomes também seriam mantidos.
+ * @return 1 em caso de sucesso, 0 se não houver memória (a arena fica como estava).
+ */
+int arenaNomesCompactar(ArenaNomes *arena, Componente *componentes, int total) {
+    uint64_t necessario = 0;
+    for (int i = 0; i < total; i++) necessario += (uint64_t)componentes[i].tamanhoNome + 1;
+    uint32_t capacidade = capacidadePara(0, necessario);
+    char *novo = capacidade > 0 ? malloc(capacidade) : NULL;
+    if (novo == NULL) return 0;
+
+    uint32_t usado = 0;
+    for (int i = 0; i < total; i++) {
+        uint32_t comprimento = (uint32_t)componentes[i].tamanhoNome + 1;
+        memcpy(novo + usado, arena->dados + componentes[i].deslocamentoNome, comprimento);
+        componentes[i].deslocamentoNome = usado;
+        usado += comprimento;
+    }
+
+    if (!arena->emprestado) free(arena->dados);
+    arena->dados = novo;
+    arena->usado = usado;
+    arena->capacidade = capacidade;
+    arena->descartados = 0;
+    arena->emprestado = 0;
+    return 1;
+}
+
+/**
+ * @brief Confere se todo componente aponta para um nome inteiro dentro da arena
+ * (usado ao adotar o bloco de um arquivo, que pode estar corrompido): o nome
+ * termina exatamente em tamanhoNome, sem '\0' no meio, e o prefixo gravado é o
+ * dos bytes da arena (buscas e ordenações decidem pelo prefixo antes do texto).
+ * @return 1 se todos os nomes são válidos, 0 caso contrário.
+ */
+int arenaNomesValidar(const ArenaNomes *arena, const Componente *componentes, size_t total) {
+    for (size_t i = 0; i < total; i++) {
+        uint64_t fim = (uint64_t)componentes[i].deslocamentoNome + componentes[i].tamanhoNome;
+        if (componentes[i].tamanhoNome >= NOME_MAX || fim >= arena->usado || arena->dados[fim] != '\0') return 0;
+        const char *nome = arena->dados + componentes[i].deslocamentoNome;
+        if (memchr(nome, '\0', componentes[i].tamanhoNome) != NULL) return 0;
+        if (componentes[i].prefixoNome != prefixoChave(nome)) return 0;
+    }
+    return 1;
+}
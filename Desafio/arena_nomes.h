@@ -0,0 +1,49 @@
+#ifndef ARENA_NOMES_H
+#define ARENA_NOMES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "componente.h"
+
+// ---------------------------------------------
+// ARENA DE NOMES (Textos de Tamanho Variável)
+// ---------------------------------------------
+// Os nomes ficam um depois do outro em um único bloco: guardar um nome é copiar
+// seus bytes (com o '\0') para o fim do bloco e avançar o ponteiro de uso. O
+// componente guarda só o deslocamento e o tamanho, então o registro fica pequeno
+// e de tamanho fixo e a memória acompanha os bytes realmente usados pelos nomes.
+// Descartar não devolve nada na hora (lápides ainda são comparadas pelo nome):
+// os bytes ficam contados como descartados e voltam na compactação, que copia os
+// nomes dos componentes restantes para um bloco novo e corrige os deslocamentos.
+// O bloco pode começar emprestado (ex.: de um snapshot mapeado em memória); a
+// primeira escrita o copia para o heap.
+// Guardar um nome pode mover o bloco: ponteiros para nomes só valem até a
+// próxima escrita ou compactação da arena.
+
+typedef struct {
+    char *dados;
+    uint32_t usado;          // Bytes ocupados, incluindo os nomes descartados
+    uint32_t capacidade;
+    uint32_t descartados;    // Bytes de nomes descartados (recuperados na compactação)
+    int emprestado;          // 1 = o bloco pertence a outro dono (não é escrito nem liberado)
+} ArenaNomes;
+
+void arenaNomesInicializar(ArenaNomes *arena);
+void arenaNomesAdotar(ArenaNomes *arena, const char *dados, size_t tamanho);
+int arenaNomesTornarPropria(ArenaNomes *arena);
+void arenaNomesLiberar(ArenaNomes *arena);
+int arenaNomesReservar(ArenaNomes *arena, size_t bytes);
+int arenaNomesGuardar(ArenaNomes *arena, const char *texto, size_t tamanho, uint32_t *deslocamento);
+void arenaNomesDescartar(ArenaNomes *arena, const Componente *componente);
+int arenaNomesAtribuir(ArenaNomes *arena, Componente *componente, const char *nome);
+int arenaNomesCompactar(ArenaNomes *arena, Componente *componentes, int total);
+int arenaNomesValidar(const ArenaNomes *arena, const Componente *componentes, size_t total);
+
+/**
+ * @brief Texto do nome de um componente (terminado em '\0', dentro da arena).
+ */
+static inline const char *nomeNaArena(const ArenaNomes *arena, const Componente *componente) {
+    return arena->dados + componente->deslocamentoNome;
+}
+
+#endif
@@ -0,0 +1,191 @@
+#include <string.h>
+#include "busca.h"
+#include "prefixo_chave.h"
+
+/**
+ * @brief Procura, ao redor de uma lápide, um componente vivo com o mesmo nome.
+ * @return Índice do componente vivo, ou -1 se todas as cópias foram descartadas.
+ */
+static int vizinhoVivo(const Componente *componentes, int total, const ArenaNomes *nomes, int posLapide,
+                       long long *comparacoes, long long *desempates) {
+    const Componente *lapide = &componentes[posLapide];
+    const char *nomeLapide = nomeNaArena(nomes, lapide);
+
+    for (int i = posLapide - 1; i >= 0; i--) {
+        if (comparacoes != NULL) (*comparacoes)++;
+        if (compararComPrefixo(componentes[i].prefixoNome, nomeNaArena(nomes, &componentes[i]), lapide->prefixoNome, nomeLapide,
+                               NULL, desempates) != 0) break;
+        if (!COMPONENTE_REMOVIDO(&componentes[i])) return i;
+    }
+    for (int i = posLapide + 1; i < total; i++) {
+        if (comparacoes != NULL) (*comparacoes)++;
+        if (compararComPrefixo(componentes[i].prefixoNome, nomeNaArena(nomes, &componentes[i]), lapide->prefixoNome, nomeLapide,
+                               NULL, desempates) != 0) break;
+        if (!COMPONENTE_REMOVIDO(&componentes[i])) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Busca binária por nome (string) em um vetor ordenado por nome.
+ * Slots descartados (lápides) mantêm o nome na arena, então a ordem continua
+ * válida; se o acerto cair em uma lápide, procura uma cópia viva entre os vizinhos
+ * de mesmo nome.
+ * Cada passo compara primeiro o prefixo de 8 bytes em cache; strcmp só roda no empate.
+ * @param comparacoes Acumula a quantidade de comparações realizadas (pode ser NULL).
+ * @param desempates Acumula quantas delas precisaram de strcmp (pode ser NULL).
+ * @return Índice do componente encontrado, ou -1 se não existir.
+ */
+int buscaBinariaComponentes(const Componente *componentes, int total, const ArenaNomes *nomes, const char *nome,
+                            long long *comparacoes, long long *desempates) {
+    uint64_t prefixo = prefixoChave(nome);
+    int inicio = 0;
+    int fim = total - 1;
+
+    while (inicio <= fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        int resultado = compararComPrefixo(componentes[meio].prefixoNome, nomeNaArena(nomes, &componentes[meio]),
+                                           prefixo, nome, NULL, desempates);
+        if (comparacoes != NULL) (*comparacoes)++;
+
+        if (resultado == 0) {
+            if (!COMPONENTE_REMOVIDO(&componentes[meio])) return meio; // Componente encontrado
+            return vizinhoVivo(componentes, total, nomes, meio, comparacoes, desempates);
+        } else if (resultado < 0) {
+            inicio = meio + 1; // Buscar na metade direita
+        } else {
+            fim = meio - 1; // Buscar na metade esquerda
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Slot que ocupa a posição informada na ordem por nome.
+ */
+static inline int slotNaOrdem(const int *ordem, int posicao) {
+    return ordem != NULL ? ordem[posicao] : posicao;
+}
+
+/**
+ * @brief Primeira posição da ordem cujo nome é maior ou igual (ou, com estrito, maior)
+ * que o informado. Lápides contam como qualquer outro slot.
+ * @return Posição entre 0 e total.
+ */
+static int limiteNaOrdem(const Componente *componentes, const int *ordem, int total, const ArenaNomes *nomes,
+                         const char *nome, int estrito, long long *comparacoes, long long *desempates) {
+    uint64_t prefixo = prefixoChave(nome);
+    int inicio = 0;
+    int fim = total;
+
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        const Componente *c = &componentes[slotNaOrdem(ordem, meio)];
+        if (comparacoes != NULL) (*comparacoes)++;
+        int resultado = compararComPrefixo(c->prefixoNome, nomeNaArena(nomes, c), prefixo, nome, NULL, desempates);
+        if (resultado < 0 || (estrito && resultado == 0)) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/**
+ * @brief Compara só os primeiros "tamanho" bytes do nome com o prefixo buscado
+ * (como strncmp). Com até 8 bytes o prefixo em cache decide sozinho, sem ler a arena.
+ */
+static int compararInicioNome(const Componente *c, const ArenaNomes *nomes, uint64_t chavePrefixo,
+                              const char *prefixo, size_t tamanho, long long *desempates) {
+    if (tamanho < 8) {
+        // Mantém só os "tamanho" bytes mais significativos (a chave é big-endian)
+        uint64_t mascara = tamanho == 0 ? 0 : ~0ULL << (8 * (8 - tamanho));
+        uint64_t a = c->prefixoNome & mascara;
+        return (a > chavePrefixo) - (a < chavePrefixo);
+    }
+    if (c->prefixoNome != chavePrefixo) return (c->prefixoNome > chavePrefixo) - (c->prefixoNome < chavePrefixo);
+    if (desempates != NULL) (*desempates)++;
+    return strncmp(nomeNaArena(nomes, c) + 8, prefixo + 8, tamanho - 8);
+}
+
+/**
+ * @brief Primeira posição cujo nome é maior que o informado (upper bound).
+ * Inserir nessa posição mantém o vetor ordenado e coloca nomes repetidos
+ * depois das cópias já existentes. Lápides contam como qualquer outro slot.
+ * @param comparacoes Acumula a quantidade de comparações realizadas (pode ser NULL).
+ * @param desempates Acumula quantas delas precisaram de strcmp (pode ser NULL).
+ * @return Posição entre 0 e total.
+ */
+int limiteSuperiorComponentes(const Componente *componentes, int total, const ArenaNomes *nomes, const char *nome,
+                              long long *comparacoes, long long *desempates) {
+    return limiteNaOrdem(componentes, NULL, total, nomes, nome, 1, comparacoes, desempates);
+}
+
+/**
+ * @brief Prepara o iterador sobre os nomes que começam com o prefixo informado.
+ * O início é o primeiro nome >= prefixo; o fim, o primeiro cujo começo passa do prefixo.
+ * @param ordem Slots na ordem por nome, ou NULL se o próprio vetor estiver ordenado.
+ * @param total Quantidade de posições na ordem (ou de slots do vetor, com ordem NULL).
+ * @return Quantidade de posições no intervalo (lápides incluídas, se a ordem as tiver).
+ */
+int iteradorNomesPrefixo(IteradorNomes *iterador, const Componente *componentes, const int *ordem, int total,
+                         const ArenaNomes *nomes, const char *prefixo, long long *comparacoes, long long *desempates) {
+    size_t tamanho = strlen(prefixo);
+    uint64_t chavePrefixo = prefixoChave(prefixo);
+    int inicio = limiteNaOrdem(componentes, ordem, total, nomes, prefixo, 0, comparacoes, desempates);
+    int fim = total;
+
+    // Todo nome a partir do início já é >= prefixo: só resta achar o primeiro que não começa com ele
+    int esquerda = inicio;
+    while (esquerda < fim) {
+        int meio = esquerda + (fim - esquerda) / 2;
+        if (comparacoes != NULL) (*comparacoes)++;
+        if (compararInicioNome(&componentes[slotNaOrdem(ordem, meio)], nomes, chavePrefixo, prefixo, tamanho,
+                               desempates) == 0) {
+            esquerda = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+
+    iterador->componentes = componentes;
+    iterador->nomes = nomes;
+    iterador->ordem = ordem;
+    iterador->posicao = inicio;
+    iterador->fim = fim;
+    return fim - inicio;
+}
+
+/**
+ * @brief Prepara o iterador sobre os nomes entre "de" e "ate", inclusive.
+ * Se "de" for maior que "ate", o intervalo fica vazio.
+ * @param ordem Slots na ordem por nome, ou NULL se o próprio vetor estiver ordenado.
+ * @return Quantidade de posições no intervalo (lápides incluídas, se a ordem as tiver).
+ */
+int iteradorNomesFaixa(IteradorNomes *iterador, const Componente *componentes, const int *ordem, int total,
+                       const ArenaNomes *nomes, const char *de, const char *ate,
+                       long long *comparacoes, long long *desempates) {
+    int inicio = limiteNaOrdem(componentes, ordem, total, nomes, de, 0, comparacoes, desempates);
+    int fim = limiteNaOrdem(componentes, ordem, total, nomes, ate, 1, comparacoes, desempates);
+    if (fim < inicio) fim = inicio;
+
+    iterador->componentes = componentes;
+    iterador->nomes = nomes;
+    iterador->ordem = ordem;
+    iterador->posicao = inicio;
+    iterador->fim = fim;
+    return fim - inicio;
+}
+
+/**
+ * @brief Avança o iterador, pulando lápides.
+ * @return Slot do próximo componente em ordem alfabética, ou -1 no fim do intervalo.
+ */
+int iteradorNomesProximo(IteradorNomes *iterador) {
+    while (iterador->posicao < iterador->fim) {
+        int slot = slotNaOrdem(iterador->ordem, iterador->posicao++);
+        if (!COMPONENTE_REMOVIDO(&iterador->componentes[slot])) return slot;
+    }
+    return -1;
+}
@@ -0,0 +1,41 @@
+#ifndef BUSCA_H
+#define BUSCA_H
+
+#include "componente.h"
+#include "arena_nomes.h"
+
+// ---------------------------------------------
+// ROTINAS DE BUSCA SOBRE O VETOR DE COMPONENTES
+// ---------------------------------------------
+
+// "desempates" conta as comparações em que o prefixo em cache empatou e strcmp foi necessário
+int buscaBinariaComponentes(const Componente *componentes, int total, const ArenaNomes *nomes, const char *nome,
+                            long long *comparacoes, long long *desempates);
+int limiteSuperiorComponentes(const Componente *componentes, int total, const ArenaNomes *nomes, const char *nome,
+                              long long *comparacoes, long long *desempates);
+
+// ---------------------------------------------
+// BUSCA POR PREFIXO E POR FAIXA DE NOMES
+// ---------------------------------------------
+// A ordem por nome pode ser o próprio vetor (ordenado por nome) ou uma permutação
+// de slots (visão ordenada). Duas buscas binárias delimitam o intervalo em
+// O(log n) e o iterador devolve os k resultados em ordem alfabética, pulando
+// lápides, sem copiar nada: o total é O(log n + k).
+// O iterador só vale enquanto o vetor, a ordem e a arena não forem alterados.
+
+typedef struct {
+    const Componente *componentes;
+    const ArenaNomes *nomes;
+    const int *ordem;    // Slots na ordem por nome (NULL = o próprio vetor está ordenado)
+    int posicao;         // Próxima posição a visitar na ordem
+    int fim;             // Primeira posição fora do intervalo
+} IteradorNomes;
+
+int iteradorNomesPrefixo(IteradorNomes *iterador, const Componente *componentes, const int *ordem, int total,
+                         const ArenaNomes *nomes, const char *prefixo, long long *comparacoes, long long *desempates);
+int iteradorNomesFaixa(IteradorNomes *iterador, const Componente *componentes, const int *ordem, int total,
+                       const ArenaNomes *nomes, const char *de, const char *ate,
+                       long long *comparacoes, long long *desempates);
+int iteradorNomesProximo(IteradorNomes *iterador);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef COMPONENTE_H
+#define COMPONENTE_H
+
+#include <stdint.h>
+
+// ---------------------------------------------
+// DEFINIÇÕES E ESTRUTURAS COMPARTILHADAS (NÍVEL MESTRE)
+// ---------------------------------------------
+
+// Tamanhos máximos das strings, com o terminador. O nome fica na arena de nomes
+// (só os bytes usados) e o tipo no dicionário de tipos; os limites valem para a
+// entrada e para os buffers de leitura.
+#define NOME_MAX 256
+#define TIPO_MAX 20
+
+// Faixa válida de prioridade de montagem
+#define PRIORIDADE_MIN 1
+#define PRIORIDADE_MAX 10
+// Prioridade fora da faixa válida que marca um slot descartado (lápide)
+#define PRIORIDADE_REMOVIDO 0
+
+// Verdadeiro se o slot apontado foi descartado e aguarda a compactação
+#define COMPONENTE_REMOVIDO(c) ((c)->prioridade == PRIORIDADE_REMOVIDO)
+
+// Estrutura que representa um Componente da Torre de Fuga
+typedef struct {
+    // Primeiros 8 bytes do nome em big-endian (ver prefixo_chave.h): no início do
+    // registro, resolvem a maioria das comparações sem strcmp
+    uint64_t prefixoNome;
+    uint32_t deslocamentoNome; // Nome do componente: posição na arena de nomes (arena_nomes.h)
+    uint16_t tamanhoNome;      // ... e quantidade de bytes, sem o '\0'
+    uint16_t idTipo;           // Tipo internado (controle, suporte...): texto em dicionario_tipos.h
+    int prioridade;            // Prioridade de montagem (1 a 10)
+} Componente;
+
+#endif
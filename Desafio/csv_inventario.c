@@ -0,0 +1,384 @@
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h> // clock_gettime (relógio monotônico)
+#include "csv_inventario.h"
+
+// Capacidade inicial do vetor de registros de cada faixa (cresce dobrando)
+#define REGISTROS_CAPACIDADE_MINIMA 256
+
+// Faixa de linhas de um bloco, analisada por uma tarefa do pool
+typedef struct {
+    char *inicio;              // Começo de uma linha
+    char *fim;                 // Primeiro byte depois da faixa (logo após um '\n')
+    int primeiraDoArquivo;     // A faixa começa na primeira linha do arquivo (cabeçalho possível)
+    const RegrasCsv *regras;
+
+    RegistroCsv *registros;    // Aceitos pela validação (linha = índice dentro da faixa, de 0)
+    int totalRegistros;
+    int capacidadeRegistros;
+    long long linhasFisicas;   // Todas as linhas da faixa, para numerar as faixas seguintes
+    long long linhasDados;
+    long long rejeitados;
+    RejeicaoCsv rejeicoes[CSV_REJEICOES_GUARDADAS];
+    int totalRejeicoes;
+    int semMemoria;
+} FaixaCsv;
+
+static const char *NOMES_MOTIVOS[CSV_TOTAL_MOTIVOS] = { "formato", "nome", "tipo", "valor", "inventario" };
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+static double agoraSegundos() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Guarda a rejeição no resumo (até CSV_REJEICOES_GUARDADAS) e a conta.
+ */
+static void registrarRejeicao(RejeicaoCsv *rejeicoes, int *totalRejeicoes, long long *rejeitados, long long linha,
+                              MotivoRejeicaoCsv motivo) {
+    if (*totalRejeicoes < CSV_REJEICOES_GUARDADAS) {
+        rejeicoes[*totalRejeicoes].linha = linha;
+        rejeicoes[*totalRejeicoes].motivo = motivo;
+        (*totalRejeicoes)++;
+    }
+    (*rejeitados)++;
+}
+
+/**
+ * @brief Lê um campo a partir do cursor e o termina com '\0' no próprio bloco.
+ * Campos entre aspas têm as aspas dobradas reduzidas a uma.
+ * @param fim Fim da linha (o byte nessa posição pode ser sobrescrito).
+ * @param ultimo Recebe 1 se o campo terminou no fim da linha (e não em uma vírgula).
+ * @return O texto do campo, ou NULL se as aspas estiverem malformadas.
+ */
+static char *lerCampo(char **cursor, char *fim, int *ultimo) {
+    char *inicio = *cursor;
+    char *leitura = inicio;
+
+    if (leitura < fim && *leitura == '"') {
+        char *escrita = inicio;
+        leitura++;
+        for (;;) {
+            if (leitura >= fim) return NULL; // Aspas sem fechamento
+            if (*leitura == '"') {
+                if (leitura + 1 < fim && leitura[1] == '"') {
+                    *escrita++ = '"';
+                    leitura += 2;
+                    continue;
+                }
+                leitura++;
+                break;
+            }
+            *escrita++ = *leitura++;
+        }
+        if (leitura < fim && *leitura != ',') return NULL; // Texto depois das aspas de fechamento
+        *ultimo = leitura >= fim;
+        *escrita = '\0';
+        *cursor = leitura + 1;
+        return inicio;
+    }
+
+    while (leitura < fim && *leitura != ',') {
+        if (*leitura == '"') return NULL; // Aspas no meio de um campo sem aspas
+        leitura++;
+    }
+    *ultimo = leitura >= fim;
+    *leitura = '\0';
+    *cursor = leitura + 1;
+    return inicio;
+}
+
+/**
+ * @brief Separa e valida os três campos de uma linha (sem o '\n').
+ * @return -1 se a linha é válida (registro preenchido), ou o motivo da rejeição.
+ */
+static int analisarLinha(char *linha, char *fim, const RegrasCsv *regras, RegistroCsv *registro) {
+    char *campos[3];
+    char *cursor = linha;
+    int ultimo = 0;
+    for (int i = 0; i < 3; i++) {
+        if (ultimo) return CSV_MOTIVO_FORMATO; // Menos de 3 campos
+        campos[i] = lerCampo(&cursor, fim, &ultimo);
+        if (campos[i] == NULL) return CSV_MOTIVO_FORMATO;
+    }
+    if (!ultimo) return CSV_MOTIVO_FORMATO; // Mais de 3 campos
+
+    size_t tamanhoNome = strlen(campos[0]);
+    if (tamanhoNome == 0 || tamanhoNome >= regras->nomeMax) return CSV_MOTIVO_NOME;
+    size_t tamanhoTipo = strlen(campos[1]);
+    if (tamanhoTipo == 0 || tamanhoTipo >= regras->tipoMax) return CSV_MOTIVO_TIPO;
+
+    char *fimNumero;
+    errno = 0;
+    long valor = strtol(campos[2], &fimNumero, 10);
+    if (fimNumero == campos[2] || *fimNumero != '\0' || errno != 0 ||
+        valor < regras->valorMinimo || valor > regras->valorMaximo) {
+        return CSV_MOTIVO_VALOR;
+    }
+
+    registro->nome = campos[0];
+    registro->tipo = campos[1];
+    registro->valor = (int)valor;
+    return -1;
+}
+
+/**
+ * @brief Tarefa do pool: analisa e valida todas as linhas de uma faixa.
+ */
+static void analisarFaixa(void *argumento, int idThread) {
+    (void)idThread;
+    FaixaCsv *faixa = argumento;
+    faixa->totalRegistros = 0;
+    faixa->linhasFisicas = 0;
+    faixa->linhasDados = 0;
+    faixa->rejeitados = 0;
+    faixa->totalRejeicoes = 0;
+    faixa->semMemoria = 0;
+
+    char *linha = faixa->inicio;
+    while (linha < faixa->fim) {
+        char *quebra = memchr(linha, '\n', (size_t)(faixa->fim - linha));
+        long long numero = faixa->linhasFisicas++;
+        char *fimLinha = quebra;
+        if (fimLinha > linha && fimLinha[-1] == '\r') fimLinha--;
+        char *proxima = quebra + 1;
+
+        if (fimLinha == linha) { // Linha vazia
+            linha = proxima;
+            continue;
+        }
+        if (numero == 0 && faixa->primeiraDoArquivo && fimLinha - linha >= 5 && strncmp(linha, "nome,", 5) == 0) {
+            linha = proxima; // Cabeçalho
+            continue;
+        }
+
+        faixa->linhasDados++;
+        if (faixa->totalRegistros == faixa->capacidadeRegistros) {
+            int novaCapacidade = faixa->capacidadeRegistros > 0 ? faixa->capacidadeRegistros * 2 : REGISTROS_CAPACIDADE_MINIMA;
+            RegistroCsv *novos = realloc(faixa->registros, (size_t)novaCapacidade * sizeof(RegistroCsv));
+            if (novos == NULL) {
+                faixa->semMemoria = 1;
+                return;
+            }
+            faixa->registros = novos;
+            faixa->capacidadeRegistros = novaCapacidade;
+        }
+
+        RegistroCsv *registro = &faixa->registros[faixa->totalRegistros];
+        int motivo = analisarLinha(linha, fimLinha, faixa->regras, registro);
+        if (motivo < 0) {
+            registro->linha = numero;
+            faixa->totalRegistros++;
+        } else {
+            registrarRejeicao(faixa->rejeicoes, &faixa->totalRejeicoes, &faixa->rejeitados, numero,
+                              (MotivoRejeicaoCsv)motivo);
+        }
+        linha = proxima;
+    }
+}
+
+/**
+ * @brief Divide o bloco [inicio, fim) em faixas que começam no início de uma linha.
+ * @return Quantidade de faixas não vazias.
+ */
+static int dividirBloco(FaixaCsv *faixas, int maximoFaixas, char *inicio, char *fim, int primeiroBloco) {
+    size_t tamanho = (size_t)(fim - inicio);
+    int total = 0;
+    char *corte = inicio;
+    for (int f = 0; f < maximoFaixas && corte < fim; f++) {
+        char *proximoCorte = fim;
+        if (f < maximoFaixas - 1) {
+            proximoCorte = inicio + tamanho * (size_t)(f + 1) / (size_t)maximoFaixas;
+            if (proximoCorte < corte) proximoCorte = corte;
+            char *quebra = memchr(proximoCorte, '\n', (size_t)(fim - proximoCorte));
+            proximoCorte = quebra != NULL ? quebra + 1 : fim;
+        }
+        faixas[total].inicio = corte;
+        faixas[total].fim = proximoCorte;
+        faixas[total].primeiraDoArquivo = primeiroBloco && corte == inicio;
+        total++;
+        corte = proximoCorte;
+    }
+    return total;
+}
+
+/**
+ * @brief Entrega, em ordem de arquivo, os registros aceitos das faixas e junta as contagens.
+ * @param linhaBase Linhas do arquivo antes deste bloco (avança com as linhas do bloco).
+ */
+static void entregarFaixas(FaixaCsv *faixas, int totalFaixas, long long *linhaBase, AceitarRegistroCsv aceitar,
+                           void *contexto, ResumoImportacaoCsv *resumo) {
+    for (int f = 0; f < totalFaixas; f++) {
+        FaixaCsv *faixa = &faixas[f];
+        // As rejeições da validação e as do inventário são intercaladas por linha
+        int proximaRejeicao = 0;
+        for (int r = 0; r < faixa->totalRegistros; r++) {
+            RegistroCsv *registro = &faixa->registros[r];
+            while (proximaRejeicao < faixa->totalRejeicoes && faixa->rejeicoes[proximaRejeicao].linha < registro->linha) {
+                const RejeicaoCsv *rejeicao = &faixa->rejeicoes[proximaRejeicao++];
+                long long descartados = 0;
+                registrarRejeicao(resumo->primeirasRejeicoes, &resumo->totalRejeicoesGuardadas, &descartados,
+                                  *linhaBase + rejeicao->linha + 1, rejeicao->motivo);
+            }
+            registro->linha += *linhaBase + 1;
+            if (aceitar(contexto, registro)) {
+                resumo->aceitos++;
+            } else {
+                registrarRejeicao(resumo->primeirasRejeicoes, &resumo->totalRejeicoesGuardadas, &resumo->rejeitados,
+                                  registro->linha, CSV_MOTIVO_INVENTARIO);
+            }
+        }
+        while (proximaRejeicao < faixa->totalRejeicoes) {
+            const RejeicaoCsv *rejeicao = &faixa->rejeicoes[proximaRejeicao++];
+            long long descartados = 0;
+            registrarRejeicao(resumo->primeirasRejeicoes, &resumo->totalRejeicoesGuardadas, &descartados,
+                              *linhaBase + rejeicao->linha + 1, rejeicao->motivo);
+        }
+        resumo->linhas += faixa->linhasDados;
+        resumo->rejeitados += faixa->rejeitados;
+        *linhaBase += faixa->linhasFisicas;
+    }
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Importa um arquivo CSV em blocos, validando as linhas em paralelo no pool.
+ * Linhas inválidas são contadas e puladas (as primeiras ficam no resumo com o motivo);
+ * as válidas vão para aceitar() na ordem do arquivo.
+ * @param pool Threads que analisam as faixas de cada bloco (NULL = tudo na thread atual).
+ * @return CSV_OK, CSV_ERRO_ARQUIVO ou CSV_ERRO_MEMORIA (os registros já entregues ficam).
+ */
+int csvImportar(const char *caminho, PoolThreads *pool, const RegrasCsv *regras, AceitarRegistroCsv aceitar,
+                void *contexto, ResumoImportacaoCsv *resumo) {
+    memset(resumo, 0, sizeof(*resumo));
+    double inicio = agoraSegundos();
+    FILE *arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) return CSV_ERRO_ARQUIVO;
+
+    int maximoFaixas = pool != NULL ? pool->totalThreads : 1;
+    FaixaCsv *faixas = calloc((size_t)maximoFaixas, sizeof(FaixaCsv));
+    size_t capacidade = CSV_BLOCO_PADRAO;
+    char *bloco = malloc(capacidade + 1); // +1: '\n' acrescentado à última linha sem quebra
+    if (faixas == NULL || bloco == NULL) {
+        free(faixas);
+        free(bloco);
+        fclose(arquivo);
+        return CSV_ERRO_MEMORIA;
+    }
+    for (int f = 0; f < maximoFaixas; f++) faixas[f].regras = regras;
+
+    int resultado = CSV_OK;
+    size_t usado = 0;           // Bytes no bloco (inclui o resto do bloco anterior)
+    long long linhaBase = 0;
+    int primeiroBloco = 1;
+    int fimArquivo = 0;
+    while (!fimArquivo && resultado == CSV_OK) {
+        size_t lidos = fread(bloco + usado, 1, capacidade - usado, arquivo);
+        usado += lidos;
+        resumo->bytes += (long long)lidos;
+        if (usado < capacidade) {
+            if (ferror(arquivo)) {
+                resultado = CSV_ERRO_ARQUIVO;
+                break;
+            }
+            fimArquivo = 1;
+        }
+
+        // O bloco vai até o último '\n'; o resto passa para o próximo
+        size_t corte;
+        if (fimArquivo) {
+            if (usado == 0) break;
+            if (bloco[usado - 1] != '\n') bloco[usado++] = '\n';
+            corte = usado;
+        } else {
+            char *ultimaQuebra = NULL;
+            for (size_t i = usado; i > 0; i--) {
+                if (bloco[i - 1] == '\n') {
+                    ultimaQuebra = &bloco[i - 1];
+                    break;
+                }
+            }
+            if (ultimaQuebra == NULL) {
+                // Uma linha maior que o bloco: dobra o bloco e continua lendo
+                char *maior = realloc(bloco, capacidade * 2 + 1);
+                if (maior == NULL) {
+                    resultado = CSV_ERRO_MEMORIA;
+                    break;
+                }
+                bloco = maior;
+                capacidade *= 2;
+                continue;
+            }
+            corte = (size_t)(ultimaQuebra - bloco) + 1;
+        }
+
+        int totalFaixas = dividirBloco(faixas, maximoFaixas, bloco, bloco + corte, primeiroBloco);
+        if (pool != NULL && totalFaixas > 1) {
+            poolExecutar(pool, analisarFaixa, faixas, sizeof(FaixaCsv), totalFaixas);
+        } else {
+            for (int f = 0; f < totalFaixas; f++) analisarFaixa(&faixas[f], 0);
+        }
+        for (int f = 0; f < totalFaixas; f++) {
+            if (faixas[f].semMemoria) resultado = CSV_ERRO_MEMORIA;
+        }
+        if (resultado != CSV_OK) break;
+        entregarFaixas(faixas, totalFaixas, &linhaBase, aceitar, contexto, resumo);
+
+        memmove(bloco, bloco + corte, usado - corte);
+        usado -= corte;
+        primeiroBloco = 0;
+    }
+
+    for (int f = 0; f < maximoFaixas; f++) free(faixas[f].registros);
+    free(faixas);
+    free(bloco);
+    fclose(arquivo);
+    resumo->segundos = agoraSegundos() - inicio;
+    return resultado;
+}
+
+/**
+ * @brief Nome curto do motivo de uma rejeição (usado nos relatórios).
+ */
+const char *csvNomeMotivo(MotivoRejeicaoCsv motivo) {
+    return motivo >= 0 && motivo < CSV_TOTAL_MOTIVOS ? NOMES_MOTIVOS[motivo] : "?";
+}
+
+/**
+ * @brief Escreve um campo de texto, entre aspas se tiver vírgula ou aspas.
+ */
+static int escreverCampo(FILE *saida, const char *texto) {
+    if (strpbrk(texto, ",\"") == NULL) return fputs(texto, saida) >= 0;
+    if (fputc('"', saida) == EOF) return 0;
+    for (const char *c = texto; *c != '\0'; c++) {
+        if (*c == '"' && fputc('"', saida) == EOF) return 0;
+        if (fputc(*c, saida) == EOF) return 0;
+    }
+    return fputc('"', saida) != EOF;
+}
+
+/**
+ * @brief Escreve a linha de cabeçalho "nome,tipo,<nomeValor>".
+ * @return 1 em caso de sucesso, 0 em erro de escrita.
+ */
+int csvEscreverCabecalho(FILE *saida, const char *nomeValor) {
+    return fprintf(saida, "nome,tipo,%s\n", nomeValor) > 0;
+}
+
+/**
+ * @brief Escreve um registro "nome,tipo,valor" (o FILE faz o buffer da escrita).
+ * @return 1 em caso de sucesso, 0 em erro de escrita.
+ */
+int csvEscreverRegistro(FILE *saida, const char *nome, const char *tipo, int valor) {
+    return escreverCampo(saida, nome) && fputc(',', saida) != EOF && escreverCampo(saida, tipo) &&
+           fprintf(saida, ",%d\n", valor) > 0;
+}
@@ -0,0 +1,83 @@
+#ifndef CSV_INVENTARIO_H
+#define CSV_INVENTARIO_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "pool_threads.h"
+
+// ---------------------------------------------
+// IMPORTAÇÃO E EXPORTAÇÃO CSV (Leitura em Blocos)
+// ---------------------------------------------
+// Cada linha é um registro "nome,tipo,valor" (o valor é a prioridade no nível
+// Mestre e a quantidade no Aventureiro); uma primeira linha começando por "nome,"
+// é tratada como cabeçalho. O arquivo é lido em blocos de tamanho fixo, cortados
+// no último '\n', então a memória não depende do tamanho do arquivo.
+// Cada bloco é dividido em faixas de linhas que as threads do pool analisam e
+// validam em paralelo, sem copiar os textos: os campos são terminados com '\0'
+// dentro do próprio bloco. Depois, na thread de quem chamou, os registros aceitos
+// de cada faixa são entregues em ordem de arquivo à função que os acrescenta ao
+// inventário (a única etapa sequencial).
+// Campos com vírgula ou aspas vão entre aspas, com aspas internas dobradas
+// (RFC 4180); quebras de linha dentro de um campo não são aceitas.
+
+// Tamanho padrão do bloco lido por vez (cresce se uma única linha não couber)
+#define CSV_BLOCO_PADRAO (1 << 20)
+// Quantidade de linhas rejeitadas guardadas (com número e motivo) para o relatório
+#define CSV_REJEICOES_GUARDADAS 8
+
+// Resultados da importação e da exportação
+#define CSV_OK 0
+#define CSV_ERRO_ARQUIVO -1
+#define CSV_ERRO_MEMORIA -2
+
+typedef enum {
+    CSV_MOTIVO_FORMATO,      // Não tem exatamente 3 campos, ou aspas malformadas
+    CSV_MOTIVO_NOME,         // Nome vazio ou longo demais
+    CSV_MOTIVO_TIPO,         // Tipo vazio ou longo demais
+    CSV_MOTIVO_VALOR,        // Valor não numérico ou fora da faixa
+    CSV_MOTIVO_INVENTARIO,   // Válido, mas recusado pelo inventário (ex.: memória, tipo divergente)
+    CSV_TOTAL_MOTIVOS
+} MotivoRejeicaoCsv;
+
+// Registro validado (os textos apontam para dentro do bloco e só valem durante a entrega)
+typedef struct {
+    const char *nome;
+    const char *tipo;
+    int valor;
+    long long linha;         // Linha no arquivo (a partir de 1)
+} RegistroCsv;
+
+// Regras de validação de cada campo
+typedef struct {
+    size_t nomeMax;          // Tamanho do campo com o '\0' (o nome deve ter menos bytes)
+    size_t tipoMax;
+    int valorMinimo;
+    int valorMaximo;
+} RegrasCsv;
+
+typedef struct {
+    long long linha;
+    MotivoRejeicaoCsv motivo;
+} RejeicaoCsv;
+
+typedef struct {
+    long long linhas;        // Linhas de dados (sem cabeçalho e linhas vazias)
+    long long aceitos;
+    long long rejeitados;
+    long long bytes;
+    double segundos;
+    RejeicaoCsv primeirasRejeicoes[CSV_REJEICOES_GUARDADAS];
+    int totalRejeicoesGuardadas;
+} ResumoImportacaoCsv;
+
+// Acrescenta um registro validado ao inventário; devolve 0 se o inventário o recusar
+typedef int (*AceitarRegistroCsv)(void *contexto, const RegistroCsv *registro);
+
+int csvImportar(const char *caminho, PoolThreads *pool, const RegrasCsv *regras, AceitarRegistroCsv aceitar,
+                void *contexto, ResumoImportacaoCsv *resumo);
+const char *csvNomeMotivo(MotivoRejeicaoCsv motivo);
+
+int csvEscreverCabecalho(FILE *saida, const char *nomeValor);
+int csvEscreverRegistro(FILE *saida, const char *nome, const char *tipo, int valor);
+
+#endif
@@ -0,0 +1,385 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h> // clock_gettime (idade do grupo pendente)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "diario.h"
+
+static const char ASSINATURA[8] = { 'F', 'F', 'D', 'I', 'A', 'R', 'I', 'O' };
+
+// Capacidade inicial do buffer de registros pendentes
+#define PENDENTES_CAPACIDADE_MINIMA 4096
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Relógio monotônico em nanossegundos.
+ */
+static uint64_t agoraNs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief Soma FNV-1a de 32 bits sobre o tamanho, o tipo e os dados de um registro.
+ */
+static uint32_t somaRegistro(uint16_t tamanho, uint8_t tipo, const unsigned char *dados) {
+    uint32_t soma = 2166136261u;
+    const unsigned char cabecalho[3] = { (unsigned char)(tamanho & 0xff), (unsigned char)(tamanho >> 8), tipo };
+    for (int i = 0; i < 3; i++) soma = (soma ^ cabecalho[i]) * 16777619u;
+    for (size_t i = 0; i < tamanho; i++) soma = (soma ^ dados[i]) * 16777619u;
+    return soma;
+}
+
+/**
+ * @brief Escreve todos os bytes (repete em escritas parciais ou interrompidas).
+ */
+static int escreverTudo(int fd, const void *dados, size_t tamanho) {
+    const unsigned char *p = dados;
+    while (tamanho > 0) {
+        ssize_t escritos = write(fd, p, tamanho);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        p += escritos;
+        tamanho -= (size_t)escritos;
+    }
+    return 1;
+}
+
+/**
+ * @brief Cria um diário vazio da geração informada, substituindo o arquivo atual.
+ * Como no snapshot, a gravação vai para um temporário que é renomeado por cima:
+ * uma queda no meio nunca deixa um cabeçalho pela metade.
+ * @return 1 em caso de sucesso, 0 em caso de erro de E/S.
+ */
+static int criarDiarioVazio(const char *caminho, uint32_t geracao) {
+    char temporario[4096];
+    if (snprintf(temporario, sizeof(temporario), "%s.tmp", caminho) >= (int)sizeof(temporario)) return 0;
+
+    CabecalhoDiario cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.assinatura, ASSINATURA, sizeof(ASSINATURA));
+    cabecalho.versao = DIARIO_VERSAO;
+    cabecalho.marcaEndian = DIARIO_MARCA_ENDIAN;
+    cabecalho.geracao = geracao;
+
+    int fd = open(temporario, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return 0;
+    int sucesso = escreverTudo(fd, &cabecalho, sizeof(cabecalho));
+    sucesso = (fsync(fd) == 0) && sucesso;
+    sucesso = (close(fd) == 0) && sucesso;
+
+    if (!sucesso || rename(temporario, caminho) != 0) {
+        remove(temporario);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Grava o grupo pendente com uma escrita e um fdatasync (quem chama segura a trava).
+ * @return 1 em caso de sucesso (ou nada pendente), 0 em caso de erro de E/S.
+ */
+static int confirmarGrupo(Diario *diario) {
+    if (diario->registrosPendentes == 0) return 1;
+
+    int sucesso = escreverTudo(diario->fd, diario->pendentes, diario->tamanhoPendente) &&
+                  fdatasync(diario->fd) == 0;
+    diario->tamanhoPendente = 0;
+    diario->registrosPendentes = 0;
+    if (sucesso) diario->gruposConfirmados++;
+    return sucesso;
+}
+
+/**
+ * @brief Laço da thread confirmadora: espera um grupo, dorme até o prazo dele
+ * (inicioGrupoNs + intervaloNs) e o confirma se ainda estiver pendente.
+ * Uma falha fica marcada em "falhou" e é devolvida na próxima chamada pública.
+ */
+static void *executarConfirmador(void *argumento) {
+    Diario *diario = argumento;
+    pthread_mutex_lock(&diario->trava);
+    while (!diario->encerrar) {
+        if (diario->registrosPendentes == 0 || diario->falhou) {
+            pthread_cond_wait(&diario->novoGrupo, &diario->trava);
+            continue;
+        }
+        uint64_t prazo = diario->inicioGrupoNs + diario->intervaloNs;
+        if (agoraNs() >= prazo) {
+            if (!confirmarGrupo(diario)) diario->falhou = 1;
+            continue;
+        }
+        struct timespec limite = { (time_t)(prazo / 1000000000u), (long)(prazo % 1000000000u) };
+        pthread_cond_timedwait(&diario->novoGrupo, &diario->trava, &limite);
+    }
+    pthread_mutex_unlock(&diario->trava);
+    return NULL;
+}
+
+/**
+ * @brief Cria a trava, a condição (no relógio monotônico, o mesmo de inicioGrupoNs) e a thread.
+ * @return 1 em caso de sucesso, 0 se não foi possível criar a thread.
+ */
+static int iniciarConfirmador(Diario *diario) {
+    pthread_condattr_t atributos;
+    if (pthread_condattr_init(&atributos) != 0) return 0;
+    pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+    int sucesso = pthread_cond_init(&diario->novoGrupo, &atributos) == 0;
+    pthread_condattr_destroy(&atributos);
+    if (!sucesso) return 0;
+    if (pthread_mutex_init(&diario->trava, NULL) != 0) {
+        pthread_cond_destroy(&diario->novoGrupo);
+        return 0;
+    }
+    diario->encerrar = 0;
+    if (pthread_create(&diario->confirmador, NULL, executarConfirmador, diario) != 0) {
+        pthread_mutex_destroy(&diario->trava);
+        pthread_cond_destroy(&diario->novoGrupo);
+        return 0;
+    }
+    diario->confirmadorAtivo = 1;
+    return 1;
+}
+
+/**
+ * @brief Recomeça o arquivo vazio na geração do diário e o abre para acréscimo.
+ */
+static int recomecarArquivo(Diario *diario) {
+    if (diario->fd >= 0) close(diario->fd);
+    diario->fd = -1;
+    if (!criarDiarioVazio(diario->caminho, diario->geracao)) return 0;
+    diario->fd = open(diario->caminho, O_RDWR | O_APPEND);
+    return diario->fd >= 0;
+}
+
+/**
+ * @brief Reaplica os registros válidos do arquivo mapeado.
+ * @return Deslocamento logo após o último registro íntegro.
+ */
+static size_t reaplicarRegistros(const unsigned char *mapa, size_t tamanhoArquivo, FuncaoReaplicar reaplicar,
+                                 void *contexto, ReaplicacaoDiario *resultado) {
+    size_t deslocamento = sizeof(CabecalhoDiario);
+    while (tamanhoArquivo - deslocamento >= sizeof(CabecalhoRegistro)) {
+        CabecalhoRegistro registro;
+        memcpy(&registro, mapa + deslocamento, sizeof(registro)); // Registros não têm alinhamento garantido
+        const unsigned char *dados = mapa + deslocamento + sizeof(registro);
+
+        if (registro.tamanho > DIARIO_DADOS_MAX ||
+            tamanhoArquivo - deslocamento - sizeof(registro) < registro.tamanho ||
+            somaRegistro(registro.tamanho, registro.tipo, dados) != registro.soma) {
+            break; // Escrita rasgada: nada depois deste ponto é confiável
+        }
+
+        if (reaplicar(registro.tipo, dados, registro.tamanho, contexto)) {
+            resultado->reaplicados++;
+        } else {
+            resultado->rejeitados++;
+        }
+        deslocamento += sizeof(registro) + registro.tamanho;
+    }
+    return deslocamento;
+}
+
+/**
+ * @brief Abre (ou cria) o arquivo e reaplica os registros da geração esperada.
+ * @return DIARIO_OK ou DIARIO_ERRO_ES (o diário fica fechado).
+ */
+static int abrirArquivo(Diario *diario, const char *caminho, uint32_t geracaoEsperada, FuncaoReaplicar reaplicar,
+                        void *contexto, ReaplicacaoDiario *resultado) {
+    diario->fd = open(caminho, O_RDWR | O_APPEND);
+    if (diario->fd < 0) {
+        if (errno != ENOENT) return DIARIO_ERRO_ES;
+        return recomecarArquivo(diario) ? DIARIO_OK : DIARIO_ERRO_ES;
+    }
+
+    struct stat info;
+    if (fstat(diario->fd, &info) != 0) {
+        diarioFechar(diario);
+        return DIARIO_ERRO_ES;
+    }
+    size_t tamanhoArquivo = (size_t)info.st_size;
+    if (tamanhoArquivo < sizeof(CabecalhoDiario)) {
+        resultado->bytesDescartados = (long long)tamanhoArquivo;
+        return recomecarArquivo(diario) ? DIARIO_OK : DIARIO_ERRO_ES;
+    }
+
+    const unsigned char *mapa = mmap(NULL, tamanhoArquivo, PROT_READ, MAP_PRIVATE, diario->fd, 0);
+    if (mapa == MAP_FAILED) {
+        diarioFechar(diario);
+        return DIARIO_ERRO_ES;
+    }
+
+    CabecalhoDiario cabecalho;
+    memcpy(&cabecalho, mapa, sizeof(cabecalho));
+    int valido = memcmp(cabecalho.assinatura, ASSINATURA, sizeof(ASSINATURA)) == 0 &&
+                 cabecalho.versao == DIARIO_VERSAO &&
+                 cabecalho.marcaEndian == DIARIO_MARCA_ENDIAN;
+    if (!valido || cabecalho.geracao != geracaoEsperada) {
+        munmap((void *)mapa, tamanhoArquivo);
+        if (valido) {
+            resultado->geracaoDescartada = 1;
+        } else {
+            resultado->bytesDescartados = (long long)tamanhoArquivo;
+        }
+        return recomecarArquivo(diario) ? DIARIO_OK : DIARIO_ERRO_ES;
+    }
+
+    size_t fimValido = reaplicarRegistros(mapa, tamanhoArquivo, reaplicar, contexto, resultado);
+    munmap((void *)mapa, tamanhoArquivo);
+    diario->registrosDesdeCheckpoint = resultado->reaplicados + resultado->rejeitados;
+
+    if (fimValido < tamanhoArquivo) {
+        resultado->bytesDescartados = (long long)(tamanhoArquivo - fimValido);
+        if (ftruncate(diario->fd, (off_t)fimValido) != 0 || fdatasync(diario->fd) != 0) {
+            diarioFechar(diario);
+            return DIARIO_ERRO_ES;
+        }
+    }
+    return DIARIO_OK;
+}
+
+/**
+ * @brief Copia o registro para o grupo pendente (quem chama segura a trava).
+ */
+static int acrescentarRegistro(Diario *diario, uint8_t tipo, const void *dados, size_t tamanho) {
+    size_t necessario = diario->tamanhoPendente + sizeof(CabecalhoRegistro) + tamanho;
+    if (necessario > diario->capacidadePendente) {
+        size_t novaCapacidade = diario->capacidadePendente > 0 ? diario->capacidadePendente : PENDENTES_CAPACIDADE_MINIMA;
+        while (novaCapacidade < necessario) novaCapacidade *= 2;
+        unsigned char *novo = realloc(diario->pendentes, novaCapacidade);
+        if (novo == NULL) return 0;
+        diario->pendentes = novo;
+        diario->capacidadePendente = novaCapacidade;
+    }
+
+    CabecalhoRegistro registro;
+    registro.tamanho = (uint16_t)tamanho;
+    registro.tipo = tipo;
+    registro.reservado = 0;
+    registro.soma = somaRegistro(registro.tamanho, tipo, dados);
+    memcpy(diario->pendentes + diario->tamanhoPendente, &registro, sizeof(registro));
+    if (tamanho > 0) memcpy(diario->pendentes + diario->tamanhoPendente + sizeof(registro), dados, tamanho);
+    diario->tamanhoPendente = necessario;
+
+    uint64_t agora = agoraNs();
+    if (diario->registrosPendentes == 0) {
+        diario->inicioGrupoNs = agora;
+        pthread_cond_signal(&diario->novoGrupo);
+    }
+    diario->registrosPendentes++;
+    diario->registrosDesdeCheckpoint++;
+
+    if (diario->registrosPendentes >= diario->registrosPorGrupo || agora - diario->inicioGrupoNs >= diario->intervaloNs) {
+        return confirmarGrupo(diario);
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Abre (ou cria) o diário, reaplica os registros da geração esperada e
+ * inicia a thread confirmadora.
+ * Arquivos de outra geração já estão contidos no checkpoint e são recomeçados;
+ * uma cauda incompleta é cortada para que os próximos registros fiquem legíveis.
+ * @return DIARIO_OK ou DIARIO_ERRO_ES (o diário fica fechado).
+ */
+int diarioAbrir(Diario *diario, const char *caminho, uint32_t geracaoEsperada, int registrosPorGrupo,
+                uint64_t intervaloNs, FuncaoReaplicar reaplicar, void *contexto, ReaplicacaoDiario *resultado) {
+    memset(diario, 0, sizeof(*diario));
+    memset(resultado, 0, sizeof(*resultado));
+    diario->fd = -1;
+    diario->caminho = caminho;
+    diario->geracao = geracaoEsperada;
+    diario->registrosPorGrupo = registrosPorGrupo > 0 ? registrosPorGrupo : 1;
+    diario->intervaloNs = intervaloNs;
+
+    if (abrirArquivo(diario, caminho, geracaoEsperada, reaplicar, contexto, resultado) != DIARIO_OK) {
+        return DIARIO_ERRO_ES;
+    }
+    if (!iniciarConfirmador(diario)) {
+        diarioFechar(diario);
+        return DIARIO_ERRO_ES;
+    }
+    return DIARIO_OK;
+}
+
+/**
+ * @brief Acrescenta um registro ao grupo pendente e confirma o grupo se ele
+ * encheu ou se o registro mais antigo já esperou o intervalo máximo. O primeiro
+ * registro de um grupo acorda a thread confirmadora, que cumpre o prazo sozinha.
+ * @return 1 em caso de sucesso, 0 em caso de erro (memória ou E/S, inclusive de
+ * uma confirmação anterior feita pela thread).
+ */
+int diarioRegistrar(Diario *diario, uint8_t tipo, const void *dados, size_t tamanho) {
+    if (tamanho > DIARIO_DADOS_MAX) return 0;
+    pthread_mutex_lock(&diario->trava);
+    int sucesso = diario->fd >= 0 && !diario->falhou && acrescentarRegistro(diario, tipo, dados, tamanho);
+    pthread_mutex_unlock(&diario->trava);
+    return sucesso;
+}
+
+/**
+ * @brief Grava agora o grupo pendente com uma escrita e um fdatasync.
+ * @return 1 em caso de sucesso (ou nada pendente), 0 em caso de erro de E/S.
+ */
+int diarioConfirmar(Diario *diario) {
+    pthread_mutex_lock(&diario->trava);
+    int sucesso = diario->fd >= 0 && !diario->falhou && confirmarGrupo(diario);
+    pthread_mutex_unlock(&diario->trava);
+    return sucesso;
+}
+
+/**
+ * @brief Recomeça o diário vazio depois de um checkpoint da geração informada.
+ * Os registros pendentes são descartados: o checkpoint já contém o efeito deles.
+ * @return 1 em caso de sucesso, 0 em caso de erro de E/S (o diário fica fechado).
+ */
+int diarioReiniciar(Diario *diario, uint32_t novaGeracao) {
+    pthread_mutex_lock(&diario->trava);
+    diario->tamanhoPendente = 0;
+    diario->registrosPendentes = 0;
+    diario->registrosDesdeCheckpoint = 0;
+    diario->geracao = novaGeracao;
+    int sucesso = !diario->falhou && recomecarArquivo(diario);
+    pthread_mutex_unlock(&diario->trava);
+    return sucesso;
+}
+
+/**
+ * @brief Encerra a thread confirmadora, confirma o que estiver pendente, fecha o
+ * arquivo e libera o buffer.
+ */
+void diarioFechar(Diario *diario) {
+    if (diario->confirmadorAtivo) {
+        pthread_mutex_lock(&diario->trava);
+        diario->encerrar = 1;
+        pthread_cond_signal(&diario->novoGrupo);
+        pthread_mutex_unlock(&diario->trava);
+        pthread_join(diario->confirmador, NULL);
+        pthread_mutex_destroy(&diario->trava);
+        pthread_cond_destroy(&diario->novoGrupo);
+        diario->confirmadorAtivo = 0;
+    }
+    if (diario->fd >= 0) {
+        if (!diario->falhou) confirmarGrupo(diario);
+        close(diario->fd);
+    }
+    free(diario->pendentes);
+    diario->pendentes = NULL;
+    diario->tamanhoPendente = 0;
+    diario->capacidadePendente = 0;
+    diario->registrosPendentes = 0;
+    diario->fd = -1;
+}
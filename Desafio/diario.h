@@ -0,0 +1,89 @@
+#ifndef DIARIO_H
+#define DIARIO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// ---------------------------------------------
+// DIÁRIO DE OPERAÇÕES (Write-Ahead Log com Commit em Grupo)
+// ---------------------------------------------
+// Arquivo só de acréscimo: um cabeçalho seguido de registros binários curtos
+// (tipo + dados + soma de verificação), um por alteração da mochila.
+// Os registros se acumulam em memória e vão para o disco em grupo: uma única
+// escrita e um único fdatasync para cada lote, quando o lote enche ou quando o
+// registro mais antigo pendente completa o intervalo máximo — assim uma rajada de
+// inserções não paga um fsync por operação. O prazo é cumprido por uma thread
+// confirmadora própria: mesmo que o programa fique parado depois do último
+// registro, o grupo chega ao disco no máximo um intervalo depois.
+// Cada diário pertence a uma geração de checkpoint (snapshot). Ao abrir, os
+// registros da geração esperada são reaplicados; uma cauda incompleta (queda no
+// meio de uma escrita) é descartada. Depois de um checkpoint o diário recomeça vazio.
+
+#define DIARIO_VERSAO 1
+#define DIARIO_MARCA_ENDIAN 0x01020304u
+// Maior bloco de dados de um registro
+#define DIARIO_DADOS_MAX 1024
+
+typedef struct {
+    char assinatura[8];          // "FFDIARIO"
+    uint32_t versao;             // DIARIO_VERSAO
+    uint32_t marcaEndian;        // DIARIO_MARCA_ENDIAN
+    uint32_t geracao;            // Geração do checkpoint sobre o qual os registros se aplicam
+    uint32_t reservado;
+} CabecalhoDiario;
+
+typedef struct {
+    uint16_t tamanho;            // Bytes de dados logo após este cabeçalho
+    uint8_t tipo;                // Definido por quem usa o diário
+    uint8_t reservado;
+    uint32_t soma;               // FNV-1a de tamanho, tipo e dados (detecta escrita rasgada)
+} CabecalhoRegistro;
+
+// Os campos marcados com (T) são protegidos pela trava (a thread confirmadora também os usa)
+typedef struct {
+    int fd;                          // -1 = fechado (T)
+    const char *caminho;
+    uint32_t geracao;
+    unsigned char *pendentes;        // Registros ainda não confirmados no disco (T)
+    size_t tamanhoPendente;          // (T)
+    size_t capacidadePendente;       // (T)
+    int registrosPendentes;          // (T)
+    int registrosPorGrupo;           // Confirma ao juntar este número de registros
+    uint64_t intervaloNs;            // ... ou quando o mais antigo pendente passa desta idade
+    uint64_t inicioGrupoNs;          // (T)
+    long long registrosDesdeCheckpoint;
+    long long gruposConfirmados;     // Quantidade de fdatasync feitos (T)
+    int falhou;                      // 1 = uma confirmação da thread falhou (T)
+
+    // Thread confirmadora: dorme até o prazo do grupo pendente e o confirma
+    pthread_t confirmador;
+    pthread_mutex_t trava;
+    pthread_cond_t novoGrupo;        // Sinalizada quando o primeiro registro de um grupo chega (ou no encerramento)
+    int encerrar;                    // (T)
+    int confirmadorAtivo;            // 1 = thread, trava e condição criadas
+} Diario;
+
+// Resultado da abertura
+typedef struct {
+    long long reaplicados;           // Registros entregues à função de reaplicação
+    long long rejeitados;            // Registros que a função não conseguiu aplicar
+    long long bytesDescartados;      // Cauda incompleta ou corrompida removida do arquivo
+    int geracaoDescartada;           // 1 se o arquivo era de outra geração (e foi recomeçado)
+} ReaplicacaoDiario;
+
+// Aplica um registro durante a abertura; devolve 1 se conseguiu aplicar
+typedef int (*FuncaoReaplicar)(uint8_t tipo, const void *dados, size_t tamanho, void *contexto);
+
+// Resultados de diarioAbrir
+#define DIARIO_OK 0
+#define DIARIO_ERRO_ES 1
+
+int diarioAbrir(Diario *diario, const char *caminho, uint32_t geracaoEsperada, int registrosPorGrupo,
+                uint64_t intervaloNs, FuncaoReaplicar reaplicar, void *contexto, ReaplicacaoDiario *resultado);
+int diarioRegistrar(Diario *diario, uint8_t tipo, const void *dados, size_t tamanho);
+int diarioConfirmar(Diario *diario);
+int diarioReiniciar(Diario *diario, uint32_t novaGeracao);
+void diarioFechar(Diario *diario);
+
+#endif
@@ -0,0 +1,230 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "dicionario_tipos.h"
+
+// Textos em ordem de id (a posição nunca muda depois de internada)
+static char textos[TIPOS_DISTINTOS_MAX][TIPO_MAX];
+// postos[id] = posição do texto na ordem de strcmp; porPosto é o inverso (ids ordenados)
+static unsigned short postos[TIPOS_DISTINTOS_MAX];
+static unsigned short porPosto[TIPOS_DISTINTOS_MAX];
+static int totalTipos = 0;
+static pthread_rwlock_t trava = PTHREAD_RWLOCK_INITIALIZER;
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Busca binária do texto entre os ids ordenados (chamar com a trava).
+ * @param posicao Recebe o posto do texto, ou onde ele entraria se não existir.
+ * @return O id, ou -1 se o texto ainda não foi internado.
+ */
+static int buscarPosto(const char *tipo, int *posicao) {
+    int inicio = 0, fim = totalTipos;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        int comparacao = strcmp(textos[porPosto[meio]], tipo);
+        if (comparacao == 0) {
+            *posicao = meio;
+            return porPosto[meio];
+        }
+        if (comparacao < 0) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    *posicao = inicio;
+    return -1;
+}
+
+/**
+ * @brief Dá o próximo id livre a um texto que ainda não existe e desloca os postos
+ * dos que vêm depois dele (chamar com a trava exclusiva e com vaga no dicionário).
+ * @param posicao Posto do texto, devolvido por buscarPosto.
+ */
+static int internarNovo(const char *tipo, int posicao) {
+    int id = totalTipos;
+    strcpy(textos[id], tipo);
+    memmove(&porPosto[posicao + 1], &porPosto[posicao], (size_t)(totalTipos - posicao) * sizeof(porPosto[0]));
+    porPosto[posicao] = (unsigned short)id;
+    totalTipos++;
+    for (int p = posicao; p < totalTipos; p++) postos[porPosto[p]] = (unsigned short)p;
+    return id;
+}
+
+/**
+ * @brief Retira o último id internado e devolve os postos dos que vinham depois dele
+ * (chamar com a trava exclusiva, antes de o id ter sido entregue a alguém).
+ */
+static void desfazerUltimo(void) {
+    int id = totalTipos - 1;
+    int posicao = postos[id];
+    memmove(&porPosto[posicao], &porPosto[posicao + 1], (size_t)(id - posicao) * sizeof(porPosto[0]));
+    totalTipos--;
+    for (int p = posicao; p < totalTipos; p++) postos[porPosto[p]] = (unsigned short)p;
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Id do tipo, internando o texto se ele ainda não existir.
+ * Um tipo novo recebe o próximo id livre e desloca os postos dos que vêm depois dele.
+ * @return O id (>= 0), ou -1 se o texto for longo demais ou o dicionário estiver cheio.
+ */
+int dicionarioTiposInternar(const char *tipo) {
+    int posicao;
+    pthread_rwlock_rdlock(&trava);
+    int id = buscarPosto(tipo, &posicao);
+    pthread_rwlock_unlock(&trava);
+    if (id >= 0) return id;
+    if (strlen(tipo) >= TIPO_MAX) return -1;
+
+    pthread_rwlock_wrlock(&trava);
+    // Outra thread pode ter internado o mesmo texto entre as duas travas
+    id = buscarPosto(tipo, &posicao);
+    if (id < 0 && totalTipos < TIPOS_DISTINTOS_MAX) id = internarNovo(tipo, posicao);
+    pthread_rwlock_unlock(&trava);
+    return id;
+}
+
+/**
+ * @brief Interna vários textos de uma vez, tudo ou nada, sob uma única trava exclusiva.
+ * Se algum não couber, os que entraram nesta chamada são retirados: um lote recusado
+ * não deixa nenhum tipo no dicionário. Os textos já devem caber em TIPO_MAX.
+ * @param ids Recebe o id de cada texto (na mesma posição).
+ * @return total se todos foram internados; senão a posição do primeiro texto que não coube.
+ */
+int dicionarioTiposInternarLote(const char *const *tipos, int total, int *ids) {
+    pthread_rwlock_wrlock(&trava);
+    int antes = totalTipos;
+    int i = 0;
+    for (; i < total; i++) {
+        int posicao;
+        ids[i] = buscarPosto(tipos[i], &posicao);
+        if (ids[i] >= 0) continue;
+        if (totalTipos == TIPOS_DISTINTOS_MAX) break;
+        ids[i] = internarNovo(tipos[i], posicao);
+    }
+    if (i < total) {
+        while (totalTipos > antes) desfazerUltimo();
+    }
+    pthread_rwlock_unlock(&trava);
+    return i;
+}
+
+/**
+ * @brief Id de um tipo já internado, sem criar nada.
+ * @return O id, ou -1 se nenhum componente usou esse tipo.
+ */
+int dicionarioTiposBuscar(const char *tipo) {
+    int posicao;
+    pthread_rwlock_rdlock(&trava);
+    int id = buscarPosto(tipo, &posicao);
+    pthread_rwlock_unlock(&trava);
+    return id;
+}
+
+/**
+ * @brief Texto de um id devolvido por dicionarioTiposInternar.
+ * Ids fora da tabela (registro corrompido) leem como texto vazio, nunca fora do vetor.
+ */
+const char *dicionarioTiposTexto(int id) {
+    return (unsigned int)id < TIPOS_DISTINTOS_MAX ? textos[id] : "";
+}
+
+/**
+ * @brief Copia os postos atuais de todos os tipos (sob a trava: nunca uma tabela pela metade).
+ * Internar um tipo novo só desloca postos, sem trocar a ordem relativa dos que já
+ * existiam; por isso uma cópia continua ordenando corretamente os componentes dela.
+ */
+void dicionarioTiposCopiarPostos(PostosTipos *destino) {
+    pthread_rwlock_rdlock(&trava);
+    destino->total = totalTipos;
+    memcpy(destino->postos, postos, (size_t)totalTipos * sizeof(postos[0]));
+    pthread_rwlock_unlock(&trava);
+}
+
+/**
+ * @brief Quantidade de tipos internados (os postos vão de 0 a total - 1).
+ */
+int dicionarioTiposTotal(void) {
+    pthread_rwlock_rdlock(&trava);
+    int total = totalTipos;
+    pthread_rwlock_unlock(&trava);
+    return total;
+}
+
+/**
+ * @brief Copia os textos dos ids informados para um bloco novo, na ordem do vetor e
+ * cada um com '\0': o i-ésimo texto do bloco é o id ids[i]. Gravado junto dos
+ * registros (renumerados pela posição em ids), o bloco permite traduzi-los na carga.
+ * @param tamanho Recebe o tamanho do bloco em bytes.
+ * @return O bloco (liberar com free), ou NULL se não houver memória.
+ */
+char *dicionarioTiposSerializar(const uint16_t *ids, int total, size_t *tamanho) {
+    char *bloco = malloc((size_t)total * TIPO_MAX + 1);
+    size_t usado = 0;
+    if (bloco != NULL) {
+        for (int i = 0; i < total; i++) {
+            const char *texto = dicionarioTiposTexto(ids[i]);
+            size_t comprimento = strlen(texto) + 1;
+            memcpy(bloco + usado, texto, comprimento);
+            usado += comprimento;
+        }
+    }
+    *tamanho = usado;
+    return bloco;
+}
+
+/**
+ * @brief Confere um bloco serializado sem internar nada: cada texto termina em '\0'
+ * dentro do bloco e cabe em TIPO_MAX.
+ * @return Quantidade de tipos do bloco, ou -1 se ele for inválido ou tiver mais de "maximo" textos.
+ */
+int dicionarioTiposContarBloco(const char *bloco, size_t tamanho, int maximo) {
+    int total = 0;
+    size_t posicao = 0;
+    while (posicao < tamanho) {
+        const char *texto = bloco + posicao;
+        const char *fim = memchr(texto, '\0', tamanho - posicao);
+        if (fim == NULL || total == maximo || (size_t)(fim - texto) >= TIPO_MAX) return -1;
+        total++;
+        posicao += (size_t)(fim - texto) + 1;
+    }
+    return total;
+}
+
+/**
+ * @brief Interna os textos de um bloco serializado e informa o id atual de cada um.
+ * Tudo ou nada: o bloco é conferido antes e, sob uma única trava exclusiva, só é
+ * internado se todos os textos novos couberem; um bloco recusado não deixa nenhum
+ * tipo no dicionário. Com o dicionário vazio (início do programa) os ids saem iguais aos do bloco.
+ * @param novosIds Recebe, na posição do id antigo, o id neste processo.
+ * @return Quantidade de tipos do bloco, ou -1 se o bloco for inválido ou não couber.
+ */
+int dicionarioTiposImportar(const char *bloco, size_t tamanho, uint16_t *novosIds, int maximo) {
+    int total = dicionarioTiposContarBloco(bloco, tamanho, maximo);
+    if (total < 0) return -1;
+
+    pthread_rwlock_wrlock(&trava);
+    // Textos repetidos no bloco contam duas vezes: a conta só pode sobrar vaga
+    int novos = 0, posto;
+    for (size_t posicao = 0; posicao < tamanho; posicao += strlen(bloco + posicao) + 1) {
+        if (buscarPosto(bloco + posicao, &posto) < 0) novos++;
+    }
+    if (totalTipos + novos > TIPOS_DISTINTOS_MAX) {
+        pthread_rwlock_unlock(&trava);
+        return -1;
+    }
+    int k = 0;
+    for (size_t posicao = 0; posicao < tamanho; posicao += strlen(bloco + posicao) + 1) {
+        int id = buscarPosto(bloco + posicao, &posto);
+        novosIds[k++] = (uint16_t)(id >= 0 ? id : internarNovo(bloco + posicao, posto));
+    }
+    pthread_rwlock_unlock(&trava);
+    return total;
+}
@@ -0,0 +1,59 @@
+#ifndef DICIONARIO_TIPOS_H
+#define DICIONARIO_TIPOS_H
+
+#include <stddef.h>
+#include "componente.h"
+
+// ---------------------------------------------
+// DICIONÁRIO DE TIPOS (Textos Internados)
+// ---------------------------------------------
+// Os jogadores usam poucos tipos distintos ("arma", "cura", "municao"...), então
+// cada texto é guardado uma única vez e o componente guarda só o id dele (2 bytes).
+// Os ids nunca mudam (o vetor da mochila e os snapshots continuam válidos); ao lado
+// de cada id fica o posto do texto na ordem de strcmp, recalculado quando um tipo
+// novo entra. Ordenar ou agrupar por tipo vira comparar inteiros — ou um Counting
+// Sort sobre os postos, com só dicionarioTiposTotal() baldes.
+// O dicionário é único no processo (todos os inventários dividem os ids, ver
+// inventario.h) e a internação é protegida por uma trava de leitura/escrita;
+// textos e ids já entregues podem ser lidos sem trava. Os postos mudam sempre que
+// um tipo novo entra, então quem ordena não os lê direto: copia todos de uma vez
+// (dicionarioTiposCopiarPostos, sob a trava) no início da ordenação e usa só a
+// cópia, mesmo que outra thread interne tipos no meio.
+
+// Tipos distintos suportados (o id cabe no uint16_t do componente)
+#define TIPOS_DISTINTOS_MAX 1024
+
+// Postos de todos os tipos em um instante (cópia de quem ordena por tipo)
+typedef struct {
+    unsigned short postos[TIPOS_DISTINTOS_MAX];   // postos[id], válido para id < total
+    int total;
+} PostosTipos;
+
+int dicionarioTiposInternar(const char *tipo);
+int dicionarioTiposInternarLote(const char *const *tipos, int total, int *ids);
+int dicionarioTiposBuscar(const char *tipo);
+const char *dicionarioTiposTexto(int id);
+void dicionarioTiposCopiarPostos(PostosTipos *destino);
+int dicionarioTiposTotal(void);
+
+// Persistência: os textos dos ids escolhidos, cada um terminado por '\0'
+char *dicionarioTiposSerializar(const uint16_t *ids, int total, size_t *tamanho);
+int dicionarioTiposContarBloco(const char *bloco, size_t tamanho, int maximo);
+int dicionarioTiposImportar(const char *bloco, size_t tamanho, uint16_t *novosIds, int maximo);
+
+/**
+ * @brief Posto do tipo na ordem alfabética (0 = primeiro) segundo a cópia: é a chave de ordenação por tipo.
+ * Ids fora da cópia (registro corrompido) ficam no posto 0.
+ */
+static inline unsigned int postoDoTipo(const PostosTipos *postos, int id) {
+    return (unsigned int)id < (unsigned int)postos->total ? postos->postos[id] : 0u;
+}
+
+/**
+ * @brief Texto do tipo de um componente.
+ */
+static inline const char *tipoDoComponente(const Componente *componente) {
+    return dicionarioTiposTexto(componente->idTipo);
+}
+
+#endif
@@ -0,0 +1,238 @@
+#include <stdlib.h>
+#include "heap_prioridade.h"
+
+// Capacidade inicial do heap e do mapa de posições
+#define HEAP_CAPACIDADE_MINIMA 16
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Verdadeiro se o slot a deve ficar acima do slot b no heap.
+ */
+static int vemAntes(const Componente *componentes, int a, int b) {
+    if (componentes[a].prioridade != componentes[b].prioridade) {
+        return componentes[a].prioridade > componentes[b].prioridade;
+    }
+    return a < b;
+}
+
+/**
+ * @brief Garante espaço para mais uma entrada no heap (dobra a capacidade).
+ */
+static int garantirEspacoHeap(HeapPrioridade *heap) {
+    if (heap->tamanho < heap->capacidade) return 1;
+
+    int novaCapacidade = heap->capacidade > 0 ? heap->capacidade * 2 : HEAP_CAPACIDADE_MINIMA;
+    int *novo = realloc(heap->slots, (size_t)novaCapacidade * sizeof(int));
+    if (novo == NULL) return 0;
+    heap->slots = novo;
+    heap->capacidade = novaCapacidade;
+    return 1;
+}
+
+/**
+ * @brief Garante que o mapa de posições cubra o slot informado (novas posições = -1).
+ */
+static int garantirPosicao(HeapPrioridade *heap, int slot) {
+    if (slot < heap->capacidadePosicao) return 1;
+
+    int novaCapacidade = heap->capacidadePosicao > 0 ? heap->capacidadePosicao : HEAP_CAPACIDADE_MINIMA;
+    while (novaCapacidade <= slot) novaCapacidade *= 2;
+    int *novo = realloc(heap->posicao, (size_t)novaCapacidade * sizeof(int));
+    if (novo == NULL) return 0;
+    for (int s = heap->capacidadePosicao; s < novaCapacidade; s++) novo[s] = -1;
+    heap->posicao = novo;
+    heap->capacidadePosicao = novaCapacidade;
+    return 1;
+}
+
+/**
+ * @brief Coloca o slot no índice i do heap, mantendo o mapa de posições.
+ */
+static void colocar(HeapPrioridade *heap, int i, int slot) {
+    heap->slots[i] = slot;
+    heap->posicao[slot] = i;
+}
+
+/**
+ * @brief Sobe a entrada do índice i enquanto ela vier antes do pai.
+ * @return O índice final da entrada.
+ */
+static int subir(HeapPrioridade *heap, const Componente *componentes, int i) {
+    int slot = heap->slots[i];
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (!vemAntes(componentes, slot, heap->slots[pai])) break;
+        colocar(heap, i, heap->slots[pai]);
+        i = pai;
+    }
+    colocar(heap, i, slot);
+    return i;
+}
+
+/**
+ * @brief Desce a entrada do índice i enquanto algum filho vier antes dela.
+ */
+static void descer(HeapPrioridade *heap, const Componente *componentes, int i) {
+    int slot = heap->slots[i];
+    for (;;) {
+        int filho = 2 * i + 1;
+        if (filho >= heap->tamanho) break;
+        if (filho + 1 < heap->tamanho && vemAntes(componentes, heap->slots[filho + 1], heap->slots[filho])) filho++;
+        if (!vemAntes(componentes, heap->slots[filho], slot)) break;
+        colocar(heap, i, heap->slots[filho]);
+        i = filho;
+    }
+    colocar(heap, i, slot);
+}
+
+/**
+ * @brief Restaura a propriedade do heap no índice i (a entrada pode ter subido ou descido).
+ */
+static void reposicionar(HeapPrioridade *heap, const Componente *componentes, int i) {
+    if (subir(heap, componentes, i) == i) descer(heap, componentes, i);
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Cria um heap vazio (a memória é alocada sob demanda).
+ */
+void heapPrioridadeInicializar(HeapPrioridade *heap) {
+    heap->slots = NULL;
+    heap->tamanho = 0;
+    heap->capacidade = 0;
+    heap->posicao = NULL;
+    heap->capacidadePosicao = 0;
+}
+
+/**
+ * @brief Libera a memória do heap.
+ */
+void heapPrioridadeLiberar(HeapPrioridade *heap) {
+    free(heap->slots);
+    free(heap->posicao);
+    heapPrioridadeInicializar(heap);
+}
+
+/**
+ * @brief Recria o heap com os slots vivos 0..totalSlots-1 em O(n) (heapify de baixo para cima).
+ * Necessário após operações que movem componentes de slot (ordenação, compactação).
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int heapPrioridadeReconstruir(HeapPrioridade *heap, const Componente *componentes, int totalSlots) {
+    for (int s = 0; s < heap->capacidadePosicao; s++) heap->posicao[s] = -1;
+    heap->tamanho = 0;
+    if (totalSlots > 0 && !garantirPosicao(heap, totalSlots - 1)) return 0;
+
+    for (int slot = 0; slot < totalSlots; slot++) {
+        if (COMPONENTE_REMOVIDO(&componentes[slot])) continue;
+        if (!garantirEspacoHeap(heap)) return 0;
+        colocar(heap, heap->tamanho++, slot);
+    }
+    for (int i = heap->tamanho / 2 - 1; i >= 0; i--) descer(heap, componentes, i);
+    return 1;
+}
+
+/**
+ * @brief Acrescenta um componente recém-adicionado ao heap em O(log n).
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int heapPrioridadeInserir(HeapPrioridade *heap, const Componente *componentes, int slot) {
+    if (!garantirEspacoHeap(heap) || !garantirPosicao(heap, slot)) return 0;
+    colocar(heap, heap->tamanho++, slot);
+    subir(heap, componentes, heap->tamanho - 1);
+    return 1;
+}
+
+/**
+ * @brief Tira um slot do heap em O(log n): a última entrada ocupa o lugar dele e é reposicionada.
+ * Remover o slot do topo equivale a extrair o máximo. Slots fora do heap são ignorados.
+ */
+void heapPrioridadeRemover(HeapPrioridade *heap, const Componente *componentes, int slot) {
+    if (slot < 0 || slot >= heap->capacidadePosicao || heap->posicao[slot] < 0) return;
+
+    int i = heap->posicao[slot];
+    heap->posicao[slot] = -1;
+    heap->tamanho--;
+    if (i == heap->tamanho) return;
+
+    colocar(heap, i, heap->slots[heap->tamanho]);
+    reposicionar(heap, componentes, i);
+}
+
+/**
+ * @brief Reposiciona um slot cuja prioridade acabou de mudar, em O(log n).
+ */
+void heapPrioridadeAtualizar(HeapPrioridade *heap, const Componente *componentes, int slot) {
+    if (slot < 0 || slot >= heap->capacidadePosicao || heap->posicao[slot] < 0) return;
+    reposicionar(heap, componentes, heap->posicao[slot]);
+}
+
+/**
+ * @brief Slot do componente mais importante, em O(1).
+ * @return O slot, ou -1 se o heap estiver vazio.
+ */
+int heapPrioridadeTopo(const HeapPrioridade *heap) {
+    return heap->tamanho > 0 ? heap->slots[0] : -1;
+}
+
+/**
+ * @brief Copia para destino os k slots mais importantes, em ordem, sem alterar o heap.
+ * Um heap auxiliar de candidatos (índices do heap principal) começa com a raiz;
+ * cada candidato retirado libera os dois filhos, então o custo é O(k log k).
+ * @return Quantidade de slots copiados, ou -1 se não houver memória.
+ */
+int heapPrioridadeMaiores(const HeapPrioridade *heap, const Componente *componentes, int k, int *destino) {
+    if (k > heap->tamanho) k = heap->tamanho;
+    if (k <= 0) return 0;
+
+    // Cada retirada acrescenta no máximo um candidato líquido: k + 1 posições bastam
+    int *candidatos = malloc((size_t)(k + 1) * sizeof(int));
+    if (candidatos == NULL) return -1;
+    int totalCandidatos = 1;
+    candidatos[0] = 0;
+
+    int copiados = 0;
+    while (copiados < k) {
+        int melhor = candidatos[0];
+        destino[copiados++] = heap->slots[melhor];
+
+        // Retira o melhor candidato (o último sobe para a raiz e desce)
+        int ultimo = candidatos[--totalCandidatos];
+        int filhos[2] = { 2 * melhor + 1, 2 * melhor + 2 };
+        int i = 0;
+        if (totalCandidatos > 0) {
+            for (;;) {
+                int f = 2 * i + 1;
+                if (f >= totalCandidatos) break;
+                if (f + 1 < totalCandidatos &&
+                    vemAntes(componentes, heap->slots[candidatos[f + 1]], heap->slots[candidatos[f]])) f++;
+                if (!vemAntes(componentes, heap->slots[candidatos[f]], heap->slots[ultimo])) break;
+                candidatos[i] = candidatos[f];
+                i = f;
+            }
+            candidatos[i] = ultimo;
+        }
+
+        // Os filhos do retirado viram candidatos (desnecessário depois do último)
+        for (int c = 0; c < 2 && copiados < k; c++) {
+            if (filhos[c] >= heap->tamanho) continue;
+            int j = totalCandidatos++;
+            while (j > 0) {
+                int pai = (j - 1) / 2;
+                if (!vemAntes(componentes, heap->slots[filhos[c]], heap->slots[candidatos[pai]])) break;
+                candidatos[j] = candidatos[pai];
+                j = pai;
+            }
+            candidatos[j] = filhos[c];
+        }
+    }
+
+    free(candidatos);
+    return copiados;
+}
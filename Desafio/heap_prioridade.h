@@ -0,0 +1,35 @@
+#ifndef HEAP_PRIORIDADE_H
+#define HEAP_PRIORIDADE_H
+
+#include "componente.h"
+
+// ---------------------------------------------
+// FILA DE MONTAGEM (Heap Máximo Indexado por Slot)
+// ---------------------------------------------
+// Heap binário com os slots dos componentes vivos, do mais importante para o
+// menos importante: maior prioridade primeiro e, no empate, o menor slot.
+// O vetor "posicao" guarda onde cada slot está no heap, então descartar ou mudar
+// a prioridade de um componente qualquer custa O(log n), sem procurar por ele.
+// O topo sai em O(1) e os k primeiros em O(k log k), sem ordenar a mochila.
+// Operações que mudam componentes de slot exigem heapPrioridadeReconstruir (O(n)).
+
+typedef struct {
+    int *slots;            // Slots em ordem de heap (slots[0] é o topo)
+    int tamanho;
+    int capacidade;
+    int *posicao;          // posicao[slot] = índice no heap, ou -1 se o slot não está no heap
+    int capacidadePosicao;
+} HeapPrioridade;
+
+void heapPrioridadeInicializar(HeapPrioridade *heap);
+void heapPrioridadeLiberar(HeapPrioridade *heap);
+
+int heapPrioridadeReconstruir(HeapPrioridade *heap, const Componente *componentes, int totalSlots);
+int heapPrioridadeInserir(HeapPrioridade *heap, const Componente *componentes, int slot);
+void heapPrioridadeRemover(HeapPrioridade *heap, const Componente *componentes, int slot);
+void heapPrioridadeAtualizar(HeapPrioridade *heap, const Componente *componentes, int slot);
+
+int heapPrioridadeTopo(const HeapPrioridade *heap);
+int heapPrioridadeMaiores(const HeapPrioridade *heap, const Componente *componentes, int k, int *destino);
+
+#endif
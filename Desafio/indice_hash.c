@@ -0,0 +1,215 @@
+#include <stdlib.h>
+#include <string.h>
+#include "indice_hash.h"
+
+// Capacidade mínima da tabela (potência de 2)
+#define INDICE_CAPACIDADE_MINIMA 16
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Menor potência de 2 maior ou igual a n (respeitando o mínimo da tabela).
+ */
+static int proximaPotenciaDe2(int n) {
+    int capacidade = INDICE_CAPACIDADE_MINIMA;
+    while (capacidade < n) capacidade *= 2;
+    return capacidade;
+}
+
+/**
+ * @brief Aloca uma tabela vazia com a capacidade informada.
+ */
+static int alocarTabela(IndiceHash *indice, int capacidade) {
+    int *slots = malloc((size_t)capacidade * sizeof(int));
+    unsigned int *hashes = malloc((size_t)capacidade * sizeof(unsigned int));
+    if (slots == NULL || hashes == NULL) {
+        free(slots);
+        free(hashes);
+        return 0;
+    }
+    for (int i = 0; i < capacidade; i++) slots[i] = INDICE_SLOT_VAZIO;
+
+    indice->slots = slots;
+    indice->hashes = hashes;
+    indice->capacidade = capacidade;
+    indice->ocupados = 0;
+    indice->removidos = 0;
+    return 1;
+}
+
+/**
+ * @brief Coloca uma entrada na primeira posição livre da sondagem linear.
+ * Não verifica carga: quem chama garante que há espaço.
+ */
+static void colocarEntrada(IndiceHash *indice, unsigned int hash, int slot) {
+    unsigned int mascara = (unsigned int)indice->capacidade - 1;
+    unsigned int pos = hash & mascara;
+
+    while (indice->slots[pos] >= 0) {
+        pos = (pos + 1) & mascara;
+    }
+    if (indice->slots[pos] == INDICE_SLOT_REMOVIDO) indice->removidos--;
+    indice->slots[pos] = slot;
+    indice->hashes[pos] = hash;
+    indice->ocupados++;
+}
+
+/**
+ * @brief Realoca a tabela para a nova capacidade, descartando as lápides.
+ * Reaproveita os hashes já calculados (nenhuma chave é relida).
+ */
+static int redimensionarTabela(IndiceHash *indice, int novaCapacidade) {
+    IndiceHash antigo = *indice;
+    if (!alocarTabela(indice, novaCapacidade)) {
+        *indice = antigo;
+        return 0;
+    }
+    for (int i = 0; i < antigo.capacidade; i++) {
+        if (antigo.slots[i] >= 0) colocarEntrada(indice, antigo.hashes[i], antigo.slots[i]);
+    }
+    free(antigo.slots);
+    free(antigo.hashes);
+    return 1;
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Hash FNV-1a de 32 bits para strings.
+ */
+unsigned int hashTexto(const char *texto) {
+    unsigned int hash = 2166136261u;
+    while (*texto) {
+        hash ^= (unsigned char)*texto++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Cria um índice vazio.
+ * @param capacidadeInicial Quantidade de entradas esperada (a tabela é dimensionada com folga).
+ * @param obterChave Função que devolve o nome guardado em um slot do vetor.
+ * @param contexto Ponteiro repassado para obterChave (pode ser NULL).
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int indiceHashInicializar(IndiceHash *indice, int capacidadeInicial, ObterChaveSlot obterChave, const void *contexto) {
+    indice->obterChave = obterChave;
+    indice->contexto = contexto;
+    return alocarTabela(indice, proximaPotenciaDe2(capacidadeInicial * 2));
+}
+
+/**
+ * @brief Libera a memória do índice.
+ */
+void indiceHashLiberar(IndiceHash *indice) {
+    free(indice->slots);
+    free(indice->hashes);
+    indice->slots = NULL;
+    indice->hashes = NULL;
+    indice->capacidade = 0;
+    indice->ocupados = 0;
+    indice->removidos = 0;
+}
+
+/**
+ * @brief Registra que o slot informado guarda a chave informada.
+ * A tabela cresce quando a carga (entradas + lápides) passa de 70%.
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int indiceHashInserir(IndiceHash *indice, const char *chave, int slot) {
+    if ((indice->ocupados + indice->removidos + 1) * 10 > indice->capacidade * 7) {
+        // Se a maior parte da carga for lápide, basta limpar; senão a tabela dobra
+        int novaCapacidade = proximaPotenciaDe2((indice->ocupados + 1) * 2);
+        if (novaCapacidade < indice->capacidade) novaCapacidade = indice->capacidade;
+        if (!redimensionarTabela(indice, novaCapacidade)) return 0;
+    }
+    colocarEntrada(indice, hashTexto(chave), slot);
+    return 1;
+}
+
+/**
+ * @brief Busca exata por nome em O(1) esperado.
+ * @return O menor slot que guarda a chave, ou -1 se não existir.
+ */
+int indiceHashBuscar(const IndiceHash *indice, const char *chave) {
+    unsigned int hash = hashTexto(chave);
+    unsigned int mascara = (unsigned int)indice->capacidade - 1;
+    unsigned int pos = hash & mascara;
+    int encontrado = -1;
+
+    // A sondagem só termina em uma posição VAZIA (lápides não interrompem)
+    while (indice->slots[pos] != INDICE_SLOT_VAZIO) {
+        int slot = indice->slots[pos];
+        if (slot >= 0 && indice->hashes[pos] == hash &&
+            (encontrado == -1 || slot < encontrado) &&
+            strcmp(indice->obterChave(indice->contexto, slot), chave) == 0) {
+            encontrado = slot;
+        }
+        pos = (pos + 1) & mascara;
+    }
+    return encontrado;
+}
+
+/**
+ * @brief Remove a entrada (chave, slot) do índice, deixando uma lápide.
+ * @return 1 se a entrada existia, 0 caso contrário.
+ */
+int indiceHashRemover(IndiceHash *indice, const char *chave, int slot) {
+    unsigned int hash = hashTexto(chave);
+    unsigned int mascara = (unsigned int)indice->capacidade - 1;
+    unsigned int pos = hash & mascara;
+
+    while (indice->slots[pos] != INDICE_SLOT_VAZIO) {
+        if (indice->slots[pos] == slot && indice->hashes[pos] == hash) {
+            indice->slots[pos] = INDICE_SLOT_REMOVIDO;
+            indice->ocupados--;
+            indice->removidos++;
+            return 1;
+        }
+        pos = (pos + 1) & mascara;
+    }
+    return 0;
+}
+
+/**
+ * @brief Soma delta a todos os slots >= aPartirDe.
+ * Usado quando o vetor desloca elementos (ex: inserção ordenada no meio do vetor).
+ * Percorre a tabela inteira (O(capacidade)), mas só de inteiros, sem nenhuma
+ * comparação de strings.
+ */
+void indiceHashDeslocarSlots(IndiceHash *indice, int aPartirDe, int delta) {
+    for (int i = 0; i < indice->capacidade; i++) {
+        if (indice->slots[i] >= aPartirDe) indice->slots[i] += delta;
+    }
+}
+
+/**
+ * @brief Recria o índice a partir dos slots 0..totalSlots-1 do vetor.
+ * Necessário após operações que reordenam o vetor inteiro (ordenações, compactação).
+ * Slots cuja chave é NULL (vagos) não entram no índice.
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int indiceHashReconstruir(IndiceHash *indice, int totalSlots) {
+    int capacidade = proximaPotenciaDe2(totalSlots * 2);
+    if (capacidade != indice->capacidade) {
+        IndiceHash novo = *indice;
+        if (!alocarTabela(&novo, capacidade)) return 0;
+        indiceHashLiberar(indice);
+        *indice = novo;
+    } else {
+        for (int i = 0; i < indice->capacidade; i++) indice->slots[i] = INDICE_SLOT_VAZIO;
+        indice->ocupados = 0;
+        indice->removidos = 0;
+    }
+
+    for (int slot = 0; slot < totalSlots; slot++) {
+        const char *chave = indice->obterChave(indice->contexto, slot);
+        if (chave != NULL) colocarEntrada(indice, hashTexto(chave), slot);
+    }
+    return 1;
+}
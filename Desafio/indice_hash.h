@@ -0,0 +1,44 @@
+#ifndef INDICE_HASH_H
+#define INDICE_HASH_H
+
+// ---------------------------------------------
+// ÍNDICE HASH POR NOME (Endereçamento Aberto)
+// ---------------------------------------------
+// Mapeia o nome de um item para o slot que ele ocupa no vetor da mochila.
+// A tabela não copia os nomes: ela guarda apenas o slot e o hash, e consulta
+// a chave no próprio vetor através de uma função de acesso. Assim o índice
+// continua válido mesmo quando o vetor é realocado.
+// Nomes repetidos são permitidos; a busca devolve o menor slot com aquele nome
+// (mesmo resultado da busca sequencial original).
+
+// Marcadores de posição da tabela
+#define INDICE_SLOT_VAZIO -1
+#define INDICE_SLOT_REMOVIDO -2
+
+// Função que devolve a chave (nome) armazenada em um slot do vetor indexado.
+// Pode devolver NULL para slots vagos (lápides do vetor), que ficam fora do índice.
+typedef const char *(*ObterChaveSlot)(const void *contexto, int slot);
+
+typedef struct {
+    int *slots;               // Slot do vetor em cada posição da tabela (ou marcador)
+    unsigned int *hashes;     // Hash completo de cada entrada (evita strcmp em colisões)
+    int capacidade;           // Tamanho da tabela, sempre potência de 2
+    int ocupados;             // Entradas válidas
+    int removidos;            // Posições marcadas como REMOVIDO (lápides)
+    ObterChaveSlot obterChave;
+    const void *contexto;
+} IndiceHash;
+
+unsigned int hashTexto(const char *texto);
+
+int indiceHashInicializar(IndiceHash *indice, int capacidadeInicial, ObterChaveSlot obterChave, const void *contexto);
+void indiceHashLiberar(IndiceHash *indice);
+
+int indiceHashInserir(IndiceHash *indice, const char *chave, int slot);
+int indiceHashBuscar(const IndiceHash *indice, const char *chave);
+int indiceHashRemover(IndiceHash *indice, const char *chave, int slot);
+
+void indiceHashDeslocarSlots(IndiceHash *indice, int aPartirDe, int delta);
+int indiceHashReconstruir(IndiceHash *indice, int totalSlots);
+
+#endif
@@ -0,0 +1,136 @@
+#include <stdlib.h>
+#include "indice_prioridade.h"
+
+// Capacidade inicial de um balde quando recebe o primeiro slot
+#define BALDE_CAPACIDADE_MINIMA 8
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Garante espaço para mais uma entrada no balde (dobra a capacidade).
+ */
+static int garantirEspacoBalde(IndicePrioridade *indice, int prioridade) {
+    if (indice->tamanho[prioridade] < indice->capacidade[prioridade]) return 1;
+
+    int novaCapacidade = indice->capacidade[prioridade] > 0 ? indice->capacidade[prioridade] * 2 : BALDE_CAPACIDADE_MINIMA;
+    int *novo = realloc(indice->slots[prioridade], (size_t)novaCapacidade * sizeof(int));
+    if (novo == NULL) return 0;
+    indice->slots[prioridade] = novo;
+    indice->capacidade[prioridade] = novaCapacidade;
+    return 1;
+}
+
+/**
+ * @brief Verdadeiro se a entrada do balde ainda aponta para um componente daquela prioridade.
+ */
+static int entradaValida(const Componente *componentes, int slot, int prioridade) {
+    return componentes[slot].prioridade == prioridade;
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Cria um índice vazio (os baldes são alocados sob demanda).
+ */
+void indicePrioridadeInicializar(IndicePrioridade *indice) {
+    for (int p = 0; p <= PRIORIDADE_MAX; p++) {
+        indice->slots[p] = NULL;
+        indice->tamanho[p] = 0;
+        indice->capacidade[p] = 0;
+        indice->vivos[p] = 0;
+    }
+}
+
+/**
+ * @brief Libera a memória de todos os baldes.
+ */
+void indicePrioridadeLiberar(IndicePrioridade *indice) {
+    for (int p = 0; p <= PRIORIDADE_MAX; p++) free(indice->slots[p]);
+    indicePrioridadeInicializar(indice);
+}
+
+/**
+ * @brief Registra um componente recém-adicionado no fim do balde da sua prioridade.
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int indicePrioridadeInserir(IndicePrioridade *indice, int prioridade, int slot) {
+    if (prioridade < PRIORIDADE_MIN || prioridade > PRIORIDADE_MAX) return 0;
+    if (!garantirEspacoBalde(indice, prioridade)) return 0;
+    indice->slots[prioridade][indice->tamanho[prioridade]++] = slot;
+    indice->vivos[prioridade]++;
+    return 1;
+}
+
+/**
+ * @brief Contabiliza o descarte de um componente da prioridade informada em O(1).
+ */
+void indicePrioridadeRemover(IndicePrioridade *indice, int prioridade) {
+    if (prioridade < PRIORIDADE_MIN || prioridade > PRIORIDADE_MAX) return;
+    if (indice->vivos[prioridade] > 0) indice->vivos[prioridade]--;
+}
+
+/**
+ * @brief Recria todos os baldes a partir dos slots 0..totalSlots-1 (lápides ficam de fora).
+ * Necessário após operações que movem componentes de slot (ordenação, compactação).
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int indicePrioridadeReconstruir(IndicePrioridade *indice, const Componente *componentes, int totalSlots) {
+    for (int p = 0; p <= PRIORIDADE_MAX; p++) {
+        indice->tamanho[p] = 0;
+        indice->vivos[p] = 0;
+    }
+    for (int slot = 0; slot < totalSlots; slot++) {
+        if (COMPONENTE_REMOVIDO(&componentes[slot])) continue;
+        if (!indicePrioridadeInserir(indice, componentes[slot].prioridade, slot)) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Quantidade de componentes com prioridade >= prioridadeMinima, em O(PRIORIDADE_MAX).
+ */
+int indicePrioridadeContar(const IndicePrioridade *indice, int prioridadeMinima) {
+    if (prioridadeMinima < PRIORIDADE_MIN) prioridadeMinima = PRIORIDADE_MIN;
+    int total = 0;
+    for (int p = prioridadeMinima; p <= PRIORIDADE_MAX; p++) total += indice->vivos[p];
+    return total;
+}
+
+/**
+ * @brief Slot do componente de maior prioridade (o de menor slot em caso de empate).
+ * @return O slot, ou -1 se a mochila estiver vazia.
+ */
+int indicePrioridadeMaior(const IndicePrioridade *indice, const Componente *componentes) {
+    for (int p = PRIORIDADE_MAX; p >= PRIORIDADE_MIN; p--) {
+        if (indice->vivos[p] == 0) continue;
+        for (int i = 0; i < indice->tamanho[p]; i++) {
+            int slot = indice->slots[p][i];
+            if (entradaValida(componentes, slot, p)) return slot;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Copia para destino os slots com prioridade >= prioridadeMinima,
+ * da maior para a menor prioridade (e por slot dentro de cada prioridade).
+ * @param maximo Tamanho do vetor destino.
+ * @return Quantidade de slots copiados.
+ */
+int indicePrioridadeListar(const IndicePrioridade *indice, const Componente *componentes,
+                           int prioridadeMinima, int *destino, int maximo) {
+    if (prioridadeMinima < PRIORIDADE_MIN) prioridadeMinima = PRIORIDADE_MIN;
+    int copiados = 0;
+
+    for (int p = PRIORIDADE_MAX; p >= prioridadeMinima && copiados < maximo; p--) {
+        for (int i = 0; i < indice->tamanho[p] && copiados < maximo; i++) {
+            int slot = indice->slots[p][i];
+            if (entradaValida(componentes, slot, p)) destino[copiados++] = slot;
+        }
+    }
+    return copiados;
+}
@@ -0,0 +1,35 @@
+#ifndef INDICE_PRIORIDADE_H
+#define INDICE_PRIORIDADE_H
+
+#include "componente.h"
+
+// ---------------------------------------------
+// ÍNDICE POR PRIORIDADE (Baldes 1..10)
+// ---------------------------------------------
+// Como a prioridade só assume PRIORIDADE_MAX valores, cada valor ganha um balde
+// com os slots dos componentes daquela prioridade, em ordem de slot.
+// Consultas como "prioridade >= 8" ou "componente mais importante" percorrem
+// apenas os baldes envolvidos, sem tocar no resto da mochila.
+// Descartes só decrementam o contador do balde: o slot antigo continua na lista
+// e é ignorado nas consultas (a lápide tem prioridade 0), até a próxima reconstrução.
+
+typedef struct {
+    int *slots[PRIORIDADE_MAX + 1];      // Slots de cada prioridade (posição 0 não usada)
+    int tamanho[PRIORIDADE_MAX + 1];     // Entradas em cada balde (inclui slots já descartados)
+    int capacidade[PRIORIDADE_MAX + 1];  // Espaço alocado em cada balde
+    int vivos[PRIORIDADE_MAX + 1];       // Componentes vivos de cada prioridade
+} IndicePrioridade;
+
+void indicePrioridadeInicializar(IndicePrioridade *indice);
+void indicePrioridadeLiberar(IndicePrioridade *indice);
+
+int indicePrioridadeInserir(IndicePrioridade *indice, int prioridade, int slot);
+void indicePrioridadeRemover(IndicePrioridade *indice, int prioridade);
+int indicePrioridadeReconstruir(IndicePrioridade *indice, const Componente *componentes, int totalSlots);
+
+int indicePrioridadeContar(const IndicePrioridade *indice, int prioridadeMinima);
+int indicePrioridadeMaior(const IndicePrioridade *indice, const Componente *componentes);
+int indicePrioridadeListar(const IndicePrioridade *indice, const Componente *componentes,
+                           int prioridadeMinima, int *destino, int maximo);
+
+#endif
@@ -0,0 +1,191 @@
+#include <stdlib.h>
+#include <string.h>
+#include "indice_tipo.h"
+
+// Capacidades iniciais (poucos tipos distintos; grupos crescem dobrando)
+#define GRUPOS_CAPACIDADE_MINIMA 8
+#define MEMBROS_CAPACIDADE_MINIMA 8
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Função de acesso do índice hash interno: o "slot" é a posição do grupo.
+ */
+static const char *obterTipoGrupo(const void *contexto, int posicao) {
+    return ((const IndiceTipo *)contexto)->grupos[posicao].tipo;
+}
+
+/**
+ * @brief Localiza o grupo do tipo, criando-o se ainda não existir.
+ * @return Posição do grupo, ou -1 se não houver memória.
+ */
+static int obterOuCriarGrupo(IndiceTipo *indice, const char *tipo) {
+    int posicao = indiceHashBuscar(&indice->porTipo, tipo);
+    if (posicao >= 0) return posicao;
+
+    if (indice->totalGrupos == indice->capacidadeGrupos) {
+        int novaCapacidade = indice->capacidadeGrupos > 0 ? indice->capacidadeGrupos * 2 : GRUPOS_CAPACIDADE_MINIMA;
+        GrupoTipo *novos = realloc(indice->grupos, (size_t)novaCapacidade * sizeof(GrupoTipo));
+        if (novos == NULL) return -1;
+        indice->grupos = novos;
+        indice->capacidadeGrupos = novaCapacidade;
+    }
+
+    GrupoTipo *grupo = &indice->grupos[indice->totalGrupos];
+    grupo->tipo = malloc(strlen(tipo) + 1);
+    if (grupo->tipo == NULL) return -1;
+    strcpy(grupo->tipo, tipo);
+    grupo->slots = NULL;
+    grupo->tamanho = 0;
+    grupo->capacidade = 0;
+    grupo->vivos = 0;
+    grupo->quantidadeTotal = 0;
+
+    posicao = indice->totalGrupos;
+    if (!indiceHashInserir(&indice->porTipo, grupo->tipo, posicao)) {
+        free(grupo->tipo);
+        return -1;
+    }
+    indice->totalGrupos++;
+    return posicao;
+}
+
+/**
+ * @brief Verdadeiro se o slot ainda guarda um membro vivo do grupo.
+ */
+static int membroValido(const IndiceTipo *indice, const GrupoTipo *grupo, int slot) {
+    const char *tipoAtual = indice->obterTipo(indice->contexto, slot);
+    return tipoAtual != NULL && strcmp(tipoAtual, grupo->tipo) == 0;
+}
+
+/**
+ * @brief Libera todos os grupos e recria a tabela de tipos vazia.
+ */
+static int limparGrupos(IndiceTipo *indice) {
+    for (int g = 0; g < indice->totalGrupos; g++) {
+        free(indice->grupos[g].tipo);
+        free(indice->grupos[g].slots);
+    }
+    indice->totalGrupos = 0;
+    return indiceHashReconstruir(&indice->porTipo, 0);
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Cria um índice sem grupos.
+ * @param obterTipo Devolve o tipo de um slot do vetor (NULL para slots descartados).
+ * @param obterQuantidade Devolve a quantidade de um slot (NULL = 1 por slot).
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int indiceTipoInicializar(IndiceTipo *indice, ObterChaveSlot obterTipo, ObterQuantidadeSlot obterQuantidade,
+                          const void *contexto) {
+    indice->grupos = NULL;
+    indice->totalGrupos = 0;
+    indice->capacidadeGrupos = 0;
+    indice->obterTipo = obterTipo;
+    indice->obterQuantidade = obterQuantidade;
+    indice->contexto = contexto;
+    return indiceHashInicializar(&indice->porTipo, GRUPOS_CAPACIDADE_MINIMA, obterTipoGrupo, indice);
+}
+
+/**
+ * @brief Libera a memória do índice.
+ */
+void indiceTipoLiberar(IndiceTipo *indice) {
+    for (int g = 0; g < indice->totalGrupos; g++) {
+        free(indice->grupos[g].tipo);
+        free(indice->grupos[g].slots);
+    }
+    free(indice->grupos);
+    indice->grupos = NULL;
+    indice->totalGrupos = 0;
+    indice->capacidadeGrupos = 0;
+    indiceHashLiberar(&indice->porTipo);
+}
+
+/**
+ * @brief Registra um membro recém-adicionado no fim do grupo do seu tipo.
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int indiceTipoInserir(IndiceTipo *indice, const char *tipo, int slot, int quantidade) {
+    int posicao = obterOuCriarGrupo(indice, tipo);
+    if (posicao < 0) return 0;
+
+    GrupoTipo *grupo = &indice->grupos[posicao];
+    if (grupo->tamanho == grupo->capacidade) {
+        int novaCapacidade = grupo->capacidade > 0 ? grupo->capacidade * 2 : MEMBROS_CAPACIDADE_MINIMA;
+        int *novos = realloc(grupo->slots, (size_t)novaCapacidade * sizeof(int));
+        if (novos == NULL) return 0;
+        grupo->slots = novos;
+        grupo->capacidade = novaCapacidade;
+    }
+    grupo->slots[grupo->tamanho++] = slot;
+    grupo->vivos++;
+    grupo->quantidadeTotal += quantidade;
+    return 1;
+}
+
+/**
+ * @brief Contabiliza o descarte de um membro do tipo informado em O(1).
+ */
+void indiceTipoRemover(IndiceTipo *indice, const char *tipo, int quantidade) {
+    int posicao = indiceHashBuscar(&indice->porTipo, tipo);
+    if (posicao < 0) return;
+    indice->grupos[posicao].vivos--;
+    indice->grupos[posicao].quantidadeTotal -= quantidade;
+}
+
+/**
+ * @brief Soma unidades a um membro que já está no grupo (item empilhado) em O(1).
+ */
+void indiceTipoSomarQuantidade(IndiceTipo *indice, const char *tipo, int quantidade) {
+    int posicao = indiceHashBuscar(&indice->porTipo, tipo);
+    if (posicao < 0) return;
+    indice->grupos[posicao].quantidadeTotal += quantidade;
+}
+
+/**
+ * @brief Recria os grupos a partir dos slots 0..totalSlots-1 (slots descartados ficam de fora).
+ * Necessário após operações que movem membros de slot (ordenação, compactação).
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int indiceTipoReconstruir(IndiceTipo *indice, int totalSlots) {
+    if (!limparGrupos(indice)) return 0;
+    for (int slot = 0; slot < totalSlots; slot++) {
+        const char *tipo = indice->obterTipo(indice->contexto, slot);
+        if (tipo == NULL) continue;
+        int quantidade = indice->obterQuantidade != NULL ? indice->obterQuantidade(indice->contexto, slot) : 1;
+        if (!indiceTipoInserir(indice, tipo, slot, quantidade)) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Grupo do tipo informado (contagem e quantidade total em O(1) esperado).
+ * @return O grupo, ou NULL se nenhum membro desse tipo foi registrado.
+ */
+const GrupoTipo *indiceTipoBuscar(const IndiceTipo *indice, const char *tipo) {
+    int posicao = indiceHashBuscar(&indice->porTipo, tipo);
+    return posicao >= 0 ? &indice->grupos[posicao] : NULL;
+}
+
+/**
+ * @brief Copia para destino os slots vivos do tipo informado, em ordem de slot.
+ * @param maximo Tamanho do vetor destino.
+ * @return Quantidade de slots copiados.
+ */
+int indiceTipoListar(const IndiceTipo *indice, const char *tipo, int *destino, int maximo) {
+    const GrupoTipo *grupo = indiceTipoBuscar(indice, tipo);
+    if (grupo == NULL) return 0;
+
+    int copiados = 0;
+    for (int i = 0; i < grupo->tamanho && copiados < maximo; i++) {
+        if (membroValido(indice, grupo, grupo->slots[i])) destino[copiados++] = grupo->slots[i];
+    }
+    return copiados;
+}
@@ -0,0 +1,51 @@
+#ifndef INDICE_TIPO_H
+#define INDICE_TIPO_H
+
+#include "indice_hash.h"
+
+// ---------------------------------------------
+// ÍNDICE SECUNDÁRIO POR TIPO (Agrupamento)
+// ---------------------------------------------
+// Cada tipo distinto ("controle", "cura"...) vira um grupo com os slots dos seus
+// membros (em ordem de slot), a quantidade de membros vivos e a soma das quantidades.
+// O grupo de um tipo é localizado pelo índice hash, então "listar os controles" ou
+// "total de munição" custam apenas o tamanho do resultado, sem reordenar o vetor.
+// Como no índice de prioridades, um descarte só atualiza os totais do grupo: o slot
+// antigo é filtrado nas consultas (o acesso devolve NULL para lápides) até a
+// próxima reconstrução.
+
+// Função que devolve a quantidade guardada em um slot (NULL = cada slot vale 1)
+typedef int (*ObterQuantidadeSlot)(const void *contexto, int slot);
+
+typedef struct {
+    char *tipo;                 // Cópia do texto do tipo
+    int *slots;                 // Slots dos membros (inclui descartados ainda não filtrados)
+    int tamanho;
+    int capacidade;
+    int vivos;                  // Membros vivos
+    long long quantidadeTotal;  // Soma das quantidades dos membros vivos
+} GrupoTipo;
+
+typedef struct {
+    GrupoTipo *grupos;
+    int totalGrupos;
+    int capacidadeGrupos;
+    IndiceHash porTipo;                 // Tipo -> posição em grupos
+    ObterChaveSlot obterTipo;           // Tipo guardado em um slot do vetor (NULL = lápide)
+    ObterQuantidadeSlot obterQuantidade;
+    const void *contexto;               // Repassado às duas funções de acesso
+} IndiceTipo;
+
+int indiceTipoInicializar(IndiceTipo *indice, ObterChaveSlot obterTipo, ObterQuantidadeSlot obterQuantidade,
+                          const void *contexto);
+void indiceTipoLiberar(IndiceTipo *indice);
+
+int indiceTipoInserir(IndiceTipo *indice, const char *tipo, int slot, int quantidade);
+void indiceTipoRemover(IndiceTipo *indice, const char *tipo, int quantidade);
+void indiceTipoSomarQuantidade(IndiceTipo *indice, const char *tipo, int quantidade);
+int indiceTipoReconstruir(IndiceTipo *indice, int totalSlots);
+
+const GrupoTipo *indiceTipoBuscar(const IndiceTipo *indice, const char *tipo);
+int indiceTipoListar(const IndiceTipo *indice, const char *tipo, int *destino, int maximo);
+
+#endif
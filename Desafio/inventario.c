@@ -0,0 +1,1105 @@
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "inventario.h"
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Relógio monotônico em nanossegundos (duração da compactação).
+ */
+static uint64_t agoraNs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief Funções de acesso usadas pelos índices para ler nome, tipo e valor de um slot.
+ * O contexto é o próprio inventário.
+ */
+static const char *nomeDoSlot(const void *contexto, int slot) {
+    const Inventario *inventario = contexto;
+    return inventarioSlotVivo(inventario, slot) ? inventarioNome(inventario, slot) : NULL;
+}
+
+static const char *tipoDoSlot(const void *contexto, int slot) {
+    const Inventario *inventario = contexto;
+    return inventarioSlotVivo(inventario, slot) ? inventarioTipo(inventario, slot) : NULL;
+}
+
+static int valorDoSlot(const void *contexto, int slot) {
+    return inventarioValor(contexto, slot);
+}
+
+/**
+ * @brief Quanto um componente soma no grupo do seu tipo: o valor, se ele for uma
+ * quantidade (empilhar), ou 1.
+ */
+static int pesoNoTipo(const Inventario *inventario, int valor) {
+    return inventario->configuracao.empilhar ? valor : 1;
+}
+
+/**
+ * @brief Realoca o vetor para a capacidade informada.
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+static int redimensionar(Inventario *inventario, int novaCapacidade) {
+    if (inventario->emSnapshot) {
+        // Primeira realocação após a carga: os registros saem do mapeamento para o heap
+        Componente *copia = malloc((size_t)novaCapacidade * sizeof(Componente));
+        if (copia == NULL) return 0;
+        int preservados = inventario->slotsUsados < novaCapacidade ? inventario->slotsUsados : novaCapacidade;
+        // Os nomes também estão no mapeamento e precisam sair antes de ele ser fechado
+        if (!arenaNomesTornarPropria(&inventario->nomes)) {
+            free(copia);
+            return 0;
+        }
+        memcpy(copia, inventario->componentes, (size_t)preservados * sizeof(Componente));
+        fecharSnapshot(&inventario->snapshot);
+        inventario->emSnapshot = 0;
+        inventario->componentes = copia;
+        inventario->capacidade = novaCapacidade;
+        return 1;
+    }
+
+    Componente *novo = realloc(inventario->componentes, (size_t)novaCapacidade * sizeof(Componente));
+    if (novo == NULL) return 0;
+    inventario->componentes = novo;
+    inventario->capacidade = novaCapacidade;
+    return 1;
+}
+
+/**
+ * @brief Garante ao menos um slot livre no fim do vetor (a capacidade dobra a cada
+ * crescimento, o que torna o append O(1) amortizado).
+ */
+static int garantirEspaco(Inventario *inventario) {
+    if (inventario->slotsUsados < inventario->capacidade) return 1;
+    int novaCapacidade = inventario->capacidade > 0 ? inventario->capacidade * 2
+                                                     : inventario->configuracao.reservaInicial;
+    return redimensionar(inventario, novaCapacidade);
+}
+
+/**
+ * @brief Se a ocupação cair para 1/4 ou menos, reduz a capacidade pela metade (nunca
+ * abaixo da reserva inicial). Usar 1/4 (e não 1/2) evita realocações em sequência
+ * alternando adições e descartes.
+ */
+static void encolher(Inventario *inventario) {
+    int reserva = inventario->configuracao.reservaInicial;
+    if (inventario->emSnapshot) return; // Ainda no mapeamento do snapshot: nada a devolver ao heap
+    if (inventario->capacidade <= reserva) return;
+    if (inventario->slotsUsados > inventario->capacidade / 4) return;
+
+    int novaCapacidade = inventario->capacidade / 2;
+    if (novaCapacidade < reserva) novaCapacidade = reserva;
+    redimensionar(inventario, novaCapacidade); // Se falhar, o bloco antigo continua válido
+}
+
+/**
+ * @brief Marca os índices para reconstrução após uma reordenação completa.
+ * As visões ordenadas também deixam de valer, pois guardam slots.
+ */
+static void reindexar(Inventario *inventario) {
+    inventario->indiceNomesPendente = 1;
+    inventario->indicePrioridadesPendente = 1;
+    inventario->indiceTiposPendente = 1;
+    inventario->filaMontagemPendente = 1;
+    inventario->versao++;
+}
+
+/**
+ * @brief Reconstroem um índice pendente. Sem indicesPorValor, os baldes e a fila de
+ * montagem nunca são montados (continuam pendentes para sempre).
+ * @return 1 se o índice está pronto para uso, 0 se faltou memória (ou ele está desligado).
+ */
+static int garantirIndiceNomes(Inventario *inventario) {
+    if (!inventario->indiceNomesPendente) return 1;
+    if (!indiceHashReconstruir(&inventario->indiceNomes, inventario->slotsUsados)) return 0;
+    inventario->indiceNomesPendente = 0;
+    return 1;
+}
+
+static int garantirIndicePrioridades(Inventario *inventario) {
+    if (!inventario->indicePrioridadesPendente) return 1;
+    if (!inventario->configuracao.indicesPorValor ||
+        !indicePrioridadeReconstruir(&inventario->indicePrioridades, inventario->componentes, inventario->slotsUsados)) {
+        return 0;
+    }
+    inventario->indicePrioridadesPendente = 0;
+    return 1;
+}
+
+static int garantirIndiceTipos(Inventario *inventario) {
+    if (!inventario->indiceTiposPendente) return 1;
+    if (!indiceTipoReconstruir(&inventario->indiceTipos, inventario->slotsUsados)) return 0;
+    inventario->indiceTiposPendente = 0;
+    return 1;
+}
+
+static int garantirFilaMontagem(Inventario *inventario) {
+    if (!inventario->filaMontagemPendente) return 1;
+    if (!inventario->configuracao.indicesPorValor ||
+        !heapPrioridadeReconstruir(&inventario->filaMontagem, inventario->componentes, inventario->slotsUsados)) {
+        return 0;
+    }
+    inventario->filaMontagemPendente = 0;
+    return 1;
+}
+
+/**
+ * @brief Confere nome, tipo e valor de um componente antes de ele entrar no inventário.
+ * @return INVENTARIO_OK, INVENTARIO_ERRO_VALOR ou INVENTARIO_ERRO_NOME_INVALIDO.
+ */
+static int validarComponente(const Inventario *inventario, const char *nome, const char *tipo, int valor) {
+    const ConfiguracaoInventario *configuracao = &inventario->configuracao;
+    if (valor < configuracao->valorMinimo || valor > configuracao->valorMaximo) return INVENTARIO_ERRO_VALOR;
+    if (nome[0] == '\0' || strlen(nome) >= configuracao->nomeMax || strlen(tipo) >= TIPO_MAX) {
+        return INVENTARIO_ERRO_NOME_INVALIDO;
+    }
+    return INVENTARIO_OK;
+}
+
+/**
+ * @brief Escolhe o slot de um novo nome no modo sempre ordenado.
+ * A posição vem de uma busca binária (O(log n)). Se o vizinho for uma lápide, ela é
+ * reaproveitada sem mover nada e a inserção fica em O(log n). Senão o final do vetor
+ * anda uma posição (memmove) e o índice de nomes soma 1 a cada slot deslocado, o que
+ * percorre a tabela inteira: a inserção custa O(n + capacidade do índice), com
+ * constantes pequenas (cópia de memória e inteiros, sem comparar nomes).
+ * @return O slot reservado (já contado em slotsUsados) ou INVENTARIO_ERRO_MEMORIA.
+ */
+static int reservarSlotOrdenado(Inventario *inventario, const char *nome) {
+    Componente *componentes = inventario->componentes;
+    int pos = limiteSuperiorComponentes(componentes, inventario->slotsUsados, &inventario->nomes, nome, NULL, NULL);
+
+    // Uma lápide vizinha tem nome entre os vizinhos vivos: ocupar o lugar dela mantém a ordem
+    if (pos > 0 && COMPONENTE_REMOVIDO(&componentes[pos - 1])) return pos - 1;
+    if (pos < inventario->slotsUsados && COMPONENTE_REMOVIDO(&componentes[pos])) return pos;
+
+    if (!garantirEspaco(inventario)) return INVENTARIO_ERRO_MEMORIA;
+    componentes = inventario->componentes;
+    memmove(&componentes[pos + 1], &componentes[pos], (size_t)(inventario->slotsUsados - pos) * sizeof(Componente));
+    inventario->contadores.movimentacoes += inventario->slotsUsados - pos;
+    // Os componentes deslocados passam a ocupar o slot seguinte
+    if (!inventario->indiceNomesPendente) indiceHashDeslocarSlots(&inventario->indiceNomes, pos, 1);
+    inventario->slotsUsados++;
+    return pos;
+}
+
+/**
+ * @brief Ocupa um slot novo com um componente já validado e de tipo já internado.
+ * No modo sempre ordenado ele vai para a posição ordenada por nome; nos demais, para o fim.
+ * O nome não pode apontar para dentro da arena (guardá-lo pode mover a arena).
+ * @return O slot ocupado ou INVENTARIO_ERRO_MEMORIA.
+ */
+static int inserirNovo(Inventario *inventario, const char *nome, int idTipo, int valor) {
+    // O nome vai para a arena antes do slot ser reservado: uma falha aqui não deixa slot vazio
+    Componente novo;
+    if (!arenaNomesAtribuir(&inventario->nomes, &novo, nome)) return INVENTARIO_ERRO_MEMORIA;
+    novo.idTipo = (uint16_t)idTipo;
+    novo.prioridade = valor;
+
+    int slot;
+    if (inventario->modoSempreOrdenado) {
+        slot = reservarSlotOrdenado(inventario, nome);
+        if (slot < 0) {
+            arenaNomesDescartar(&inventario->nomes, &novo);
+            return slot;
+        }
+        inventario->indicePrioridadesPendente = 1; // Os slots seguintes podem ter mudado
+        inventario->indiceTiposPendente = 1;
+        inventario->filaMontagemPendente = 1;
+    } else {
+        if (!garantirEspaco(inventario)) {
+            arenaNomesDescartar(&inventario->nomes, &novo);
+            return INVENTARIO_ERRO_MEMORIA;
+        }
+        slot = inventario->slotsUsados++;
+        inventario->statusOrdenacao = 0;
+    }
+
+    Componente *componente = &inventario->componentes[slot];
+    *componente = novo;
+    inventario->totalComponentes++;
+    inventario->versao++;
+
+    // Com o índice pendente, o novo slot entra na próxima reconstrução
+    if (!inventario->indiceNomesPendente && !indiceHashInserir(&inventario->indiceNomes, nome, slot)) {
+        inventario->indiceNomesPendente = 1;
+    }
+    if (!inventario->indicePrioridadesPendente &&
+        !indicePrioridadeInserir(&inventario->indicePrioridades, valor, slot)) {
+        inventario->indicePrioridadesPendente = 1;
+    }
+    if (!inventario->indiceTiposPendente &&
+        !indiceTipoInserir(&inventario->indiceTipos, tipoDoComponente(componente), slot, pesoNoTipo(inventario, valor))) {
+        inventario->indiceTiposPendente = 1;
+    }
+    if (!inventario->filaMontagemPendente &&
+        !heapPrioridadeInserir(&inventario->filaMontagem, inventario->componentes, slot)) {
+        inventario->filaMontagemPendente = 1;
+    }
+    return slot;
+}
+
+/**
+ * @brief Confere se um valor pode ser somado ao componente de um slot (empilhar).
+ * @return INVENTARIO_OK, INVENTARIO_ERRO_TIPO_DIVERGENTE ou INVENTARIO_ERRO_VALOR.
+ */
+static int conferirPilha(const Inventario *inventario, int slot, const char *tipo, int valor) {
+    if (strcmp(inventarioTipo(inventario, slot), tipo) != 0) return INVENTARIO_ERRO_TIPO_DIVERGENTE;
+    if (valor > inventario->configuracao.valorMaximo - inventarioValor(inventario, slot)) return INVENTARIO_ERRO_VALOR;
+    return INVENTARIO_OK;
+}
+
+/**
+ * @brief Soma um valor já conferido ao componente de um slot, sem mudá-lo de lugar.
+ */
+static void somarNoSlot(Inventario *inventario, int slot, int valor) {
+    inventario->componentes[slot].prioridade += valor;
+    if (inventario->configuracao.empilhar && !inventario->indiceTiposPendente) {
+        indiceTipoSomarQuantidade(&inventario->indiceTipos, inventarioTipo(inventario, slot), valor);
+    }
+    // O slot continuaria no balde do valor antigo
+    inventario->indicePrioridadesPendente = 1;
+    if (!inventario->filaMontagemPendente) {
+        heapPrioridadeAtualizar(&inventario->filaMontagem, inventario->componentes, slot);
+    }
+    inventario->versao++;
+}
+
+/**
+ * @brief Descarta o componente de um slot vivo (o índice de nomes precisa estar pronto).
+ * O slot vira uma lápide em O(1); a compactação roda quando as lápides passam do limiar.
+ */
+static void removerNoSlot(Inventario *inventario, int slot) {
+    Componente *componente = &inventario->componentes[slot];
+    indiceHashRemover(&inventario->indiceNomes, inventarioNome(inventario, slot), slot);
+    arenaNomesDescartar(&inventario->nomes, componente);
+
+    if (!inventario->indicePrioridadesPendente) {
+        indicePrioridadeRemover(&inventario->indicePrioridades, componente->prioridade);
+    }
+    if (!inventario->indiceTiposPendente) {
+        indiceTipoRemover(&inventario->indiceTipos, tipoDoComponente(componente),
+                          pesoNoTipo(inventario, componente->prioridade));
+    }
+    if (!inventario->filaMontagemPendente) {
+        heapPrioridadeRemover(&inventario->filaMontagem, inventario->componentes, slot);
+    }
+
+    // Marca a lápide: nome (na arena) e tipo continuam no lugar, então a ordem do vetor
+    // (e com ela o status de ordenação) não muda
+    componente->prioridade = PRIORIDADE_REMOVIDO;
+    inventario->totalComponentes--;
+    inventario->versao++;
+
+    int limiar = inventario->configuracao.limiarCompactacao;
+    int lapides = inventario->slotsUsados - inventario->totalComponentes;
+    if (inventario->totalComponentes == 0 ||
+        (limiar > 0 && lapides * 100LL > (long long)inventario->slotsUsados * limiar)) {
+        inventarioCompactar(inventario);
+    }
+}
+
+/**
+ * @brief Ordem por nome usada nas buscas por prefixo e por faixa.
+ * Se o vetor já está ordenado por nome, ele mesmo serve (ordem NULL, lápides incluídas);
+ * senão, usa a visão por nome, montada uma vez e reaproveitada até a próxima alteração.
+ * @return 1 em caso de sucesso, 0 se faltar memória para montar a visão.
+ */
+static int ordemPorNome(Inventario *inventario, const int **ordem, int *total) {
+    if (inventario->statusOrdenacao) {
+        *ordem = NULL;
+        *total = inventario->slotsUsados;
+        return 1;
+    }
+    EstatisticasOrdenacao estatisticas;
+    const VisaoOrdenada *visao = inventarioVisao(inventario, CRITERIO_NOME, &estatisticas);
+    if (visao == NULL) return 0;
+    *ordem = visao->slots;
+    *total = visao->total;
+    return 1;
+}
+
+// ---------------------------------------------
+// CRIAÇÃO E DESTRUIÇÃO
+// ---------------------------------------------
+
+/**
+ * @brief Regras do nível Mestre: prioridades de 1 a 10, nomes até NOME_MAX, sem empilhar.
+ */
+void inventarioConfiguracaoPadrao(ConfiguracaoInventario *configuracao) {
+    configuracao->reservaInicial = 16;
+    configuracao->limiarCompactacao = 25;
+    configuracao->valorMinimo = PRIORIDADE_MIN;
+    configuracao->valorMaximo = PRIORIDADE_MAX;
+    configuracao->nomeMax = NOME_MAX;
+    configuracao->empilhar = 0;
+    configuracao->indicesPorValor = 1;
+}
+
+/**
+ * @brief Cria um inventário vazio com a reserva da configuração já alocada.
+ * @return 1 em caso de sucesso, 0 se a configuração for inválida ou faltar memória.
+ */
+int inventarioCriar(Inventario *inventario, const ConfiguracaoInventario *configuracao) {
+    memset(inventario, 0, sizeof(*inventario));
+    if (configuracao->reservaInicial <= 0 || configuracao->limiarCompactacao < 0 ||
+        configuracao->limiarCompactacao > 100 || configuracao->valorMinimo <= PRIORIDADE_REMOVIDO ||
+        configuracao->valorMaximo < configuracao->valorMinimo || configuracao->nomeMax < 2 ||
+        configuracao->nomeMax > NOME_MAX ||
+        (configuracao->indicesPorValor && configuracao->valorMaximo > PRIORIDADE_MAX)) {
+        return 0;
+    }
+    inventario->configuracao = *configuracao;
+    inventario->algoritmoPorCriterio[CRITERIO_NOME] = ALGORITMO_INTROSORT; // Mais rápido em média
+    inventario->algoritmoPorCriterio[CRITERIO_TIPO] = ALGORITMO_CONTAGEM;  // Posto no dicionário, O(n + tipos)
+    inventario->algoritmoPorCriterio[CRITERIO_PRIORIDADE] = configuracao->valorMaximo <= PRIORIDADE_MAX ?
+                                                            ALGORITMO_CONTAGEM : ALGORITMO_MERGESORT;
+    for (int c = 0; c < TOTAL_CRITERIOS; c++) inventario->visoes[c] = (VisaoOrdenada){ NULL, 0, -1 };
+
+    arenaNomesInicializar(&inventario->nomes);
+    indicePrioridadeInicializar(&inventario->indicePrioridades);
+    heapPrioridadeInicializar(&inventario->filaMontagem);
+    // Sem índices por valor, baldes e fila ficam pendentes e nunca são montados
+    inventario->indicePrioridadesPendente = !configuracao->indicesPorValor;
+    inventario->filaMontagemPendente = !configuracao->indicesPorValor;
+
+    if (!redimensionar(inventario, configuracao->reservaInicial)) return 0;
+    if (!indiceHashInicializar(&inventario->indiceNomes, configuracao->reservaInicial, nomeDoSlot, inventario)) {
+        free(inventario->componentes);
+        return 0;
+    }
+    if (!indiceTipoInicializar(&inventario->indiceTipos, tipoDoSlot, configuracao->empilhar ? valorDoSlot : NULL,
+                               inventario)) {
+        indiceHashLiberar(&inventario->indiceNomes);
+        free(inventario->componentes);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Libera tudo o que o inventário alocou (ou o mapeamento do snapshot em uso).
+ */
+void inventarioDestruir(Inventario *inventario) {
+    indiceHashLiberar(&inventario->indiceNomes);
+    indicePrioridadeLiberar(&inventario->indicePrioridades);
+    indiceTipoLiberar(&inventario->indiceTipos);
+    heapPrioridadeLiberar(&inventario->filaMontagem);
+    for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+        free(inventario->visoes[c].slots);
+        inventario->visoes[c] = (VisaoOrdenada){ NULL, 0, -1 };
+    }
+    arenaNomesLiberar(&inventario->nomes);
+    if (inventario->emSnapshot) {
+        fecharSnapshot(&inventario->snapshot);
+        inventario->emSnapshot = 0;
+    } else {
+        free(inventario->componentes);
+    }
+    inventario->componentes = NULL;
+    inventario->totalComponentes = 0;
+    inventario->slotsUsados = 0;
+    inventario->capacidade = 0;
+}
+
+// ---------------------------------------------
+// ALTERAÇÕES
+// ---------------------------------------------
+
+/**
+ * @brief Adiciona um componente. Com empilhar, um nome que já está no inventário recebe
+ * o valor somado ao existente (mesmo tipo, sem passar de valorMaximo); senão, o
+ * componente ocupa um slot novo, mantendo todos os índices.
+ * @param empilhado Recebe 1 se o valor foi somado a um componente existente (pode ser NULL).
+ * @return O slot do componente (>= 0) ou um código INVENTARIO_ERRO_* (< 0).
+ */
+int inventarioAdicionar(Inventario *inventario, const char *nome, const char *tipo, int valor, int *empilhado) {
+    if (empilhado != NULL) *empilhado = 0;
+    int codigo = validarComponente(inventario, nome, tipo, valor);
+    if (codigo != INVENTARIO_OK) return codigo;
+
+    if (inventario->configuracao.empilhar) {
+        if (!garantirIndiceNomes(inventario)) return INVENTARIO_ERRO_MEMORIA;
+        int existente = indiceHashBuscar(&inventario->indiceNomes, nome);
+        if (existente >= 0) {
+            codigo = conferirPilha(inventario, existente, tipo, valor);
+            if (codigo != INVENTARIO_OK) return codigo;
+            somarNoSlot(inventario, existente, valor);
+            inventario->contadores.empilhados++;
+            if (empilhado != NULL) *empilhado = 1;
+            return existente;
+        }
+    }
+
+    int idTipo = dicionarioTiposInternar(tipo);
+    if (idTipo < 0) return INVENTARIO_ERRO_TIPOS_ESGOTADOS;
+    return inserirNovo(inventario, nome, idTipo, valor);
+}
+
+// Registro agregado da carga em lote (com empilhar, os nomes repetidos do lote viram um só)
+typedef struct {
+    const char *nome;
+    const char *tipo;
+    int valor;
+    int registro;    // Primeiro registro do lote com este nome
+} AgregadoLote;
+
+/**
+ * @brief Função de acesso do índice hash temporário da carga em lote.
+ */
+static const char *nomeDoAgregado(const void *contexto, int posicao) {
+    return ((const AgregadoLote *)contexto)[posicao].nome;
+}
+
+/**
+ * @brief Carrega um lote inteiro de uma vez, com a mesma regra de inventarioAdicionar,
+ * em tempo linear no tamanho do lote.
+ * 1ª passada: valida os registros e (com empilhar) agrega os nomes repetidos do lote.
+ * 2ª passada: localiza cada nome agregado no inventário e confere tipo e limite da pilha.
+ * Só então o vetor e a arena reservam de uma vez o espaço de todo o lote e, por
+ * último, os tipos novos são internados todos juntos (tudo ou nada): qualquer
+ * registro inválido, falta de memória ou de tipos deixa o inventário e o dicionário
+ * exatamente como estavam (só a capacidade reservada pode ter crescido).
+ * @param resultado Recebe as contagens e, em caso de erro, o registro que o causou.
+ * @return INVENTARIO_OK ou o código de erro do primeiro registro que impediu a carga.
+ */
+int inventarioCarregarLote(Inventario *inventario, const RegistroInventario *registros, int total,
+                           ResultadoLote *resultado) {
+    memset(resultado, 0, sizeof(*resultado));
+    resultado->registros = total;
+    resultado->registroInvalido = -1;
+    if (total <= 0) return INVENTARIO_OK;
+
+    int empilhar = inventario->configuracao.empilhar;
+    if (empilhar && !garantirIndiceNomes(inventario)) return INVENTARIO_ERRO_MEMORIA;
+
+    AgregadoLote *agregados = malloc((size_t)total * sizeof(AgregadoLote));
+    int *destinos = malloc((size_t)total * sizeof(int));
+    IndiceHash porNome;
+    if (agregados == NULL || destinos == NULL ||
+        !indiceHashInicializar(&porNome, empilhar ? total : 1, nomeDoAgregado, agregados)) {
+        free(agregados);
+        free(destinos);
+        return INVENTARIO_ERRO_MEMORIA;
+    }
+
+    int totalAgregados = 0;
+    int empilhados = 0;
+    int codigo = INVENTARIO_OK;
+    for (int i = 0; i < total && codigo == INVENTARIO_OK; i++) {
+        const RegistroInventario *registro = &registros[i];
+        codigo = validarComponente(inventario, registro->nome, registro->tipo, registro->valor);
+        if (codigo != INVENTARIO_OK) {
+            resultado->registroInvalido = i;
+            break;
+        }
+        int posicao = empilhar ? indiceHashBuscar(&porNome, registro->nome) : -1;
+        if (posicao >= 0) {
+            AgregadoLote *agregado = &agregados[posicao];
+            if (strcmp(agregado->tipo, registro->tipo) != 0) {
+                codigo = INVENTARIO_ERRO_TIPO_DIVERGENTE;
+            } else if (registro->valor > inventario->configuracao.valorMaximo - agregado->valor) {
+                codigo = INVENTARIO_ERRO_VALOR;
+            } else {
+                agregado->valor += registro->valor;
+                empilhados++;
+            }
+        } else {
+            agregados[totalAgregados] = (AgregadoLote){ registro->nome, registro->tipo, registro->valor, i };
+            if (empilhar && !indiceHashInserir(&porNome, registro->nome, totalAgregados)) codigo = INVENTARIO_ERRO_MEMORIA;
+            totalAgregados++;
+        }
+        if (codigo != INVENTARIO_OK) resultado->registroInvalido = i;
+    }
+    indiceHashLiberar(&porNome);
+
+    // Casa os agregados com o inventário sem alterá-lo (-1 = componente novo)
+    int novos = 0;
+    size_t bytesNomes = 0;
+    for (int a = 0; a < totalAgregados && codigo == INVENTARIO_OK; a++) {
+        destinos[a] = empilhar ? indiceHashBuscar(&inventario->indiceNomes, agregados[a].nome) : -1;
+        if (destinos[a] < 0) {
+            novos++;
+            bytesNomes += strlen(agregados[a].nome) + 1;
+            continue;
+        }
+        codigo = conferirPilha(inventario, destinos[a], agregados[a].tipo, agregados[a].valor);
+        if (codigo == INVENTARIO_OK) empilhados++;
+        else resultado->registroInvalido = agregados[a].registro;
+    }
+
+    // Uma única realocação para todos os componentes novos (no mínimo dobrando, como no append)
+    int necessario = inventario->slotsUsados + novos;
+    if (codigo == INVENTARIO_OK && necessario > inventario->capacidade) {
+        int novaCapacidade = inventario->capacidade * 2 > necessario ? inventario->capacidade * 2 : necessario;
+        if (!redimensionar(inventario, novaCapacidade)) codigo = INVENTARIO_ERRO_MEMORIA;
+    }
+    if (codigo == INVENTARIO_OK && !arenaNomesReservar(&inventario->nomes, bytesNomes)) codigo = INVENTARIO_ERRO_MEMORIA;
+
+    // Os tipos novos entram no dicionário por último, todos juntos (destinos guarda o id)
+    const char **tiposNovos = NULL;
+    int *idsNovos = NULL;
+    if (codigo == INVENTARIO_OK && novos > 0) {
+        tiposNovos = malloc((size_t)novos * sizeof(*tiposNovos));
+        idsNovos = malloc((size_t)novos * sizeof(*idsNovos));
+        if (tiposNovos == NULL || idsNovos == NULL) codigo = INVENTARIO_ERRO_MEMORIA;
+    }
+    if (codigo == INVENTARIO_OK && novos > 0) {
+        int n = 0;
+        for (int a = 0; a < totalAgregados; a++) {
+            if (destinos[a] < 0) tiposNovos[n++] = agregados[a].tipo;
+        }
+        int internados = dicionarioTiposInternarLote(tiposNovos, novos, idsNovos);
+        n = 0;
+        for (int a = 0; a < totalAgregados && codigo == INVENTARIO_OK; a++) {
+            if (destinos[a] >= 0) continue;
+            if (n == internados) {
+                codigo = INVENTARIO_ERRO_TIPOS_ESGOTADOS;
+                resultado->registroInvalido = agregados[a].registro;
+            } else {
+                destinos[a] = -1 - idsNovos[n++];
+            }
+        }
+    }
+    free(tiposNovos);
+    free(idsNovos);
+    if (codigo != INVENTARIO_OK) {
+        free(agregados);
+        free(destinos);
+        return codigo;
+    }
+
+    // Com o espaço reservado, nenhuma inserção pode falhar no meio do lote.
+    // As somas vêm antes das inserções: no modo sempre ordenado uma inserção desloca
+    // a cauda do vetor, e os slots guardados em destinos deixariam de valer
+    for (int a = 0; a < totalAgregados; a++) {
+        if (destinos[a] >= 0) somarNoSlot(inventario, destinos[a], agregados[a].valor);
+    }
+    for (int a = 0; a < totalAgregados; a++) {
+        if (destinos[a] < 0) inserirNovo(inventario, agregados[a].nome, -1 - destinos[a], agregados[a].valor);
+    }
+    free(agregados);
+    free(destinos);
+
+    resultado->novos = novos;
+    resultado->empilhados = empilhados;
+    inventario->contadores.empilhados += empilhados;
+    return INVENTARIO_OK;
+}
+
+/**
+ * @brief Descarta o componente com o nome informado (o de menor slot, se houver repetidos).
+ * @return O slot que o componente ocupava (>= 0), INVENTARIO_ERRO_NAO_ENCONTRADO ou
+ * INVENTARIO_ERRO_MEMORIA.
+ */
+int inventarioRemover(Inventario *inventario, const char *nome) {
+    if (!garantirIndiceNomes(inventario)) return INVENTARIO_ERRO_MEMORIA;
+
+    // Localização em O(1) pelo índice hash (sem varrer o vetor)
+    int slot = indiceHashBuscar(&inventario->indiceNomes, nome);
+    if (slot == -1) return INVENTARIO_ERRO_NAO_ENCONTRADO;
+    removerNoSlot(inventario, slot);
+    return slot;
+}
+
+/**
+ * @brief Muda o valor do componente com o nome informado, sem mudá-lo de slot.
+ * A fila de montagem é ajustada em O(log n); os baldes ficam pendentes (o slot
+ * continuaria listado no balde antigo).
+ * @return O slot do componente (>= 0) ou um código INVENTARIO_ERRO_* (< 0).
+ */
+int inventarioAlterarValor(Inventario *inventario, const char *nome, int novoValor) {
+    if (novoValor < inventario->configuracao.valorMinimo || novoValor > inventario->configuracao.valorMaximo) {
+        return INVENTARIO_ERRO_VALOR;
+    }
+    if (!garantirIndiceNomes(inventario)) return INVENTARIO_ERRO_MEMORIA;
+
+    int slot = indiceHashBuscar(&inventario->indiceNomes, nome);
+    if (slot == -1) return INVENTARIO_ERRO_NAO_ENCONTRADO;
+    somarNoSlot(inventario, slot, novoValor - inventarioValor(inventario, slot));
+    return slot;
+}
+
+/**
+ * @brief Tira do inventário o componente do topo da fila de montagem (o de maior valor).
+ * @param montado Recebe uma cópia do componente (o slot pode ser reaproveitado pela compactação).
+ * @param nomeMontado Recebe o nome (NOME_MAX bytes): a compactação também recupera o texto na arena.
+ * @return O slot que ele ocupava, INVENTARIO_ERRO_NAO_ENCONTRADO (vazio ou sem
+ * indicesPorValor) ou INVENTARIO_ERRO_MEMORIA.
+ */
+int inventarioMontarProximo(Inventario *inventario, Componente *montado, char *nomeMontado) {
+    if (!inventario->configuracao.indicesPorValor) return INVENTARIO_ERRO_NAO_ENCONTRADO;
+    if (!garantirIndiceNomes(inventario) || !garantirFilaMontagem(inventario)) return INVENTARIO_ERRO_MEMORIA;
+
+    int topo = heapPrioridadeTopo(&inventario->filaMontagem);
+    if (topo < 0) return INVENTARIO_ERRO_NAO_ENCONTRADO;
+
+    *montado = inventario->componentes[topo];
+    memcpy(nomeMontado, inventarioNome(inventario, topo), (size_t)montado->tamanhoNome + 1);
+    removerNoSlot(inventario, topo);
+    return topo;
+}
+
+/**
+ * @brief Remove as lápides movendo os componentes vivos para frente, na mesma ordem,
+ * e recupera na arena os nomes que só as lápides usavam.
+ * Os slots mudam, então os índices ficam pendentes de reconstrução.
+ * @return Quantidade de slots recuperados.
+ */
+int inventarioCompactar(Inventario *inventario) {
+    int lapides = inventario->slotsUsados - inventario->totalComponentes;
+    if (lapides == 0) return 0;
+
+    uint64_t inicio = agoraNs();
+    Componente *componentes = inventario->componentes;
+    int destino = 0;
+    long long movimentos = 0;
+    for (int i = 0; i < inventario->slotsUsados; i++) {
+        if (COMPONENTE_REMOVIDO(&componentes[i])) continue;
+        if (destino != i) {
+            componentes[destino] = componentes[i];
+            movimentos++;
+        }
+        destino++;
+    }
+    inventario->slotsUsados = destino;
+    // Sem memória para o bloco novo a arena só continua maior que o necessário
+    arenaNomesCompactar(&inventario->nomes, componentes, destino);
+    reindexar(inventario);
+    encolher(inventario);
+
+    inventario->contadores.movimentacoes += movimentos;
+    inventario->contadores.compactacoes++;
+    inventario->contadores.nsUltimaCompactacao = agoraNs() - inicio;
+    return lapides;
+}
+
+// ---------------------------------------------
+// ORDENAÇÃO
+// ---------------------------------------------
+
+/**
+ * @brief Ordena o vetor pelo motor de ordenação (compactando antes) e marca os índices
+ * para reconstrução. No modo sempre ordenado, ordenar por nome não faz nada e os outros
+ * critérios são recusados. Com a ordenação indireta, o motor ordena só as entradas
+ * (chave + slot) e cada componente é movido uma vez ao aplicar a permutação.
+ * @return 1 em caso de sucesso, 0 se faltar memória ou a combinação for inválida.
+ */
+int inventarioOrdenar(Inventario *inventario, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                      EstatisticasOrdenacao *estatisticas) {
+    if (inventario->modoSempreOrdenado) {
+        memset(estatisticas, 0, sizeof(*estatisticas));
+        return criterio == CRITERIO_NOME;
+    }
+
+    inventarioCompactar(inventario); // O motor de ordenação trabalha só com componentes vivos
+    Componente *componentes = inventario->componentes;
+    int total = inventario->totalComponentes;
+    if (inventario->ordenacaoIndireta) {
+        int *permutacao = malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+        if (permutacao == NULL) return 0;
+        int ordenados = ordenarPermutacaoComponentes(componentes, total, &inventario->nomes, criterio, algoritmo,
+                                                     permutacao, estatisticas);
+        long long movimentos = ordenados < 0 ? -1 :
+                               aplicarPermutacao(componentes, (size_t)ordenados, sizeof(Componente), permutacao);
+        free(permutacao);
+        if (movimentos < 0) return 0;
+        estatisticas->trocas += movimentos;
+    } else if (!ordenarComponentes(componentes, total, &inventario->nomes, criterio, algoritmo, estatisticas)) {
+        return 0;
+    }
+
+    // Só a ordenação por nome habilita a busca binária
+    inventario->statusOrdenacao = (criterio == CRITERIO_NOME);
+    reindexar(inventario);
+    return 1;
+}
+
+/**
+ * @brief Ordena o vetor com as threads do pool, com as mesmas regras de inventarioOrdenar.
+ * O resultado é idêntico ao da ordenação serial estável (Merge Sort / Counting Sort).
+ * O pool pode ser compartilhado entre inventários, desde que um de cada vez.
+ * @param porThread Vetor com uma posição por thread do pool (pode ser NULL).
+ * @return 1 em caso de sucesso, 0 se faltar memória ou não houver pool.
+ */
+int inventarioOrdenarParalelo(Inventario *inventario, PoolThreads *pool, CriterioOrdenacao criterio,
+                              EstatisticasOrdenacao *estatisticas, EstatisticasThread *porThread) {
+    if (inventario->modoSempreOrdenado) {
+        memset(estatisticas, 0, sizeof(*estatisticas));
+        return criterio == CRITERIO_NOME;
+    }
+    if (pool == NULL) return 0;
+
+    inventarioCompactar(inventario);
+    if (!ordenarComponentesParalelo(pool, inventario->componentes, inventario->totalComponentes, &inventario->nomes,
+                                    criterio, estatisticas, porThread)) {
+        return 0;
+    }
+    inventario->statusOrdenacao = (criterio == CRITERIO_NOME);
+    reindexar(inventario);
+    return 1;
+}
+
+/**
+ * @brief Ordena o vetor por vários critérios de uma vez (ex.: tipo, prioridade decrescente,
+ * nome), codificando os campos de cada componente em uma única chave de bytes
+ * (ordenarPermutacaoComposta) e movendo cada componente uma vez ao aplicar a permutação.
+ * No modo sempre ordenado, só é aceita uma ordem que comece por nome crescente.
+ * @return 1 em caso de sucesso, 0 se faltar memória ou a combinação for inválida.
+ */
+int inventarioOrdenarComposto(Inventario *inventario, const OrdemComposta *ordem, AlgoritmoOrdenacao algoritmo,
+                              EstatisticasOrdenacao *estatisticas) {
+    int porNome = ordem->totalCampos > 0 && ordem->campos[0].criterio == CRITERIO_NOME && !ordem->campos[0].decrescente;
+    if (inventario->modoSempreOrdenado && !porNome) return 0;
+
+    inventarioCompactar(inventario);
+    Componente *componentes = inventario->componentes;
+    int total = inventario->totalComponentes;
+    int *permutacao = malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    if (permutacao == NULL) return 0;
+    int ordenados = ordenarPermutacaoComposta(componentes, total, &inventario->nomes, ordem, algoritmo, permutacao,
+                                              estatisticas);
+    long long movimentos = ordenados < 0 ? -1 :
+                           aplicarPermutacao(componentes, (size_t)ordenados, sizeof(Componente), permutacao);
+    free(permutacao);
+    if (movimentos < 0) return 0;
+    estatisticas->trocas += movimentos;
+
+    // Começando por nome crescente, o vetor continua ordenado por nome (busca binária)
+    inventario->statusOrdenacao = porNome;
+    reindexar(inventario);
+    return 1;
+}
+
+/**
+ * @brief Liga ou desliga o modo sempre ordenado por nome.
+ * Ao ligar, o vetor é ordenado uma única vez (se ainda não estiver) com o algoritmo
+ * padrão do critério nome.
+ * @return 1 em caso de sucesso, 0 se faltar memória para a ordenação inicial.
+ */
+int inventarioDefinirModoSempreOrdenado(Inventario *inventario, int ativo) {
+    if (ativo && !inventario->statusOrdenacao) {
+        EstatisticasOrdenacao estatisticas;
+        inventario->modoSempreOrdenado = 0;
+        if (!inventarioOrdenar(inventario, CRITERIO_NOME, inventario->algoritmoPorCriterio[CRITERIO_NOME],
+                               &estatisticas)) {
+            return 0;
+        }
+    }
+    inventario->modoSempreOrdenado = ativo;
+    return 1;
+}
+
+/**
+ * @brief Devolve a visão ordenada do critério, montando-a se o inventário mudou desde a
+ * última vez. O vetor não é alterado: a visão é só uma permutação de slots.
+ * @param estatisticas Recebe o custo da montagem (zerado se a visão veio do cache).
+ * @return A visão, ou NULL se faltar memória.
+ */
+const VisaoOrdenada *inventarioVisao(Inventario *inventario, CriterioOrdenacao criterio,
+                                     EstatisticasOrdenacao *estatisticas) {
+    VisaoOrdenada *visao = &inventario->visoes[criterio];
+    memset(estatisticas, 0, sizeof(*estatisticas));
+    if (visao->versao == inventario->versao) return visao;
+
+    int slotsUsados = inventario->slotsUsados;
+    int *slots = realloc(visao->slots, (size_t)(slotsUsados > 0 ? slotsUsados : 1) * sizeof(int));
+    if (slots == NULL) return NULL;
+    visao->slots = slots;
+
+    int total = ordenarPermutacaoComponentes(inventario->componentes, slotsUsados, &inventario->nomes, criterio,
+                                             inventario->algoritmoPorCriterio[criterio], visao->slots, estatisticas);
+    if (total < 0) return NULL;
+    visao->total = total;
+    visao->versao = inventario->versao;
+    return visao;
+}
+
+// ---------------------------------------------
+// CONSULTAS
+// ---------------------------------------------
+
+/**
+ * @brief Localiza um nome pelo índice hash (O(1) esperado).
+ * @return O slot, INVENTARIO_ERRO_NAO_ENCONTRADO ou INVENTARIO_ERRO_MEMORIA.
+ */
+int inventarioBuscar(Inventario *inventario, const char *nome) {
+    if (!garantirIndiceNomes(inventario)) return INVENTARIO_ERRO_MEMORIA;
+    int slot = indiceHashBuscar(&inventario->indiceNomes, nome);
+    return slot >= 0 ? slot : INVENTARIO_ERRO_NAO_ENCONTRADO;
+}
+
+/**
+ * @brief Monta o índice de nomes se ele estiver pendente (depois de uma compactação,
+ * por exemplo). Chamada por quem tem acesso exclusivo, deixa o inventário pronto
+ * para inventarioBuscarLeitura em várias threads ao mesmo tempo.
+ * @return 1 se o índice está pronto, 0 se faltou memória.
+ */
+int inventarioPrepararLeitura(Inventario *inventario) {
+    return garantirIndiceNomes(inventario);
+}
+
+/**
+ * @brief Localiza um nome pelo índice hash sem alterar nada no inventário (nem
+ * reconstruir o índice): várias threads podem chamá-la juntas sobre o mesmo inventário.
+ * @return O slot, INVENTARIO_ERRO_NAO_ENCONTRADO ou INVENTARIO_ERRO_MEMORIA (índice
+ * pendente: inventarioPrepararLeitura não foi chamada ou faltou memória nela).
+ */
+int inventarioBuscarLeitura(const Inventario *inventario, const char *nome) {
+    if (inventario->indiceNomesPendente) return INVENTARIO_ERRO_MEMORIA;
+    int slot = indiceHashBuscar(&inventario->indiceNomes, nome);
+    return slot >= 0 ? slot : INVENTARIO_ERRO_NAO_ENCONTRADO;
+}
+
+/**
+ * @brief Busca binária por nome; só vale com o vetor ordenado por nome (statusOrdenacao).
+ * @return O slot, ou INVENTARIO_ERRO_NAO_ENCONTRADO (também se o vetor não estiver ordenado).
+ */
+int inventarioBuscaBinaria(const Inventario *inventario, const char *nome, long long *comparacoes,
+                           long long *desempates) {
+    if (!inventario->statusOrdenacao) return INVENTARIO_ERRO_NAO_ENCONTRADO;
+    int slot = buscaBinariaComponentes(inventario->componentes, inventario->slotsUsados, &inventario->nomes, nome,
+                                       comparacoes, desempates);
+    return slot >= 0 ? slot : INVENTARIO_ERRO_NAO_ENCONTRADO;
+}
+
+/**
+ * @brief Preparam o iterador sobre os nomes com um prefixo, ou entre "de" e "ate"
+ * (inclusive), na ordem por nome (o próprio vetor ou a visão por nome).
+ * O iterador só vale até a próxima alteração do inventário.
+ * @return Quantidade de posições no intervalo (lápides incluídas) ou INVENTARIO_ERRO_MEMORIA.
+ */
+int inventarioIteradorPrefixo(Inventario *inventario, IteradorNomes *iterador, const char *prefixo,
+                              long long *comparacoes, long long *desempates) {
+    const int *ordem;
+    int total;
+    if (!ordemPorNome(inventario, &ordem, &total)) return INVENTARIO_ERRO_MEMORIA;
+    return iteradorNomesPrefixo(iterador, inventario->componentes, ordem, total, &inventario->nomes, prefixo,
+                                comparacoes, desempates);
+}
+
+int inventarioIteradorFaixa(Inventario *inventario, IteradorNomes *iterador, const char *de, const char *ate,
+                            long long *comparacoes, long long *desempates) {
+    const int *ordem;
+    int total;
+    if (!ordemPorNome(inventario, &ordem, &total)) return INVENTARIO_ERRO_MEMORIA;
+    return iteradorNomesFaixa(iterador, inventario->componentes, ordem, total, &inventario->nomes, de, ate,
+                              comparacoes, desempates);
+}
+
+/**
+ * @brief Índice secundário por tipo, reconstruído se estiver pendente. Consultar com
+ * indiceTipoBuscar / indiceTipoListar; vale até a próxima alteração do inventário.
+ * @return O índice, ou NULL se faltar memória.
+ */
+const IndiceTipo *inventarioTipos(Inventario *inventario) {
+    return garantirIndiceTipos(inventario) ? &inventario->indiceTipos : NULL;
+}
+
+/**
+ * @brief Quantidade de componentes com valor mínimo informado (baldes por valor).
+ * @return A quantidade, INVENTARIO_ERRO_NAO_ENCONTRADO (sem indicesPorValor) ou INVENTARIO_ERRO_MEMORIA.
+ */
+int inventarioContarPorValor(Inventario *inventario, int valorMinimo) {
+    if (!inventario->configuracao.indicesPorValor) return INVENTARIO_ERRO_NAO_ENCONTRADO;
+    if (!garantirIndicePrioridades(inventario)) return INVENTARIO_ERRO_MEMORIA;
+    return indicePrioridadeContar(&inventario->indicePrioridades, valorMinimo);
+}
+
+/**
+ * @brief Lista (do maior valor para o menor) até "maximo" slots com o valor mínimo informado.
+ * @return Quantidade de slots escritos, ou um código INVENTARIO_ERRO_* (< 0).
+ */
+int inventarioListarPorValor(Inventario *inventario, int valorMinimo, int *destino, int maximo) {
+    if (!inventario->configuracao.indicesPorValor) return INVENTARIO_ERRO_NAO_ENCONTRADO;
+    if (!garantirIndicePrioridades(inventario)) return INVENTARIO_ERRO_MEMORIA;
+    return indicePrioridadeListar(&inventario->indicePrioridades, inventario->componentes, valorMinimo, destino,
+                                  maximo);
+}
+
+/**
+ * @brief Slot do componente de maior valor (topo da fila de montagem), em O(1).
+ * @return O slot, INVENTARIO_ERRO_NAO_ENCONTRADO (vazio ou sem indicesPorValor) ou INVENTARIO_ERRO_MEMORIA.
+ */
+int inventarioTopo(Inventario *inventario) {
+    if (!inventario->configuracao.indicesPorValor) return INVENTARIO_ERRO_NAO_ENCONTRADO;
+    if (!garantirFilaMontagem(inventario)) return INVENTARIO_ERRO_MEMORIA;
+    int topo = heapPrioridadeTopo(&inventario->filaMontagem);
+    return topo >= 0 ? topo : INVENTARIO_ERRO_NAO_ENCONTRADO;
+}
+
+/**
+ * @brief Os k componentes de maior valor, em ordem, sem alterar a fila de montagem.
+ * @return Quantidade de slots escritos, ou um código INVENTARIO_ERRO_* (< 0).
+ */
+int inventarioMaiores(Inventario *inventario, int k, int *destino) {
+    if (!inventario->configuracao.indicesPorValor) return INVENTARIO_ERRO_NAO_ENCONTRADO;
+    if (!garantirFilaMontagem(inventario)) return INVENTARIO_ERRO_MEMORIA;
+    int encontrados = heapPrioridadeMaiores(&inventario->filaMontagem, inventario->componentes, k, destino);
+    return encontrados >= 0 ? encontrados : INVENTARIO_ERRO_MEMORIA;
+}
+
+// ---------------------------------------------
+// PERSISTÊNCIA (SNAPSHOT BINÁRIO)
+// ---------------------------------------------
+
+// Bloco extra do snapshot: o tamanho do dicionário de tipos (uint32_t), o dicionário
+// serializado e, até o fim do bloco, a arena de nomes dos registros.
+
+/**
+ * @brief Interna os tipos gravados no bloco extra do snapshot.
+ * O bloco e o id de tipo de todos os registros são conferidos antes de qualquer
+ * internação, e a importação é tudo ou nada: um arquivo recusado não deixa tipos
+ * no dicionário compartilhado. Se os ids deste processo não coincidirem com os do
+ * arquivo (o dicionário já tinha outros tipos), os registros mapeados (cópia
+ * privada) são traduzidos.
+ * @return 1 em caso de sucesso, 0 se o dicionário ou algum id for inválido (ou não couber).
+ */
+static int importarTiposSnapshot(SnapshotMapeado *snapshot, const char *dicionario, size_t tamanhoDicionario) {
+    int totalTipos = dicionarioTiposContarBloco(dicionario, tamanhoDicionario, TIPOS_DISTINTOS_MAX);
+    if (totalTipos < 0) return 0;
+    Componente *registros = snapshot->registros;
+    for (size_t i = 0; i < snapshot->totalRegistros; i++) {
+        if (registros[i].idTipo >= totalTipos) return 0;
+    }
+
+    uint16_t novosIds[TIPOS_DISTINTOS_MAX];
+    if (dicionarioTiposImportar(dicionario, tamanhoDicionario, novosIds, TIPOS_DISTINTOS_MAX) != totalTipos) return 0;
+
+    int mesmosIds = 1;
+    for (int id = 0; id < totalTipos && mesmosIds; id++) mesmosIds = novosIds[id] == id;
+    if (mesmosIds) return 1;
+
+    for (size_t i = 0; i < snapshot->totalRegistros; i++) registros[i].idTipo = novosIds[registros[i].idTipo];
+    return 1;
+}
+
+/**
+ * @brief Carrega um inventário vazio do snapshot mapeado em memória (sem parsing nem cópia).
+ * O vetor passa a apontar para os registros mapeados e a arena, para os nomes
+ * mapeados; só quando precisarem crescer eles são copiados para o heap. Os índices
+ * ficam pendentes até o primeiro uso.
+ * @param geracaoDiario Recebe a geração do diário gravada no snapshot (pode ser NULL).
+ * @return SNAPSHOT_OK, SNAPSHOT_INEXISTENTE ou SNAPSHOT_INVALIDO (registros fora da faixa de valores inclusive).
+ */
+int inventarioCarregarSnapshot(Inventario *inventario, const char *caminho, uint32_t *geracaoDiario) {
+    SnapshotMapeado snapshot;
+    int resultado = abrirSnapshot(caminho, SNAPSHOT_REGISTRO_COMPONENTE, sizeof(Componente), &snapshot);
+    if (resultado != SNAPSHOT_OK) return resultado;
+
+    const char *extra = snapshot.extra;
+    uint32_t tamanhoDicionario = 0;
+    ArenaNomes nomesMapeados;
+    int valido = snapshot.totalRegistros <= (size_t)0x7fffffff && snapshot.tamanhoExtra >= sizeof(tamanhoDicionario);
+    if (valido) {
+        memcpy(&tamanhoDicionario, extra, sizeof(tamanhoDicionario));
+        extra += sizeof(tamanhoDicionario);
+        valido = tamanhoDicionario <= snapshot.tamanhoExtra - sizeof(tamanhoDicionario);
+    }
+    if (valido) {
+        arenaNomesAdotar(&nomesMapeados, extra + tamanhoDicionario,
+                         snapshot.tamanhoExtra - sizeof(tamanhoDicionario) - tamanhoDicionario);
+        valido = arenaNomesValidar(&nomesMapeados, snapshot.registros, snapshot.totalRegistros);
+    }
+    // Um arquivo de outras regras (ex.: quantidades num inventário de prioridades) também é recusado
+    const Componente *registros = snapshot.registros;
+    for (size_t i = 0; i < snapshot.totalRegistros && valido; i++) {
+        valido = registros[i].prioridade >= inventario->configuracao.valorMinimo &&
+                 registros[i].prioridade <= inventario->configuracao.valorMaximo &&
+                 registros[i].tamanhoNome < inventario->configuracao.nomeMax;
+    }
+    if (valido) valido = importarTiposSnapshot(&snapshot, extra, tamanhoDicionario);
+    if (!valido) {
+        fecharSnapshot(&snapshot);
+        return SNAPSHOT_INVALIDO;
+    }
+
+    inventario->statusOrdenacao = snapshot.ordenadoPorNome;
+    if (geracaoDiario != NULL) *geracaoDiario = snapshot.geracaoDiario;
+    if (snapshot.totalRegistros == 0) {
+        fecharSnapshot(&snapshot);
+    } else {
+        // Troca a reserva do heap pelo próprio mapeamento
+        free(inventario->componentes);
+        inventario->componentes = snapshot.registros;
+        arenaNomesLiberar(&inventario->nomes);
+        inventario->nomes = nomesMapeados;
+        inventario->totalComponentes = (int)snapshot.totalRegistros;
+        inventario->slotsUsados = inventario->totalComponentes;
+        inventario->capacidade = inventario->totalComponentes;
+        inventario->snapshot = snapshot;
+        inventario->emSnapshot = 1;
+        reindexar(inventario);
+    }
+    return SNAPSHOT_OK;
+}
+
+/**
+ * @brief Lista, em ordem de id, os tipos usados pelos componentes (chamar sem lápides).
+ * @param usados Recebe os ids usados; usados[k] vira o id k no arquivo.
+ * @param idNoArquivo Recebe, na posição de cada id usado, o id que ele terá no arquivo.
+ * @return Quantidade de tipos usados.
+ */
+static int tiposUsados(const Inventario *inventario, uint16_t *usados, uint16_t *idNoArquivo) {
+    unsigned char usado[TIPOS_DISTINTOS_MAX] = { 0 };
+    for (int i = 0; i < inventario->totalComponentes; i++) usado[inventario->componentes[i].idTipo] = 1;
+    int total = 0;
+    for (int id = 0; id < TIPOS_DISTINTOS_MAX; id++) {
+        if (!usado[id]) continue;
+        idNoArquivo[id] = (uint16_t)total;
+        usados[total++] = (uint16_t)id;
+    }
+    return total;
+}
+
+/**
+ * @brief Grava o inventário no snapshot, já sem lápides, com os tipos que ele usa e a
+ * arena de nomes no bloco extra.
+ * O dicionário é do processo e pode ter tipos de outros inventários: só os tipos dos
+ * componentes desta mochila vão para o arquivo, renumerados de 0 em ordem de id (os
+ * ids dos componentes são traduzidos só durante a gravação e depois restaurados).
+ * @return 1 em caso de sucesso, 0 em caso de erro (de E/S ou de memória).
+ */
+int inventarioSalvarSnapshot(Inventario *inventario, const char *caminho, uint32_t geracaoDiario) {
+    inventarioCompactar(inventario);
+    uint16_t usados[TIPOS_DISTINTOS_MAX], idNoArquivo[TIPOS_DISTINTOS_MAX];
+    int totalUsados = tiposUsados(inventario, usados, idNoArquivo);
+    int mesmosIds = 1;
+    for (int k = 0; k < totalUsados && mesmosIds; k++) mesmosIds = usados[k] == k;
+
+    // Os registros guardam ids de tipo e deslocamentos de nome: o dicionário e a arena vão juntos
+    size_t tamanhoDicionario;
+    char *dicionario = dicionarioTiposSerializar(usados, totalUsados, &tamanhoDicionario);
+    size_t tamanhoExtra = sizeof(uint32_t) + tamanhoDicionario + inventario->nomes.usado;
+    char *extra = dicionario != NULL ? malloc(tamanhoExtra) : NULL;
+    int sucesso = extra != NULL;
+    if (sucesso) {
+        uint32_t tamanho32 = (uint32_t)tamanhoDicionario;
+        memcpy(extra, &tamanho32, sizeof(tamanho32));
+        memcpy(extra + sizeof(tamanho32), dicionario, tamanhoDicionario);
+        if (inventario->nomes.usado > 0) {
+            memcpy(extra + sizeof(tamanho32) + tamanhoDicionario, inventario->nomes.dados, inventario->nomes.usado);
+        }
+        Componente *componentes = inventario->componentes;
+        if (!mesmosIds) {
+            for (int i = 0; i < inventario->totalComponentes; i++) componentes[i].idTipo = idNoArquivo[componentes[i].idTipo];
+        }
+        sucesso = salvarSnapshot(caminho, SNAPSHOT_REGISTRO_COMPONENTE, componentes, sizeof(Componente),
+                                 (size_t)inventario->totalComponentes, inventario->statusOrdenacao, geracaoDiario,
+                                 extra, tamanhoExtra);
+        if (!mesmosIds) {
+            for (int i = 0; i < inventario->totalComponentes; i++) componentes[i].idTipo = usados[componentes[i].idTipo];
+        }
+    }
+    free(dicionario);
+    free(extra);
+    return sucesso;
+}
@@ -0,0 +1,200 @@
+#ifndef INVENTARIO_H
+#define INVENTARIO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "componente.h"
+#include "arena_nomes.h"
+#include "dicionario_tipos.h"
+#include "indice_hash.h"
+#include "indice_prioridade.h"
+#include "indice_tipo.h"
+#include "heap_prioridade.h"
+#include "busca.h"
+#include "snapshot.h"
+#include "ordenacao.h"
+#include "ordenacao_paralela.h"
+#include "pool_threads.h"
+
+// ---------------------------------------------
+// BIBLIOTECA DE INVENTÁRIO (Núcleo Reentrante)
+// ---------------------------------------------
+// Todo o estado de uma mochila (vetor com lápides, arena de nomes, índices,
+// visões ordenadas, status de ordenação) fica em um Inventario passado a cada
+// função, sem nenhuma variável global: vários inventários convivem no mesmo
+// processo, e threads diferentes podem usar inventários diferentes sem trava
+// (um mesmo inventário não deve ser usado por duas threads ao mesmo tempo, a não
+// ser pelas leituras de inventarioBuscarLeitura, que não alteram nada).
+// A biblioteca não lê nem escreve no terminal. Menus, modo lote, métricas de
+// latência e diário ficam com quem a usa (MestreFreeFire.c, DesafioFreeFire.c):
+// o trabalho feito por dentro (compactações, deslocamentos, empilhamentos) fica
+// acumulado em "contadores" para quem quiser medi-lo.
+// Cada componente guarda um valor inteiro no campo prioridade: a prioridade de
+// montagem no nível Mestre, a quantidade no nível Aventureiro (com empilhar).
+// O único estado compartilhado é o dicionário de tipos (dicionario_tipos.h), que
+// tem trava própria: cada ordenação por tipo copia os postos sob essa trava no
+// início e ordena só pela cópia, então outra thread pode internar tipos novos
+// no meio sem interferir.
+// Custo desse compartilhamento: o limite de TIPOS_DISTINTOS_MAX tipos vale para o
+// processo, não para cada inventário. Todos os Inventario (inclusive cada jogador
+// de multijogador.c) tiram ids do mesmo conjunto, e um inventário que use muitos
+// tipos distintos pode esgotá-los para os outros (INVENTARIO_ERRO_TIPOS_ESGOTADOS).
+// Um tipo internado nunca sai do dicionário, mesmo que nenhum componente o use
+// mais. O snapshot de um inventário grava só os tipos que os componentes dele usam.
+// Os índices guardam o endereço do Inventario: depois de criado, ele não pode
+// ser copiado nem movido.
+
+// Resultados das operações (valores >= 0 são slots)
+#define INVENTARIO_OK 0
+#define INVENTARIO_ERRO_MEMORIA -1
+#define INVENTARIO_ERRO_VALOR -2            // Fora da faixa, ou a pilha passaria do máximo
+#define INVENTARIO_ERRO_NOME_INVALIDO -3    // Nome vazio, ou nome/tipo longo demais
+#define INVENTARIO_ERRO_NAO_ENCONTRADO -4
+#define INVENTARIO_ERRO_TIPOS_ESGOTADOS -5  // Dicionário de tipos cheio (TIPOS_DISTINTOS_MAX)
+#define INVENTARIO_ERRO_TIPO_DIVERGENTE -6  // Com empilhar: o nome já existe com outro tipo
+
+// Regras de um inventário (fixas depois da criação)
+typedef struct {
+    int reservaInicial;        // Slots alocados na criação (a capacidade nunca encolhe abaixo disso)
+    int limiarCompactacao;     // Percentual de lápides que dispara a compactação (0 = só manual)
+    int valorMinimo;           // Faixa do valor (>= 1: o valor 0 marca as lápides)
+    int valorMaximo;
+    size_t nomeMax;            // Tamanho máximo do nome com o '\0' (até NOME_MAX)
+    int empilhar;              // 1 = o valor é uma quantidade: nome repetido soma ao existente
+    int indicesPorValor;       // 1 = baldes por valor e fila de montagem (exige valorMaximo <= PRIORIDADE_MAX)
+} ConfiguracaoInventario;
+
+// Visão ordenada somente leitura: permutação dos slots vivos na ordem de um critério.
+// Vale enquanto o inventário estiver na versão em que foi montada.
+typedef struct {
+    int *slots;          // Slots vivos na ordem do critério
+    int total;
+    long long versao;    // Versão do inventário na montagem (-1 = nunca montada)
+} VisaoOrdenada;
+
+// Trabalho acumulado desde a criação (quem mede calcula a diferença entre duas leituras)
+typedef struct {
+    long long movimentacoes;        // Componentes deslocados fora da ordenação (compactação, inserção ordenada)
+    long long empilhados;           // Adições somadas a um componente existente
+    long long compactacoes;
+    uint64_t nsUltimaCompactacao;   // Duração da última compactação (relógio monotônico)
+} ContadoresInventario;
+
+typedef struct {
+    ConfiguracaoInventario configuracao;
+
+    // Vetor dinâmico: cresce dobrando e encolhe pela metade com 1/4 de ocupação.
+    // Descartar só marca o slot como lápide; a compactação fecha os buracos na mesma ordem.
+    Componente *componentes;
+    int totalComponentes;     // Componentes vivos
+    int slotsUsados;          // Componentes vivos + lápides
+    int capacidade;
+    ArenaNomes nomes;         // Textos dos nomes (o componente guarda deslocamento e tamanho)
+
+    int statusOrdenacao;      // 1 = vetor ordenado por nome (habilita a busca binária)
+    int modoSempreOrdenado;   // 1 = cada inserção vai direto para a posição ordenada por nome
+    int ordenacaoIndireta;    // 1 = ordena índices e move cada componente uma vez no final
+    AlgoritmoOrdenacao algoritmoPorCriterio[TOTAL_CRITERIOS];
+
+    // Índices: após uma reordenação ficam "pendentes" e são refeitos no próximo uso
+    IndiceHash indiceNomes;
+    int indiceNomesPendente;
+    IndicePrioridade indicePrioridades;
+    int indicePrioridadesPendente;
+    IndiceTipo indiceTipos;
+    int indiceTiposPendente;
+    HeapPrioridade filaMontagem;
+    int filaMontagemPendente;
+
+    VisaoOrdenada visoes[TOTAL_CRITERIOS];
+    long long versao;         // Muda a cada alteração (invalida as visões)
+
+    // Snapshot mapeado que serve de armazenamento logo após a carga
+    SnapshotMapeado snapshot;
+    int emSnapshot;
+
+    ContadoresInventario contadores;
+} Inventario;
+
+// Registro de uma carga em lote (os textos são só lidos)
+typedef struct {
+    const char *nome;
+    const char *tipo;
+    int valor;
+} RegistroInventario;
+
+// Resultado de uma carga em lote (o lote entra inteiro ou não entra)
+typedef struct {
+    int registros;          // Registros recebidos
+    int novos;              // Registros que ocuparam um slot novo
+    int empilhados;         // Registros somados a um componente do inventário ou do próprio lote
+    int registroInvalido;   // Posição do registro que impediu a carga (-1 = nenhum)
+} ResultadoLote;
+
+void inventarioConfiguracaoPadrao(ConfiguracaoInventario *configuracao);
+int inventarioCriar(Inventario *inventario, const ConfiguracaoInventario *configuracao);
+void inventarioDestruir(Inventario *inventario);
+
+// Alterações
+int inventarioAdicionar(Inventario *inventario, const char *nome, const char *tipo, int valor, int *empilhado);
+int inventarioCarregarLote(Inventario *inventario, const RegistroInventario *registros, int total,
+                           ResultadoLote *resultado);
+int inventarioRemover(Inventario *inventario, const char *nome);
+int inventarioAlterarValor(Inventario *inventario, const char *nome, int novoValor);
+int inventarioMontarProximo(Inventario *inventario, Componente *montado, char *nomeMontado);
+int inventarioCompactar(Inventario *inventario);
+
+// Ordenação
+int inventarioOrdenar(Inventario *inventario, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                      EstatisticasOrdenacao *estatisticas);
+int inventarioOrdenarParalelo(Inventario *inventario, PoolThreads *pool, CriterioOrdenacao criterio,
+                              EstatisticasOrdenacao *estatisticas, EstatisticasThread *porThread);
+int inventarioOrdenarComposto(Inventario *inventario, const OrdemComposta *ordem, AlgoritmoOrdenacao algoritmo,
+                              EstatisticasOrdenacao *estatisticas);
+int inventarioDefinirModoSempreOrdenado(Inventario *inventario, int ativo);
+const VisaoOrdenada *inventarioVisao(Inventario *inventario, CriterioOrdenacao criterio,
+                                     EstatisticasOrdenacao *estatisticas);
+
+// Consultas
+int inventarioBuscar(Inventario *inventario, const char *nome);
+int inventarioBuscaBinaria(const Inventario *inventario, const char *nome, long long *comparacoes,
+                           long long *desempates);
+int inventarioIteradorPrefixo(Inventario *inventario, IteradorNomes *iterador, const char *prefixo,
+                              long long *comparacoes, long long *desempates);
+int inventarioIteradorFaixa(Inventario *inventario, IteradorNomes *iterador, const char *de, const char *ate,
+                            long long *comparacoes, long long *desempates);
+const IndiceTipo *inventarioTipos(Inventario *inventario);
+int inventarioPrepararLeitura(Inventario *inventario);
+int inventarioBuscarLeitura(const Inventario *inventario, const char *nome);
+int inventarioContarPorValor(Inventario *inventario, int valorMinimo);
+int inventarioListarPorValor(Inventario *inventario, int valorMinimo, int *destino, int maximo);
+int inventarioTopo(Inventario *inventario);
+int inventarioMaiores(Inventario *inventario, int k, int *destino);
+
+// Persistência (formato de snapshot.h, com o dicionário de tipos e a arena no bloco extra)
+int inventarioCarregarSnapshot(Inventario *inventario, const char *caminho, uint32_t *geracaoDiario);
+int inventarioSalvarSnapshot(Inventario *inventario, const char *caminho, uint32_t geracaoDiario);
+
+/**
+ * @brief Verdadeiro se o slot guarda um componente vivo (não é lápide).
+ */
+static inline int inventarioSlotVivo(const Inventario *inventario, int slot) {
+    return !COMPONENTE_REMOVIDO(&inventario->componentes[slot]);
+}
+
+/**
+ * @brief Nome do componente de um slot. Vale até a próxima inserção ou compactação.
+ */
+static inline const char *inventarioNome(const Inventario *inventario, int slot) {
+    return nomeNaArena(&inventario->nomes, &inventario->componentes[slot]);
+}
+
+static inline const char *inventarioTipo(const Inventario *inventario, int slot) {
+    return tipoDoComponente(&inventario->componentes[slot]);
+}
+
+static inline int inventarioValor(const Inventario *inventario, int slot) {
+    return inventario->componentes[slot].prioridade;
+}
+
+#endif
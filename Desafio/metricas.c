@@ -0,0 +1,187 @@
+#include <string.h>
+#include <time.h> // clock_gettime (relógio monotônico)
+#include "metricas.h"
+
+// Bits de sub-balde por potência de 2 (8 sub-baldes)
+#define BITS_SUBBALDE 3
+#define SUBBALDES (1 << BITS_SUBBALDE)
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Posição do bit mais significativo (valor > 0).
+ */
+static int bitMaisAlto(uint64_t valor) {
+#ifdef __GNUC__
+    return 63 - __builtin_clzll(valor);
+#else
+    int bit = 0;
+    while (valor >>= 1) bit++;
+    return bit;
+#endif
+}
+
+/**
+ * @brief Balde de uma duração: valores < 8 têm balde próprio; acima disso,
+ * o expoente escolhe a faixa e os 3 bits seguintes ao mais alto, o sub-balde.
+ */
+static int indiceBalde(uint64_t valor) {
+    if (valor < SUBBALDES) return (int)valor;
+    int expoente = bitMaisAlto(valor);
+    int subBalde = (int)((valor >> (expoente - BITS_SUBBALDE)) & (SUBBALDES - 1));
+    return (expoente - BITS_SUBBALDE + 1) * SUBBALDES + subBalde;
+}
+
+/**
+ * @brief Maior duração que cai no balde informado (inverso de indiceBalde).
+ */
+static uint64_t limiteSuperiorBalde(int indice) {
+    if (indice < SUBBALDES) return (uint64_t)indice;
+    int expoente = indice / SUBBALDES + BITS_SUBBALDE - 1;
+    uint64_t largura = (uint64_t)1 << (expoente - BITS_SUBBALDE);
+    uint64_t inicio = (uint64_t)(SUBBALDES + indice % SUBBALDES) << (expoente - BITS_SUBBALDE);
+    return inicio + (largura - 1);
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Relógio monotônico em nanossegundos.
+ */
+uint64_t metricasAgoraNs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief Zera as métricas e associa os nomes (os vetores de nomes precisam continuar válidos).
+ */
+void metricasInicializar(Metricas *metricas, const char *const *nomesOperacoes, int totalOperacoes,
+                         const char *const *nomesContadores, int totalContadores) {
+    memset(metricas, 0, sizeof(*metricas));
+    if (totalOperacoes > METRICAS_MAX_OPERACOES) totalOperacoes = METRICAS_MAX_OPERACOES;
+    if (totalContadores > METRICAS_MAX_CONTADORES) totalContadores = METRICAS_MAX_CONTADORES;
+
+    metricas->totalOperacoes = totalOperacoes;
+    for (int i = 0; i < totalOperacoes; i++) metricas->operacoes[i].nome = nomesOperacoes[i];
+    metricas->totalContadores = totalContadores;
+    for (int i = 0; i < totalContadores; i++) metricas->nomesContadores[i] = nomesContadores[i];
+}
+
+/**
+ * @brief Registra uma execução da operação com a duração medida.
+ */
+void metricasRegistrar(Metricas *metricas, int operacao, uint64_t duracaoNs) {
+    if (operacao < 0 || operacao >= metricas->totalOperacoes) return;
+    HistogramaLatencia *h = &metricas->operacoes[operacao];
+    h->amostras++;
+    h->totalNs += duracaoNs;
+    if (duracaoNs > h->maximoNs) h->maximoNs = duracaoNs;
+    h->baldes[indiceBalde(duracaoNs)]++;
+}
+
+/**
+ * @brief Soma um valor ao contador informado.
+ */
+void metricasSomar(Metricas *metricas, int contador, long long valor) {
+    if (contador < 0 || contador >= metricas->totalContadores) return;
+    metricas->contadores[contador] += valor;
+}
+
+/**
+ * @brief Acumula em destino as amostras e contadores de origem (mesmos nomes, na mesma ordem).
+ * Permite que cada thread meça sem travas e o resultado seja somado no final.
+ */
+void metricasCombinar(Metricas *destino, const Metricas *origem) {
+    for (int i = 0; i < destino->totalOperacoes && i < origem->totalOperacoes; i++) {
+        HistogramaLatencia *d = &destino->operacoes[i];
+        const HistogramaLatencia *o = &origem->operacoes[i];
+        d->amostras += o->amostras;
+        d->totalNs += o->totalNs;
+        if (o->maximoNs > d->maximoNs) d->maximoNs = o->maximoNs;
+        for (int b = 0; b < METRICAS_TOTAL_BALDES; b++) d->baldes[b] += o->baldes[b];
+    }
+    for (int i = 0; i < destino->totalContadores && i < origem->totalContadores; i++) {
+        destino->contadores[i] += origem->contadores[i];
+    }
+}
+
+/**
+ * @brief Percentil (0 < percentil <= 1) pelo método nearest-rank sobre os baldes.
+ * @return Limite superior do balde que contém a amostra (nunca acima do máximo observado),
+ *         ou 0 se não houver amostras.
+ */
+uint64_t metricasPercentil(const HistogramaLatencia *histograma, double percentil) {
+    if (histograma->amostras == 0) return 0;
+
+    long long posicao = (long long)(percentil * (double)histograma->amostras + 0.999999);
+    if (posicao < 1) posicao = 1;
+    long long acumulado = 0;
+    for (int b = 0; b < METRICAS_TOTAL_BALDES; b++) {
+        acumulado += (long long)histograma->baldes[b];
+        if (acumulado >= posicao) {
+            uint64_t limite = limiteSuperiorBalde(b);
+            return limite < histograma->maximoNs ? limite : histograma->maximoNs;
+        }
+    }
+    return histograma->maximoNs;
+}
+
+/**
+ * @brief Exibe uma tabela legível com latências (em microssegundos) e contadores.
+ */
+void metricasExibir(const Metricas *metricas) {
+    printf("\n%-22s | %10s | %10s | %10s | %10s | %10s | %10s\n",
+           "OPERACAO", "AMOSTRAS", "MEDIA(us)", "P50(us)", "P90(us)", "P99(us)", "MAX(us)");
+    printf("----------------------------------------------------------------------------------------------\n");
+    for (int i = 0; i < metricas->totalOperacoes; i++) {
+        const HistogramaLatencia *h = &metricas->operacoes[i];
+        if (h->amostras == 0) continue;
+        printf("%-22s | %10lld | %10.2f | %10.2f | %10.2f | %10.2f | %10.2f\n", h->nome, h->amostras,
+               (double)h->totalNs / (double)h->amostras / 1e3, metricasPercentil(h, 0.50) / 1e3,
+               metricasPercentil(h, 0.90) / 1e3, metricasPercentil(h, 0.99) / 1e3, h->maximoNs / 1e3);
+    }
+    printf("----------------------------------------------------------------------------------------------\n");
+    for (int i = 0; i < metricas->totalContadores; i++) {
+        printf("%-22s : %lld\n", metricas->nomesContadores[i], metricas->contadores[i]);
+    }
+}
+
+/**
+ * @brief Escreve as métricas em CSV longo ("metrica,operacao,valor"), uma medida por linha.
+ * Todas as operações aparecem (mesmo sem amostras), então o formato é estável entre execuções.
+ * @return 1 em caso de sucesso, 0 se a escrita falhar.
+ */
+int metricasExportar(const Metricas *metricas, FILE *saida) {
+    fprintf(saida, "metrica,operacao,valor\n");
+    for (int i = 0; i < metricas->totalOperacoes; i++) {
+        const HistogramaLatencia *h = &metricas->operacoes[i];
+        fprintf(saida, "amostras,%s,%lld\n", h->nome, h->amostras);
+        fprintf(saida, "total_ns,%s,%llu\n", h->nome, (unsigned long long)h->totalNs);
+        fprintf(saida, "p50_ns,%s,%llu\n", h->nome, (unsigned long long)metricasPercentil(h, 0.50));
+        fprintf(saida, "p90_ns,%s,%llu\n", h->nome, (unsigned long long)metricasPercentil(h, 0.90));
+        fprintf(saida, "p99_ns,%s,%llu\n", h->nome, (unsigned long long)metricasPercentil(h, 0.99));
+        fprintf(saida, "max_ns,%s,%llu\n", h->nome, (unsigned long long)h->maximoNs);
+    }
+    for (int i = 0; i < metricas->totalContadores; i++) {
+        fprintf(saida, "contador,%s,%lld\n", metricas->nomesContadores[i], metricas->contadores[i]);
+    }
+    return !ferror(saida);
+}
+
+/**
+ * @brief Grava o CSV das métricas no arquivo informado (NULL = não grava).
+ * @return 1 em caso de sucesso (ou caminho NULL), 0 se não for possível gravar.
+ */
+int metricasSalvar(const Metricas *metricas, const char *caminho) {
+    if (caminho == NULL) return 1;
+    FILE *arquivo = fopen(caminho, "w");
+    if (arquivo == NULL) return 0;
+    int sucesso = metricasExportar(metricas, arquivo);
+    return fclose(arquivo) == 0 && sucesso;
+}
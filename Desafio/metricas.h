@@ -0,0 +1,50 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// ---------------------------------------------
+// MÉTRICAS DE DESEMPENHO (Histogramas e Contadores)
+// ---------------------------------------------
+// Cada operação do programa tem um histograma de latência em nanossegundos
+// (relógio monotônico) com baldes logarítmicos: cada potência de 2 é dividida
+// em 8 sub-baldes, então um percentil é estimado com erro de no máximo 12,5%,
+// usando memória fixa e custo O(1) por amostra. Os contadores são de 64 bits.
+// Os nomes de operações e contadores vêm de quem usa o módulo.
+
+#define METRICAS_MAX_OPERACOES 24
+#define METRICAS_MAX_CONTADORES 8
+// 8 baldes exatos (0..7 ns) + 8 sub-baldes para cada expoente de 3 a 63
+#define METRICAS_TOTAL_BALDES 496
+
+typedef struct {
+    const char *nome;
+    long long amostras;
+    uint64_t totalNs;
+    uint64_t maximoNs;
+    uint64_t baldes[METRICAS_TOTAL_BALDES];
+} HistogramaLatencia;
+
+typedef struct {
+    HistogramaLatencia operacoes[METRICAS_MAX_OPERACOES];
+    int totalOperacoes;
+    const char *nomesContadores[METRICAS_MAX_CONTADORES];
+    long long contadores[METRICAS_MAX_CONTADORES];
+    int totalContadores;
+} Metricas;
+
+uint64_t metricasAgoraNs(void);
+
+void metricasInicializar(Metricas *metricas, const char *const *nomesOperacoes, int totalOperacoes,
+                         const char *const *nomesContadores, int totalContadores);
+void metricasRegistrar(Metricas *metricas, int operacao, uint64_t duracaoNs);
+void metricasSomar(Metricas *metricas, int contador, long long valor);
+void metricasCombinar(Metricas *destino, const Metricas *origem);
+uint64_t metricasPercentil(const HistogramaLatencia *histograma, double percentil);
+
+void metricasExibir(const Metricas *metricas);
+int metricasExportar(const Metricas *metricas, FILE *saida);
+int metricasSalvar(const Metricas *metricas, const char *caminho);
+
+#endif
@@ -0,0 +1,242 @@
+#include <stdlib.h>
+#include "multijogador.h"
+
+// Capacidade inicial da mochila de um jogador e da tabela de jogadores de uma fatia
+#define MOCHILA_CAPACIDADE_MINIMA 8
+#define FATIA_CAPACIDADE_MINIMA 16
+// Percentual de lápides que dispara a compactação de uma mochila
+#define LIMIAR_COMPACTACAO_PADRAO 25
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Espalha os bits do id (finalizador do MurmurHash3): ids sequenciais
+ * caem em fatias e posições diferentes.
+ */
+static unsigned int hashJogador(int idJogador) {
+    unsigned int h = (unsigned int)idJogador;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static FatiaJogadores *fatiaDoJogador(MotorMultijogador *motor, int idJogador) {
+    return &motor->fatias[hashJogador(idJogador) & (unsigned int)(motor->totalFatias - 1)];
+}
+
+/**
+ * @brief Posição do jogador na tabela da fatia (ou a posição vazia onde ele entraria).
+ * Os bits baixos do hash escolhem a fatia; a tabela usa os bits seguintes.
+ */
+static int posicaoNaFatia(const FatiaJogadores *fatia, int totalFatias, int idJogador) {
+    unsigned int mascara = (unsigned int)fatia->capacidade - 1;
+    unsigned int pos = (hashJogador(idJogador) / (unsigned int)totalFatias) & mascara;
+    while (fatia->jogadores[pos] != NULL && fatia->jogadores[pos]->idJogador != idJogador) {
+        pos = (pos + 1) & mascara;
+    }
+    return (int)pos;
+}
+
+/**
+ * @brief Mochila do jogador, ou NULL se ele ainda não saqueou nada (trava da fatia já obtida).
+ */
+static MochilaJogador *buscarMochila(const FatiaJogadores *fatia, int totalFatias, int idJogador) {
+    return fatia->jogadores[posicaoNaFatia(fatia, totalFatias, idJogador)];
+}
+
+/**
+ * @brief Dobra a tabela de jogadores da fatia, reposicionando as mochilas.
+ */
+static int redimensionarFatia(FatiaJogadores *fatia, int totalFatias) {
+    FatiaJogadores nova = *fatia;
+    nova.capacidade = fatia->capacidade * 2;
+    nova.jogadores = calloc((size_t)nova.capacidade, sizeof(MochilaJogador *));
+    if (nova.jogadores == NULL) return 0;
+
+    for (int i = 0; i < fatia->capacidade; i++) {
+        MochilaJogador *mochila = fatia->jogadores[i];
+        if (mochila != NULL) nova.jogadores[posicaoNaFatia(&nova, totalFatias, mochila->idJogador)] = mochila;
+    }
+    free(fatia->jogadores);
+    fatia->jogadores = nova.jogadores;
+    fatia->capacidade = nova.capacidade;
+    return 1;
+}
+
+/**
+ * @brief Mochila do jogador, criada vazia no primeiro saque (trava exclusiva da fatia já obtida).
+ * @return A mochila, ou NULL se não houver memória.
+ */
+static MochilaJogador *obterOuCriarMochila(FatiaJogadores *fatia, int totalFatias, int limiarCompactacao,
+                                           int idJogador) {
+    MochilaJogador *existente = buscarMochila(fatia, totalFatias, idJogador);
+    if (existente != NULL) return existente;
+
+    // Mantém a carga da tabela abaixo de 70%
+    if ((fatia->totalJogadores + 1) * 10 > fatia->capacidade * 7 && !redimensionarFatia(fatia, totalFatias)) return NULL;
+
+    ConfiguracaoInventario configuracao;
+    inventarioConfiguracaoPadrao(&configuracao);
+    configuracao.reservaInicial = MOCHILA_CAPACIDADE_MINIMA;
+    configuracao.limiarCompactacao = limiarCompactacao;
+    configuracao.indicesPorValor = 0;   // Só há saque, descarte e busca por nome
+
+    MochilaJogador *mochila = malloc(sizeof(MochilaJogador));
+    if (mochila == NULL) return NULL;
+    mochila->idJogador = idJogador;
+    if (!inventarioCriar(&mochila->inventario, &configuracao)) {
+        free(mochila);
+        return NULL;
+    }
+
+    fatia->jogadores[posicaoNaFatia(fatia, totalFatias, idJogador)] = mochila;
+    fatia->totalJogadores++;
+    return mochila;
+}
+
+static void liberarMochilaJogador(MochilaJogador *mochila) {
+    inventarioDestruir(&mochila->inventario);
+    free(mochila);
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Cria um motor vazio com a quantidade de fatias arredondada para potência de 2.
+ * @return 1 em caso de sucesso, 0 se não houver memória.
+ */
+int multijogadorCriar(MotorMultijogador *motor, int totalFatias) {
+    int fatias = 1;
+    while (fatias < totalFatias) fatias *= 2;
+
+    motor->fatias = calloc((size_t)fatias, sizeof(FatiaJogadores));
+    if (motor->fatias == NULL) return 0;
+    motor->totalFatias = fatias;
+    motor->limiarCompactacao = LIMIAR_COMPACTACAO_PADRAO;
+
+    for (int f = 0; f < fatias; f++) {
+        FatiaJogadores *fatia = &motor->fatias[f];
+        fatia->jogadores = calloc(FATIA_CAPACIDADE_MINIMA, sizeof(MochilaJogador *));
+        if (fatia->jogadores == NULL) {
+            motor->totalFatias = f;
+            multijogadorDestruir(motor);
+            return 0;
+        }
+        fatia->capacidade = FATIA_CAPACIDADE_MINIMA;
+        pthread_rwlock_init(&fatia->trava, NULL);
+    }
+    return 1;
+}
+
+/**
+ * @brief Libera todas as mochilas e travas (nenhuma thread pode estar usando o motor).
+ */
+void multijogadorDestruir(MotorMultijogador *motor) {
+    for (int f = 0; f < motor->totalFatias; f++) {
+        FatiaJogadores *fatia = &motor->fatias[f];
+        for (int i = 0; i < fatia->capacidade; i++) {
+            if (fatia->jogadores[i] != NULL) liberarMochilaJogador(fatia->jogadores[i]);
+        }
+        free(fatia->jogadores);
+        pthread_rwlock_destroy(&fatia->trava);
+    }
+    free(motor->fatias);
+    motor->fatias = NULL;
+    motor->totalFatias = 0;
+}
+
+/**
+ * @brief Adiciona um componente ao fim da mochila do jogador (criada no primeiro saque).
+ * @return O slot ocupado (>= 0) ou um código MULTIJOGADOR_ERRO_*.
+ */
+int multijogadorSaquear(MotorMultijogador *motor, int idJogador, const char *nome, const char *tipo, int prioridade) {
+    FatiaJogadores *fatia = fatiaDoJogador(motor, idJogador);
+    int resultado = MULTIJOGADOR_ERRO_MEMORIA;
+    pthread_rwlock_wrlock(&fatia->trava);
+
+    MochilaJogador *mochila = obterOuCriarMochila(fatia, motor->totalFatias, motor->limiarCompactacao, idJogador);
+    if (mochila != NULL) {
+        resultado = inventarioAdicionar(&mochila->inventario, nome, tipo, prioridade, NULL);
+        inventarioPrepararLeitura(&mochila->inventario);
+    }
+
+    pthread_rwlock_unlock(&fatia->trava);
+    return resultado;
+}
+
+/**
+ * @brief Descarta o componente com o nome informado (o de menor slot, se houver repetidos).
+ * O slot vira lápide; a mochila é compactada quando as lápides passam do limiar.
+ * @return O slot que o componente ocupava (>= 0), MULTIJOGADOR_ERRO_NAO_ENCONTRADO ou
+ * MULTIJOGADOR_ERRO_MEMORIA.
+ */
+int multijogadorDescartar(MotorMultijogador *motor, int idJogador, const char *nome) {
+    FatiaJogadores *fatia = fatiaDoJogador(motor, idJogador);
+    int resultado = MULTIJOGADOR_ERRO_NAO_ENCONTRADO;
+    pthread_rwlock_wrlock(&fatia->trava);
+
+    MochilaJogador *mochila = buscarMochila(fatia, motor->totalFatias, idJogador);
+    if (mochila != NULL) {
+        resultado = inventarioRemover(&mochila->inventario, nome);
+        // A compactação automática deixa o índice de nomes pendente: ele é refeito aqui
+        inventarioPrepararLeitura(&mochila->inventario);
+    }
+
+    pthread_rwlock_unlock(&fatia->trava);
+    return resultado;
+}
+
+/**
+ * @brief Busca exata por nome na mochila do jogador (trava compartilhada: buscas rodam em paralelo).
+ * @param copia Recebe o componente encontrado (pode ser NULL); a cópia continua válida
+ *              depois que outras threads alteram a mochila, mas o deslocamento do nome
+ *              só vale na arena da mochila (o nome é o próprio texto buscado).
+ * @return O slot do componente (>= 0), MULTIJOGADOR_ERRO_NAO_ENCONTRADO ou
+ * MULTIJOGADOR_ERRO_MEMORIA (o índice não pôde ser refeito na última alteração).
+ */
+int multijogadorBuscar(MotorMultijogador *motor, int idJogador, const char *nome, Componente *copia) {
+    FatiaJogadores *fatia = fatiaDoJogador(motor, idJogador);
+    pthread_rwlock_rdlock(&fatia->trava);
+
+    const MochilaJogador *mochila = buscarMochila(fatia, motor->totalFatias, idJogador);
+    int slot = mochila != NULL ? inventarioBuscarLeitura(&mochila->inventario, nome) : MULTIJOGADOR_ERRO_NAO_ENCONTRADO;
+    if (slot >= 0 && copia != NULL) *copia = mochila->inventario.componentes[slot];
+
+    pthread_rwlock_unlock(&fatia->trava);
+    return slot;
+}
+
+/**
+ * @brief Quantidade de componentes vivos na mochila do jogador (0 se ele não existir).
+ */
+int multijogadorContar(MotorMultijogador *motor, int idJogador) {
+    FatiaJogadores *fatia = fatiaDoJogador(motor, idJogador);
+    pthread_rwlock_rdlock(&fatia->trava);
+    const MochilaJogador *mochila = buscarMochila(fatia, motor->totalFatias, idJogador);
+    int total = mochila != NULL ? mochila->inventario.totalComponentes : 0;
+    pthread_rwlock_unlock(&fatia->trava);
+    return total;
+}
+
+/**
+ * @brief Soma dos componentes vivos de todos os jogadores (uma fatia travada por vez).
+ */
+long long multijogadorTotalComponentes(MotorMultijogador *motor) {
+    long long total = 0;
+    for (int f = 0; f < motor->totalFatias; f++) {
+        FatiaJogadores *fatia = &motor->fatias[f];
+        pthread_rwlock_rdlock(&fatia->trava);
+        for (int i = 0; i < fatia->capacidade; i++) {
+            if (fatia->jogadores[i] != NULL) total += fatia->jogadores[i]->inventario.totalComponentes;
+        }
+        pthread_rwlock_unlock(&fatia->trava);
+    }
+    return total;
+}
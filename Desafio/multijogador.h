@@ -0,0 +1,59 @@
+#ifndef MULTIJOGADOR_H
+#define MULTIJOGADOR_H
+
+#include <pthread.h>
+#include "inventario.h"
+
+// ---------------------------------------------
+// MOTOR MULTIJOGADOR (Inventários com Travas Fatiadas)
+// ---------------------------------------------
+// Guarda uma mochila independente para cada jogador (identificado por um id).
+// Os jogadores são distribuídos entre fatias (shards) pelo hash do id, e cada
+// fatia tem sua própria trava de leitura/escrita: threads que mexem em jogadores
+// de fatias diferentes nunca se esperam, e buscas na mesma fatia rodam juntas
+// (só saquear e descartar pegam a trava exclusiva).
+// Cada mochila é um Inventario (inventario.h) com as regras do nível Mestre, sem
+// baldes por valor nem fila de montagem: vetor dinâmico com lápides, arena de
+// nomes, índice hash de nomes e compactação vêm todos da biblioteca. Toda
+// alteração deixa o índice de nomes pronto (inventarioPrepararLeitura) ainda com
+// a trava exclusiva, para que as buscas sob a trava compartilhada não alterem nada.
+// Os tipos não são por jogador: todas as mochilas dividem os TIPOS_DISTINTOS_MAX
+// ids do dicionário do processo (MULTIJOGADOR_ERRO_TIPOS_ESGOTADOS vale para todos).
+
+// Resultados das operações (valores >= 0 são slots): os mesmos da biblioteca
+#define MULTIJOGADOR_ERRO_MEMORIA INVENTARIO_ERRO_MEMORIA
+#define MULTIJOGADOR_ERRO_PRIORIDADE INVENTARIO_ERRO_VALOR
+#define MULTIJOGADOR_ERRO_NOME_INVALIDO INVENTARIO_ERRO_NOME_INVALIDO
+#define MULTIJOGADOR_ERRO_NAO_ENCONTRADO INVENTARIO_ERRO_NAO_ENCONTRADO
+#define MULTIJOGADOR_ERRO_TIPOS_ESGOTADOS INVENTARIO_ERRO_TIPOS_ESGOTADOS
+
+// Mochila de um jogador (alocada uma vez: o Inventario não pode ser movido)
+typedef struct {
+    int idJogador;
+    Inventario inventario;
+} MochilaJogador;
+
+// Fatia: tabela de jogadores (endereçamento aberto por id) e a trava que a protege
+typedef struct {
+    pthread_rwlock_t trava;
+    MochilaJogador **jogadores;   // NULL = posição vazia
+    int capacidade;               // Potência de 2
+    int totalJogadores;
+} FatiaJogadores;
+
+typedef struct {
+    FatiaJogadores *fatias;
+    int totalFatias;              // Potência de 2
+    int limiarCompactacao;        // Percentual de lápides que dispara a compactação
+} MotorMultijogador;
+
+int multijogadorCriar(MotorMultijogador *motor, int totalFatias);
+void multijogadorDestruir(MotorMultijogador *motor);
+
+int multijogadorSaquear(MotorMultijogador *motor, int idJogador, const char *nome, const char *tipo, int prioridade);
+int multijogadorDescartar(MotorMultijogador *motor, int idJogador, const char *nome);
+int multijogadorBuscar(MotorMultijogador *motor, int idJogador, const char *nome, Componente *copia);
+int multijogadorContar(MotorMultijogador *motor, int idJogador);
+long long multijogadorTotalComponentes(MotorMultijogador *motor);
+
+#endif
@@ -0,0 +1,894 @@
+#include <stdio.h> // snprintf (texto da ordem composta)
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ordenacao.h"
+#include "prefixo_chave.h"
+#include "dicionario_tipos.h"
+
+// Abaixo deste tamanho, Introsort e Merge Sort delegam para o Insertion Sort
+#define LIMIAR_INSERCAO 16
+
+// Acesso ao i-ésimo elemento de um vetor genérico
+#define ELEMENTO(base, i) ((char *)(base) + (size_t)(i) * motor->tamanho)
+
+// Estado interno de uma execução do motor
+typedef struct {
+    const DescritorOrdenacao *descritor;
+    EstatisticasOrdenacao *estatisticas;
+    size_t tamanho;
+    char *temporario;   // Espaço para um elemento (trocas e chave do Insertion Sort)
+    char *pivo;         // Cópia do pivô do Introsort
+} Motor;
+
+// Nomes de exibição e identificadores curtos (usados em argumentos e arquivos)
+static const char *NOMES_ALGORITMOS[TOTAL_ALGORITMOS] = {
+    "Bubble Sort", "Insertion Sort", "Selection Sort", "Introsort", "Merge Sort", "Radix Sort (LSD)",
+    "Counting Sort"
+};
+static const char *IDS_ALGORITMOS[TOTAL_ALGORITMOS] = {
+    "bubble", "insertion", "selection", "introsort", "mergesort", "radix", "counting"
+};
+static const char *NOMES_CRITERIOS[TOTAL_CRITERIOS] = { "nome", "tipo", "prioridade" };
+
+// ---------------------------------------------
+// FUNÇÕES AUXILIARES
+// ---------------------------------------------
+
+static int comparar(Motor *motor, const void *a, const void *b) {
+    motor->estatisticas->comparacoes++;
+    return motor->descritor->comparar(a, b, motor->descritor->contexto);
+}
+
+static void trocarElementos(Motor *motor, void *a, void *b) {
+    memcpy(motor->temporario, a, motor->tamanho);
+    memcpy(a, b, motor->tamanho);
+    memcpy(b, motor->temporario, motor->tamanho);
+    motor->estatisticas->trocas++;
+}
+
+// ---------------------------------------------
+// ALGORITMOS QUADRÁTICOS (versões originais, para comparação)
+// ---------------------------------------------
+
+/**
+ * @brief Bubble Sort idêntico ao original (n-1 passadas completas).
+ */
+static void bubbleSort(Motor *motor, char *v, size_t n) {
+    for (size_t i = 0; i + 1 < n; i++) {
+        for (size_t j = 0; j + 1 < n - i; j++) {
+            if (comparar(motor, ELEMENTO(v, j), ELEMENTO(v, j + 1)) > 0) {
+                trocarElementos(motor, ELEMENTO(v, j), ELEMENTO(v, j + 1));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Insertion Sort (estável). Também usado nos trechos pequenos dos algoritmos O(n log n).
+ */
+static void insertionSort(Motor *motor, char *v, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        memcpy(motor->temporario, ELEMENTO(v, i), motor->tamanho);
+        size_t j = i;
+
+        while (j > 0 && comparar(motor, ELEMENTO(v, j - 1), motor->temporario) > 0) {
+            memcpy(ELEMENTO(v, j), ELEMENTO(v, j - 1), motor->tamanho);
+            motor->estatisticas->trocas++;
+            j--;
+        }
+        if (j != i) {
+            memcpy(ELEMENTO(v, j), motor->temporario, motor->tamanho);
+            motor->estatisticas->trocas++;
+        }
+    }
+}
+
+/**
+ * @brief Selection Sort idêntico ao original (uma troca por passada, se necessária).
+ */
+static void selectionSort(Motor *motor, char *v, size_t n) {
+    for (size_t i = 0; i + 1 < n; i++) {
+        size_t menor = i;
+        for (size_t j = i + 1; j < n; j++) {
+            if (comparar(motor, ELEMENTO(v, j), ELEMENTO(v, menor)) < 0) {
+                menor = j;
+            }
+        }
+        if (menor != i) {
+            trocarElementos(motor, ELEMENTO(v, menor), ELEMENTO(v, i));
+        }
+    }
+}
+
+// ---------------------------------------------
+// INTROSORT (Quicksort com fallback para Heapsort)
+// ---------------------------------------------
+
+static void descerHeap(Motor *motor, char *v, size_t raiz, size_t n) {
+    for (;;) {
+        size_t filho = 2 * raiz + 1;
+        if (filho >= n) return;
+        if (filho + 1 < n && comparar(motor, ELEMENTO(v, filho), ELEMENTO(v, filho + 1)) < 0) {
+            filho++;
+        }
+        if (comparar(motor, ELEMENTO(v, raiz), ELEMENTO(v, filho)) >= 0) return;
+        trocarElementos(motor, ELEMENTO(v, raiz), ELEMENTO(v, filho));
+        raiz = filho;
+    }
+}
+
+static void heapSort(Motor *motor, char *v, size_t n) {
+    for (size_t i = n / 2; i > 0; i--) descerHeap(motor, v, i - 1, n);
+    for (size_t fim = n - 1; fim > 0; fim--) {
+        trocarElementos(motor, ELEMENTO(v, 0), ELEMENTO(v, fim));
+        descerHeap(motor, v, 0, fim);
+    }
+}
+
+/**
+ * @brief Particionamento de Hoare com pivô pela mediana de três.
+ * @return Quantidade de elementos da partição esquerda (sempre entre 1 e n-1).
+ */
+static size_t particionar(Motor *motor, char *v, size_t n) {
+    size_t meio = n / 2;
+
+    // Mediana de três: garante v[0] <= v[meio] <= v[n-1] (sentinelas das varreduras)
+    if (comparar(motor, ELEMENTO(v, meio), ELEMENTO(v, 0)) < 0) trocarElementos(motor, ELEMENTO(v, meio), ELEMENTO(v, 0));
+    if (comparar(motor, ELEMENTO(v, n - 1), ELEMENTO(v, meio)) < 0) {
+        trocarElementos(motor, ELEMENTO(v, n - 1), ELEMENTO(v, meio));
+        if (comparar(motor, ELEMENTO(v, meio), ELEMENTO(v, 0)) < 0) trocarElementos(motor, ELEMENTO(v, meio), ELEMENTO(v, 0));
+    }
+    memcpy(motor->pivo, ELEMENTO(v, meio), motor->tamanho);
+
+    size_t i = 0, j = n - 1;
+    for (;;) {
+        do { i++; } while (comparar(motor, ELEMENTO(v, i), motor->pivo) < 0);
+        do { j--; } while (comparar(motor, motor->pivo, ELEMENTO(v, j)) < 0);
+        if (i >= j) return j + 1;
+        trocarElementos(motor, ELEMENTO(v, i), ELEMENTO(v, j));
+    }
+}
+
+static void introsortRecursivo(Motor *motor, char *v, size_t n, int profundidade) {
+    while (n > LIMIAR_INSERCAO) {
+        if (profundidade == 0) {
+            heapSort(motor, v, n);
+            return;
+        }
+        profundidade--;
+
+        size_t esquerda = particionar(motor, v, n);
+        // Recursão na menor parte e laço na maior: pilha limitada a O(log n)
+        if (esquerda < n - esquerda) {
+            introsortRecursivo(motor, v, esquerda, profundidade);
+            v = ELEMENTO(v, esquerda);
+            n -= esquerda;
+        } else {
+            introsortRecursivo(motor, ELEMENTO(v, esquerda), n - esquerda, profundidade);
+            n = esquerda;
+        }
+    }
+    insertionSort(motor, v, n);
+}
+
+static void introsort(Motor *motor, char *v, size_t n) {
+    int profundidade = 0;
+    for (size_t k = n; k > 1; k >>= 1) profundidade += 2; // 2 * log2(n)
+    introsortRecursivo(motor, v, n, profundidade);
+}
+
+// ---------------------------------------------
+// MERGE SORT (estável)
+// ---------------------------------------------
+
+static void mergeSortRecursivo(Motor *motor, char *v, char *auxiliar, size_t n) {
+    if (n <= LIMIAR_INSERCAO) {
+        insertionSort(motor, v, n);
+        return;
+    }
+
+    size_t meio = n / 2;
+    mergeSortRecursivo(motor, v, auxiliar, meio);
+    mergeSortRecursivo(motor, ELEMENTO(v, meio), auxiliar, n - meio);
+
+    // As duas metades já estão em ordem entre si: nada a intercalar
+    if (comparar(motor, ELEMENTO(v, meio - 1), ELEMENTO(v, meio)) <= 0) return;
+
+    // Copia só a metade esquerda; a escrita em v nunca alcança a leitura da direita
+    memcpy(auxiliar, v, meio * motor->tamanho);
+    size_t i = 0, j = meio, k = 0;
+    while (i < meio && j < n) {
+        // "<=" mantém a estabilidade: em empate, o elemento da esquerda vem primeiro
+        if (comparar(motor, ELEMENTO(auxiliar, i), ELEMENTO(v, j)) <= 0) {
+            memcpy(ELEMENTO(v, k++), ELEMENTO(auxiliar, i++), motor->tamanho);
+        } else {
+            memcpy(ELEMENTO(v, k++), ELEMENTO(v, j++), motor->tamanho);
+        }
+        motor->estatisticas->trocas++;
+    }
+    if (i < meio) {
+        memcpy(ELEMENTO(v, k), ELEMENTO(auxiliar, i), (meio - i) * motor->tamanho);
+        motor->estatisticas->trocas += (long long)(meio - i);
+    }
+}
+
+static int mergeSort(Motor *motor, char *v, size_t n) {
+    char *auxiliar = malloc((n / 2 + 1) * motor->tamanho);
+    if (auxiliar == NULL) return 0;
+    mergeSortRecursivo(motor, v, auxiliar, n);
+    free(auxiliar);
+    return 1;
+}
+
+// ---------------------------------------------
+// RADIX SORT LSD (estável, sem comparações)
+// ---------------------------------------------
+
+/**
+ * @brief Radix Sort LSD em base 256 sobre a chave inteira de cada elemento.
+ * Passadas em que todos os elementos têm o mesmo byte são puladas
+ * (para prioridade 1..10, apenas uma passada é executada).
+ */
+static int radixSort(Motor *motor, char *v, size_t n) {
+    const DescritorOrdenacao *d = motor->descritor;
+    char *auxiliar = malloc(n * motor->tamanho);
+    unsigned int *chaves = malloc(n * sizeof(unsigned int));
+    unsigned int *chavesAux = malloc(n * sizeof(unsigned int));
+    if (auxiliar == NULL || chaves == NULL || chavesAux == NULL) {
+        free(auxiliar);
+        free(chaves);
+        free(chavesAux);
+        return 0;
+    }
+
+    for (size_t i = 0; i < n; i++) chaves[i] = d->chaveInteira(ELEMENTO(v, i), d->contexto);
+
+    char *origem = v, *destino = auxiliar;
+    for (int deslocamento = 0; deslocamento < 32; deslocamento += 8) {
+        size_t contagem[256] = {0};
+        for (size_t i = 0; i < n; i++) contagem[(chaves[i] >> deslocamento) & 0xFF]++;
+        if (contagem[chaves[0] >> deslocamento & 0xFF] == n) continue; // Byte igual em todos
+
+        // Soma de prefixos: posição inicial de cada balde
+        size_t posicao = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t qtd = contagem[b];
+            contagem[b] = posicao;
+            posicao += qtd;
+        }
+        for (size_t i = 0; i < n; i++) {
+            size_t p = contagem[(chaves[i] >> deslocamento) & 0xFF]++;
+            memcpy(ELEMENTO(destino, p), ELEMENTO(origem, i), motor->tamanho);
+            chavesAux[p] = chaves[i];
+        }
+        motor->estatisticas->trocas += (long long)n;
+
+        char *t = origem; origem = destino; destino = t;
+        unsigned int *tc = chaves; chaves = chavesAux; chavesAux = tc;
+    }
+    if (origem != v) memcpy(v, origem, n * motor->tamanho);
+
+    free(origem == v ? destino : origem);
+    free(chaves);
+    free(chavesAux);
+    return 1;
+}
+
+// ---------------------------------------------
+// COUNTING SORT (estável, sem comparações)
+// ---------------------------------------------
+
+/**
+ * @brief Counting Sort sobre chaves no intervalo 0..chaveMaxima.
+ * Uma passada para contar, uma para espalhar os elementos no auxiliar e uma cópia de volta.
+ */
+static int countingSort(Motor *motor, char *v, size_t n) {
+    const DescritorOrdenacao *d = motor->descritor;
+    size_t baldes = (size_t)d->chaveMaxima + 1;
+    char *auxiliar = malloc(n * motor->tamanho);
+    unsigned int *chaves = malloc(n * sizeof(unsigned int));
+    size_t *contagem = calloc(baldes, sizeof(size_t));
+    if (auxiliar == NULL || chaves == NULL || contagem == NULL) {
+        free(auxiliar);
+        free(chaves);
+        free(contagem);
+        return 0;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        chaves[i] = d->chaveInteira(ELEMENTO(v, i), d->contexto);
+        if (chaves[i] > d->chaveMaxima) {
+            // Chave fora do intervalo declarado: o vetor fica intacto
+            free(auxiliar);
+            free(chaves);
+            free(contagem);
+            return 0;
+        }
+        contagem[chaves[i]]++;
+    }
+
+    // Soma de prefixos: posição inicial de cada chave
+    size_t posicao = 0;
+    for (size_t b = 0; b < baldes; b++) {
+        size_t qtd = contagem[b];
+        contagem[b] = posicao;
+        posicao += qtd;
+    }
+    for (size_t i = 0; i < n; i++) {
+        memcpy(ELEMENTO(auxiliar, contagem[chaves[i]]++), ELEMENTO(v, i), motor->tamanho);
+    }
+    memcpy(v, auxiliar, n * motor->tamanho);
+    motor->estatisticas->trocas += (long long)n;
+
+    free(auxiliar);
+    free(chaves);
+    free(contagem);
+    return 1;
+}
+
+// ---------------------------------------------
+// INTERFACE PÚBLICA DO MOTOR
+// ---------------------------------------------
+
+const char *nomeAlgoritmo(AlgoritmoOrdenacao algoritmo) {
+    return (algoritmo >= 0 && algoritmo < TOTAL_ALGORITMOS) ? NOMES_ALGORITMOS[algoritmo] : "?";
+}
+
+const char *idAlgoritmo(AlgoritmoOrdenacao algoritmo) {
+    return (algoritmo >= 0 && algoritmo < TOTAL_ALGORITMOS) ? IDS_ALGORITMOS[algoritmo] : "?";
+}
+
+const char *nomeCriterio(CriterioOrdenacao criterio) {
+    return (criterio >= 0 && criterio < TOTAL_CRITERIOS) ? NOMES_CRITERIOS[criterio] : "?";
+}
+
+/**
+ * @brief Converte um identificador curto ("introsort", "radix"...) no algoritmo.
+ * @return 1 se o nome for reconhecido, 0 caso contrário.
+ */
+int algoritmoPorNome(const char *nome, AlgoritmoOrdenacao *algoritmo) {
+    for (int i = 0; i < TOTAL_ALGORITMOS; i++) {
+        if (strcmp(nome, IDS_ALGORITMOS[i]) == 0) {
+            *algoritmo = (AlgoritmoOrdenacao)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Converte "nome", "tipo" ou "prioridade" no critério correspondente.
+ */
+int criterioPorNome(const char *nome, CriterioOrdenacao *criterio) {
+    for (int i = 0; i < TOTAL_CRITERIOS; i++) {
+        if (strcmp(nome, NOMES_CRITERIOS[i]) == 0) {
+            *criterio = (CriterioOrdenacao)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Radix e Counting Sort precisam de uma chave inteira: valem para a prioridade
+ * e para o tipo (posto no dicionário de tipos), não para o nome.
+ */
+int algoritmoSuportaCriterio(AlgoritmoOrdenacao algoritmo, CriterioOrdenacao criterio) {
+    if (algoritmo == ALGORITMO_RADIX || algoritmo == ALGORITMO_CONTAGEM) {
+        return criterio == CRITERIO_TIPO || criterio == CRITERIO_PRIORIDADE;
+    }
+    return algoritmo >= 0 && algoritmo < TOTAL_ALGORITMOS;
+}
+
+/**
+ * @brief Ordena um vetor genérico com o algoritmo escolhido, medindo o desempenho.
+ * @return 1 em caso de sucesso, 0 se o algoritmo não se aplica ao descritor
+ *         ou se faltar memória (o vetor fica inalterado nesses casos).
+ */
+int ordenarVetor(void *base, size_t total, const DescritorOrdenacao *descritor,
+                 AlgoritmoOrdenacao algoritmo, EstatisticasOrdenacao *estatisticas) {
+    estatisticas->comparacoes = 0;
+    estatisticas->trocas = 0;
+    estatisticas->tempoSegundos = 0.0;
+    estatisticas->acertosPrefixo = 0;
+    estatisticas->desempatesTexto = 0;
+
+    if (algoritmo == ALGORITMO_RADIX || algoritmo == ALGORITMO_CONTAGEM) {
+        if (descritor->chaveInteira == NULL) return 0;
+        if (algoritmo == ALGORITMO_CONTAGEM && descritor->chaveMaxima == 0) return 0;
+    } else if (descritor->comparar == NULL) {
+        return 0;
+    }
+    if (total <= 1) return 1;
+
+    Motor motorLocal = { descritor, estatisticas, descritor->tamanho, NULL, NULL };
+    Motor *motor = &motorLocal;
+    motor->temporario = malloc(2 * motor->tamanho);
+    if (motor->temporario == NULL) return 0;
+    motor->pivo = motor->temporario + motor->tamanho;
+
+    int sucesso = 1;
+    clock_t inicio = clock();
+
+    switch (algoritmo) {
+        case ALGORITMO_BOLHA:     bubbleSort(motor, base, total); break;
+        case ALGORITMO_INSERCAO:  insertionSort(motor, base, total); break;
+        case ALGORITMO_SELECAO:   selectionSort(motor, base, total); break;
+        case ALGORITMO_INTROSORT: introsort(motor, base, total); break;
+        case ALGORITMO_MERGESORT: sucesso = mergeSort(motor, base, total); break;
+        case ALGORITMO_RADIX:     sucesso = radixSort(motor, base, total); break;
+        case ALGORITMO_CONTAGEM:  sucesso = countingSort(motor, base, total); break;
+        default:                  sucesso = 0;
+    }
+
+    estatisticas->tempoSegundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    free(motor->temporario);
+    return sucesso;
+}
+
+// ---------------------------------------------
+// CRITÉRIOS PARA O VETOR DE COMPONENTES
+// ---------------------------------------------
+
+/**
+ * @brief Compara dois textos pelo prefixo e registra nas estatísticas (se houver) como a comparação foi resolvida.
+ */
+static int compararTextoContado(uint64_t prefixoA, const char *a, uint64_t prefixoB, const char *b,
+                                EstatisticasOrdenacao *estatisticas) {
+    if (estatisticas == NULL) return compararComPrefixo(prefixoA, a, prefixoB, b, NULL, NULL);
+    return compararComPrefixo(prefixoA, a, prefixoB, b, &estatisticas->acertosPrefixo, &estatisticas->desempatesTexto);
+}
+
+static int compararPorNome(const void *a, const void *b, void *contexto) {
+    const Componente *ca = a, *cb = b;
+    const ContextoComponentes *ctx = contexto;
+    return compararTextoContado(ca->prefixoNome, nomeNaArena(ctx->nomes, ca), cb->prefixoNome,
+                                nomeNaArena(ctx->nomes, cb), ctx->estatisticas);
+}
+
+// Tipos internados: a ordem alfabética é a dos postos (da cópia no contexto), sem tocar nos textos
+static int compararPorTipo(const void *a, const void *b, void *contexto) {
+    const ContextoComponentes *ctx = contexto;
+    unsigned int pa = postoDoTipo(ctx->postos, ((const Componente *)a)->idTipo);
+    unsigned int pb = postoDoTipo(ctx->postos, ((const Componente *)b)->idTipo);
+    return (pa > pb) - (pa < pb);
+}
+
+static unsigned int chaveTipo(const void *elemento, void *contexto) {
+    const ContextoComponentes *ctx = contexto;
+    return postoDoTipo(ctx->postos, ((const Componente *)elemento)->idTipo);
+}
+
+static int compararPorPrioridade(const void *a, const void *b, void *contexto) {
+    (void)contexto;
+    int pa = ((const Componente *)a)->prioridade;
+    int pb = ((const Componente *)b)->prioridade;
+    return (pa > pb) - (pa < pb);
+}
+
+static unsigned int chavePrioridade(const void *elemento, void *contexto) {
+    (void)contexto;
+    return (unsigned int)((const Componente *)elemento)->prioridade;
+}
+
+/**
+ * @brief Maior posto possível de um tipo na cópia (nunca 0, que o Counting Sort lê como "desconhecida").
+ */
+static unsigned int chaveMaximaTipo(const PostosTipos *postos) {
+    return postos->total > 1 ? (unsigned int)(postos->total - 1) : 1u;
+}
+
+/**
+ * @brief Preenche o descritor (comparação e chave inteira) de um critério sobre Componente.
+ * O contexto fica NULL e precisa ser apontado para um ContextoComponentes com a mesma
+ * cópia de postos (a comparação por nome lê os textos na arena dele, a por tipo os postos).
+ * @return 1 em caso de sucesso, 0 se o critério for inválido.
+ */
+int descritorComponentes(CriterioOrdenacao criterio, const PostosTipos *postos, DescritorOrdenacao *descritor) {
+    DescritorOrdenacao padrao = { sizeof(Componente), NULL, NULL, NULL, 0 };
+    *descritor = padrao;
+
+    switch (criterio) {
+        case CRITERIO_NOME:       descritor->comparar = compararPorNome; break;
+        case CRITERIO_TIPO:
+            descritor->comparar = compararPorTipo;
+            descritor->chaveInteira = chaveTipo;
+            descritor->chaveMaxima = chaveMaximaTipo(postos);
+            break;
+        case CRITERIO_PRIORIDADE:
+            descritor->comparar = compararPorPrioridade;
+            descritor->chaveInteira = chavePrioridade;
+            descritor->chaveMaxima = PRIORIDADE_MAX;
+            break;
+        default:
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Ordena os componentes pelo critério informado (ordem crescente).
+ * @return 1 em caso de sucesso, 0 se a combinação algoritmo/critério for inválida ou faltar memória.
+ */
+int ordenarComponentes(Componente *componentes, int total, const ArenaNomes *nomes, CriterioOrdenacao criterio,
+                       AlgoritmoOrdenacao algoritmo, EstatisticasOrdenacao *estatisticas) {
+    PostosTipos postos;
+    dicionarioTiposCopiarPostos(&postos);
+    DescritorOrdenacao descritor;
+    if (!descritorComponentes(criterio, &postos, &descritor)) return 0;
+    if (!algoritmoSuportaCriterio(algoritmo, criterio)) return 0;
+    ContextoComponentes contexto = { nomes, estatisticas, &postos };
+    descritor.contexto = &contexto;
+
+    return ordenarVetor(componentes, (size_t)(total > 0 ? total : 0), &descritor, algoritmo, estatisticas);
+}
+
+// ---------------------------------------------
+// ORDENAÇÃO INDIRETA (PERMUTAÇÃO DE ÍNDICES)
+// ---------------------------------------------
+
+// Entrada compacta ordenada no lugar do Componente: a chave fica em cache
+// (prefixo do nome mais o ponteiro para o nome completo, ou a chave inteira
+// do tipo/prioridade) e o slot de origem acompanha a chave.
+typedef struct {
+    uint64_t prefixo;     // Prefixo do nome, posto do tipo ou prioridade
+    const char *texto;    // Nome completo (NULL para tipo e prioridade)
+    int slot;
+} EntradaPermutacao;
+
+static int compararEntradasTexto(const void *a, const void *b, void *contexto) {
+    const EntradaPermutacao *ea = a, *eb = b;
+    return compararTextoContado(ea->prefixo, ea->texto, eb->prefixo, eb->texto, contexto);
+}
+
+static int compararEntradasNumero(const void *a, const void *b, void *contexto) {
+    (void)contexto;
+    uint64_t na = ((const EntradaPermutacao *)a)->prefixo;
+    uint64_t nb = ((const EntradaPermutacao *)b)->prefixo;
+    return (na > nb) - (na < nb);
+}
+
+static unsigned int chaveEntradaNumero(const void *elemento, void *contexto) {
+    (void)contexto;
+    return (unsigned int)((const EntradaPermutacao *)elemento)->prefixo;
+}
+
+/**
+ * @brief Calcula a ordem dos componentes sem mover nenhuma struct.
+ * Só entram os slots vivos (lápides são ignoradas). Ao final, permutacao[k] é o slot
+ * do componente que ocupa a k-ésima posição na ordem do critério.
+ * @param permutacao Vetor com espaço para totalSlots inteiros.
+ * @return Quantidade de posições preenchidas, ou -1 se a combinação for inválida ou faltar memória.
+ */
+int ordenarPermutacaoComponentes(const Componente *componentes, int totalSlots, const ArenaNomes *nomes,
+                                 CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo, int *permutacao, EstatisticasOrdenacao *estatisticas) {
+    if (!algoritmoSuportaCriterio(algoritmo, criterio) || criterio < 0 || criterio >= TOTAL_CRITERIOS) return -1;
+
+    clock_t inicio = clock();
+    EntradaPermutacao *entradas = malloc((size_t)(totalSlots > 0 ? totalSlots : 1) * sizeof(EntradaPermutacao));
+    if (entradas == NULL) return -1;
+    PostosTipos postos;
+    dicionarioTiposCopiarPostos(&postos);
+
+    int total = 0;
+    for (int slot = 0; slot < totalSlots; slot++) {
+        const Componente *c = &componentes[slot];
+        if (COMPONENTE_REMOVIDO(c)) continue;
+        switch (criterio) {
+            case CRITERIO_NOME:
+                entradas[total].prefixo = c->prefixoNome;
+                entradas[total].texto = nomeNaArena(nomes, c);
+                break;
+            case CRITERIO_TIPO:
+                entradas[total].prefixo = postoDoTipo(&postos, c->idTipo);
+                entradas[total].texto = NULL;
+                break;
+            default:
+                entradas[total].prefixo = (uint64_t)c->prioridade;
+                entradas[total].texto = NULL;
+                break;
+        }
+        entradas[total].slot = slot;
+        total++;
+    }
+
+    DescritorOrdenacao descritor = { sizeof(EntradaPermutacao), compararEntradasTexto, NULL, estatisticas, 0 };
+    if (criterio != CRITERIO_NOME) {
+        descritor.comparar = compararEntradasNumero;
+        descritor.chaveInteira = chaveEntradaNumero;
+        descritor.chaveMaxima = criterio == CRITERIO_TIPO ? chaveMaximaTipo(&postos) : PRIORIDADE_MAX;
+    }
+
+    if (!ordenarVetor(entradas, (size_t)total, &descritor, algoritmo, estatisticas)) {
+        free(entradas);
+        return -1;
+    }
+    for (int k = 0; k < total; k++) permutacao[k] = entradas[k].slot;
+    free(entradas);
+
+    // O tempo inclui a montagem das entradas e a extração da permutação
+    estatisticas->tempoSegundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    return total;
+}
+
+/**
+ * @brief Reorganiza o vetor segundo a permutação (base[k] passa a ser o antigo base[permutacao[k]]).
+ * Segue os ciclos da permutação: cada elemento é movido uma única vez, com um só temporário.
+ * @return Quantidade de elementos movidos, ou -1 se faltar memória.
+ */
+long long aplicarPermutacao(void *base, size_t total, size_t tamanho, const int *permutacao) {
+    char *v = base;
+    char *temporario = malloc(tamanho);
+    unsigned char *visitado = calloc(total > 0 ? total : 1, 1);
+    if (temporario == NULL || visitado == NULL) {
+        free(temporario);
+        free(visitado);
+        return -1;
+    }
+
+    long long movimentos = 0;
+    for (size_t inicio = 0; inicio < total; inicio++) {
+        if (visitado[inicio] || (size_t)permutacao[inicio] == inicio) continue;
+
+        memcpy(temporario, v + inicio * tamanho, tamanho);
+        size_t atual = inicio;
+        for (;;) {
+            size_t origem = (size_t)permutacao[atual];
+            visitado[atual] = 1;
+            if (origem == inicio) {
+                memcpy(v + atual * tamanho, temporario, tamanho);
+                movimentos++;
+                break;
+            }
+            memcpy(v + atual * tamanho, v + origem * tamanho, tamanho);
+            movimentos++;
+            atual = origem;
+        }
+    }
+
+    free(temporario);
+    free(visitado);
+    return movimentos;
+}
+
+// ---------------------------------------------
+// ORDENAÇÃO COMPOSTA (CHAVES DE BYTES CODIFICADAS)
+// ---------------------------------------------
+// Cada componente vivo ganha uma chave de largura fixa em que os campos aparecem
+// na ordem pedida, cada um codificado para que memcmp ordene como o critério:
+//   tipo       -> posto no dicionário, 2 bytes big-endian
+//   prioridade -> valor com o bit de sinal invertido, 4 bytes big-endian
+//   nome       -> os bytes do nome completados com zeros até o maior nome do vetor
+//                 (um nome que é prefixo de outro fica antes, como no strcmp)
+// Um campo decrescente tem todos os bytes complementados. Assim uma única
+// ordenação estável da chave substitui as ordenações encadeadas por critério.
+
+// Entrada da ordenação composta por comparação: a chave e o slot de origem
+typedef struct {
+    const unsigned char *chave;
+    int slot;
+} EntradaComposta;
+
+/**
+ * @brief Converte "tipo,-prioridade,nome" na ordem composta ('-' = decrescente, '+' opcional).
+ * @return 1 se o texto for válido (cada critério no máximo uma vez), 0 caso contrário.
+ */
+int ordemCompostaPorTexto(const char *texto, OrdemComposta *ordem) {
+    ordem->totalCampos = 0;
+    const char *parte = texto;
+    for (;;) {
+        const char *fim = strchr(parte, ',');
+        size_t tamanho = fim != NULL ? (size_t)(fim - parte) : strlen(parte);
+        int decrescente = 0;
+        if (tamanho > 0 && (parte[0] == '-' || parte[0] == '+')) {
+            decrescente = parte[0] == '-';
+            parte++;
+            tamanho--;
+        }
+
+        char nome[16];
+        CriterioOrdenacao criterio;
+        if (tamanho == 0 || tamanho >= sizeof(nome) || ordem->totalCampos == TOTAL_CRITERIOS) return 0;
+        memcpy(nome, parte, tamanho);
+        nome[tamanho] = '\0';
+        if (!criterioPorNome(nome, &criterio)) return 0;
+        for (int i = 0; i < ordem->totalCampos; i++) {
+            if (ordem->campos[i].criterio == criterio) return 0;
+        }
+        ordem->campos[ordem->totalCampos].criterio = criterio;
+        ordem->campos[ordem->totalCampos].decrescente = decrescente;
+        ordem->totalCampos++;
+
+        if (fim == NULL) return 1;
+        parte = fim + 1;
+    }
+}
+
+/**
+ * @brief Escreve a ordem composta no formato lido por ordemCompostaPorTexto.
+ * @param tamanho Espaço do destino (ORDEM_COMPOSTA_TEXTO_MAX sempre basta).
+ */
+void ordemCompostaTexto(const OrdemComposta *ordem, char *destino, size_t tamanho) {
+    size_t usado = 0;
+    destino[0] = '\0';
+    for (int i = 0; i < ordem->totalCampos && usado < tamanho; i++) {
+        int escritos = snprintf(destino + usado, tamanho - usado, "%s%s%s", i > 0 ? "," : "",
+                                ordem->campos[i].decrescente ? "-" : "", nomeCriterio(ordem->campos[i].criterio));
+        if (escritos < 0) return;
+        usado += (size_t)escritos;
+    }
+}
+
+/**
+ * @brief A chave composta tem vários bytes: vale o Radix Sort (byte a byte) e qualquer
+ * algoritmo por comparação, mas não o Counting Sort (chave inteira pequena).
+ */
+int algoritmoSuportaOrdemComposta(AlgoritmoOrdenacao algoritmo) {
+    return algoritmo >= 0 && algoritmo < TOTAL_ALGORITMOS && algoritmo != ALGORITMO_CONTAGEM;
+}
+
+/**
+ * @brief Grava os bytes de um inteiro em big-endian, complementados se o campo for decrescente.
+ */
+static unsigned char *codificarInteiro(unsigned char *destino, uint32_t valor, int bytes, unsigned char inversao) {
+    for (int i = bytes - 1; i >= 0; i--) *destino++ = (unsigned char)(valor >> (8 * i)) ^ inversao;
+    return destino;
+}
+
+static int compararEntradasCompostas(const void *a, const void *b, void *contexto) {
+    const EntradaComposta *ea = a, *eb = b;
+    int resultado = memcmp(ea->chave, eb->chave, *(const size_t *)contexto);
+    // Chaves iguais mantêm a ordem dos slots: todos os algoritmos dão o resultado estável do Radix
+    if (resultado == 0) resultado = (ea->slot > eb->slot) - (ea->slot < eb->slot);
+    return resultado;
+}
+
+/**
+ * @brief Radix Sort LSD sobre chaves de largura fixa, movendo só os índices das chaves.
+ * Os histogramas de todas as posições saem de uma única leitura das chaves, e as
+ * posições em que todas as chaves têm o mesmo byte são puladas (ex.: o byte alto do
+ * posto do tipo, os 3 bytes altos da prioridade, prefixos comuns dos nomes).
+ * @param ordem Entra com os índices na ordem inicial e sai com a ordem estável das chaves.
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+static int radixChaves(const unsigned char *chaves, size_t largura, int *ordem, int n,
+                       EstatisticasOrdenacao *estatisticas) {
+    int *auxiliar = malloc((size_t)n * sizeof(int));
+    size_t *histogramas = calloc(largura * 256, sizeof(size_t));
+    if (auxiliar == NULL || histogramas == NULL) {
+        free(auxiliar);
+        free(histogramas);
+        return 0;
+    }
+
+    for (int i = 0; i < n; i++) {
+        const unsigned char *chave = chaves + (size_t)i * largura;
+        for (size_t p = 0; p < largura; p++) histogramas[p * 256 + chave[p]]++;
+    }
+
+    int *origem = ordem, *destino = auxiliar;
+    for (size_t p = largura; p-- > 0;) {
+        size_t *contagem = histogramas + p * 256;
+        if (contagem[chaves[p]] == (size_t)n) continue; // Byte igual em todas as chaves
+
+        // Soma de prefixos: posição inicial de cada balde
+        size_t posicao = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t qtd = contagem[b];
+            contagem[b] = posicao;
+            posicao += qtd;
+        }
+        for (int i = 0; i < n; i++) {
+            int indice = origem[i];
+            destino[contagem[chaves[(size_t)indice * largura + p]]++] = indice;
+        }
+        estatisticas->trocas += n;
+
+        int *t = origem; origem = destino; destino = t;
+    }
+    if (origem != ordem) memcpy(ordem, origem, (size_t)n * sizeof(int));
+
+    free(auxiliar);
+    free(histogramas);
+    return 1;
+}
+
+/**
+ * @brief Calcula a ordem composta dos componentes sem mover nenhuma struct.
+ * Só entram os slots vivos; empates na chave inteira mantêm a ordem dos slots.
+ * Com ALGORITMO_RADIX a ordem sai de uma passada LSD sobre os bytes das chaves
+ * (tempo linear no número de componentes vezes a largura da chave); com os demais,
+ * o motor compara as chaves com memcmp.
+ * @param permutacao Vetor com espaço para totalSlots inteiros (ver ordenarPermutacaoComponentes).
+ * @return Quantidade de posições preenchidas, ou -1 se a ordem ou o algoritmo forem
+ * inválidos ou faltar memória.
+ */
+int ordenarPermutacaoComposta(const Componente *componentes, int totalSlots, const ArenaNomes *nomes,
+                              const OrdemComposta *ordem, AlgoritmoOrdenacao algoritmo, int *permutacao,
+                              EstatisticasOrdenacao *estatisticas) {
+    memset(estatisticas, 0, sizeof(*estatisticas));
+    if (!algoritmoSuportaOrdemComposta(algoritmo) || ordem->totalCampos < 1 || ordem->totalCampos > TOTAL_CRITERIOS) {
+        return -1;
+    }
+
+    clock_t inicio = clock();
+    // Largura da chave: o campo nome ocupa o tamanho do maior nome vivo
+    size_t larguraNome = 1;
+    int total = 0;
+    for (int slot = 0; slot < totalSlots; slot++) {
+        if (COMPONENTE_REMOVIDO(&componentes[slot])) continue;
+        if (componentes[slot].tamanhoNome > larguraNome) larguraNome = componentes[slot].tamanhoNome;
+        total++;
+    }
+    size_t largura = 0;
+    for (int c = 0; c < ordem->totalCampos; c++) {
+        switch (ordem->campos[c].criterio) {
+            case CRITERIO_NOME: largura += larguraNome; break;
+            case CRITERIO_TIPO: largura += 2; break;
+            default:            largura += 4; break;
+        }
+    }
+
+    unsigned char *chaves = malloc((size_t)(total > 0 ? total : 1) * largura);
+    int *slots = malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    if (chaves == NULL || slots == NULL) {
+        free(chaves);
+        free(slots);
+        return -1;
+    }
+    PostosTipos postos;
+    dicionarioTiposCopiarPostos(&postos);
+
+    int k = 0;
+    for (int slot = 0; slot < totalSlots; slot++) {
+        const Componente *comp = &componentes[slot];
+        if (COMPONENTE_REMOVIDO(comp)) continue;
+        unsigned char *chave = chaves + (size_t)k * largura;
+        for (int c = 0; c < ordem->totalCampos; c++) {
+            unsigned char inversao = ordem->campos[c].decrescente ? 0xFF : 0x00;
+            switch (ordem->campos[c].criterio) {
+                case CRITERIO_NOME: {
+                    const unsigned char *nome = (const unsigned char *)nomeNaArena(nomes, comp);
+                    for (size_t i = 0; i < larguraNome; i++) {
+                        *chave++ = (i < comp->tamanhoNome ? nome[i] : 0) ^ inversao;
+                    }
+                    break;
+                }
+                case CRITERIO_TIPO:
+                    chave = codificarInteiro(chave, postoDoTipo(&postos, comp->idTipo), 2, inversao);
+                    break;
+                default:
+                    chave = codificarInteiro(chave, (uint32_t)comp->prioridade ^ 0x80000000u, 4, inversao);
+                    break;
+            }
+        }
+        slots[k++] = slot;
+    }
+
+    int sucesso;
+    if (algoritmo == ALGORITMO_RADIX) {
+        // Ordena as posições 0..total-1 das chaves e traduz para slots no final
+        for (int i = 0; i < total; i++) permutacao[i] = i;
+        sucesso = total < 2 || radixChaves(chaves, largura, permutacao, total, estatisticas);
+        for (int i = 0; sucesso && i < total; i++) permutacao[i] = slots[permutacao[i]];
+    } else {
+        EntradaComposta *entradas = malloc((size_t)(total > 0 ? total : 1) * sizeof(EntradaComposta));
+        DescritorOrdenacao descritor = { sizeof(EntradaComposta), compararEntradasCompostas, NULL, &largura, 0 };
+        sucesso = entradas != NULL;
+        for (int i = 0; sucesso && i < total; i++) {
+            entradas[i].chave = chaves + (size_t)i * largura;
+            entradas[i].slot = slots[i];
+        }
+        sucesso = sucesso && ordenarVetor(entradas, (size_t)total, &descritor, algoritmo, estatisticas);
+        for (int i = 0; sucesso && i < total; i++) permutacao[i] = entradas[i].slot;
+        free(entradas);
+    }
+    free(chaves);
+    free(slots);
+    if (!sucesso) return -1;
+
+    // O tempo inclui a codificação das chaves e a extração da permutação
+    estatisticas->tempoSegundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    return total;
+}
@@ -0,0 +1,111 @@
+#ifndef ORDENACAO_H
+#define ORDENACAO_H
+
+#include <stddef.h>
+#include "componente.h"
+#include "arena_nomes.h"
+#include "dicionario_tipos.h"
+
+// ---------------------------------------------
+// MOTOR DE ORDENAÇÃO
+// ---------------------------------------------
+// Algoritmos genéricos (estilo qsort: base, quantidade, tamanho do elemento)
+// com contagem de comparações, trocas e tempo de execução. Os algoritmos
+// quadráticos originais continuam disponíveis para comparação de desempenho.
+
+typedef enum {
+    ALGORITMO_BOLHA,        // Bubble Sort - O(n²), estável
+    ALGORITMO_INSERCAO,     // Insertion Sort - O(n²), estável
+    ALGORITMO_SELECAO,      // Selection Sort - O(n²), não estável
+    ALGORITMO_INTROSORT,    // Quicksort + Heapsort + Insertion - O(n log n), não estável
+    ALGORITMO_MERGESORT,    // Merge Sort - O(n log n), estável
+    ALGORITMO_RADIX,        // Radix Sort LSD sobre chave inteira - O(n), estável
+    ALGORITMO_CONTAGEM,     // Counting Sort sobre chave inteira pequena - O(n + k), estável
+    TOTAL_ALGORITMOS
+} AlgoritmoOrdenacao;
+
+typedef enum {
+    CRITERIO_NOME,
+    CRITERIO_TIPO,
+    CRITERIO_PRIORIDADE,
+    TOTAL_CRITERIOS
+} CriterioOrdenacao;
+
+// Compara dois elementos: < 0, 0 ou > 0 (como strcmp)
+typedef int (*FuncaoComparacao)(const void *a, const void *b, void *contexto);
+// Extrai a chave inteira sem sinal usada pelo Radix Sort e pelo Counting Sort
+typedef unsigned int (*FuncaoChaveInteira)(const void *elemento, void *contexto);
+
+// Descreve o vetor a ser ordenado
+typedef struct {
+    size_t tamanho;                  // Bytes por elemento
+    FuncaoComparacao comparar;       // Obrigatória para algoritmos por comparação
+    FuncaoChaveInteira chaveInteira; // Obrigatória apenas para Radix e Counting Sort
+    void *contexto;                  // Repassado às duas funções
+    unsigned int chaveMaxima;        // Maior chave possível (Counting Sort); 0 = desconhecida
+} DescritorOrdenacao;
+
+// Medições de desempenho de uma ordenação
+typedef struct {
+    long long comparacoes;   // Chamadas à função de comparação
+    long long trocas;        // Trocas ou movimentações de elementos
+    double tempoSegundos;    // Tempo de CPU (clock())
+    // Comparações de texto (nome), preenchidas quando o contexto do descritor
+    // aponta para estas estatísticas (ver ContextoComponentes)
+    long long acertosPrefixo;    // Resolvidas só pelo prefixo de 8 bytes
+    long long desempatesTexto;   // Prefixos iguais: precisaram de strcmp
+} EstatisticasOrdenacao;
+
+// Ordenação composta: até um campo por critério, cada um crescente ou decrescente.
+// Os campos viram uma única chave de bytes que ordena como a sequência de critérios
+// (ex.: tipo crescente, prioridade decrescente, nome crescente) em uma só passada.
+typedef struct {
+    CriterioOrdenacao criterio;
+    int decrescente;
+} CampoOrdenacao;
+
+typedef struct {
+    CampoOrdenacao campos[TOTAL_CRITERIOS];
+    int totalCampos;
+} OrdemComposta;
+
+// Texto mais longo de uma ordem composta ("-prioridade,-tipo,-nome" e o '\0')
+#define ORDEM_COMPOSTA_TEXTO_MAX 32
+
+// Contexto dos descritores de Componente: a arena onde estão os nomes, a cópia dos
+// postos dos tipos tirada no início da ordenação e, se não for NULL, as estatísticas
+// que contam acertos de prefixo e desempates por strcmp
+typedef struct {
+    const ArenaNomes *nomes;
+    EstatisticasOrdenacao *estatisticas;
+    const PostosTipos *postos;
+} ContextoComponentes;
+
+const char *nomeAlgoritmo(AlgoritmoOrdenacao algoritmo);
+const char *idAlgoritmo(AlgoritmoOrdenacao algoritmo);
+const char *nomeCriterio(CriterioOrdenacao criterio);
+int algoritmoPorNome(const char *nome, AlgoritmoOrdenacao *algoritmo);
+int criterioPorNome(const char *nome, CriterioOrdenacao *criterio);
+int algoritmoSuportaCriterio(AlgoritmoOrdenacao algoritmo, CriterioOrdenacao criterio);
+
+int ordenarVetor(void *base, size_t total, const DescritorOrdenacao *descritor,
+                 AlgoritmoOrdenacao algoritmo, EstatisticasOrdenacao *estatisticas);
+
+int descritorComponentes(CriterioOrdenacao criterio, const PostosTipos *postos, DescritorOrdenacao *descritor);
+int ordenarComponentes(Componente *componentes, int total, const ArenaNomes *nomes, CriterioOrdenacao criterio,
+                       AlgoritmoOrdenacao algoritmo, EstatisticasOrdenacao *estatisticas);
+
+// Ordenação indireta: ordena entradas compactas (chave em cache + slot) em vez das structs
+int ordenarPermutacaoComponentes(const Componente *componentes, int totalSlots, const ArenaNomes *nomes,
+                                 CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo, int *permutacao, EstatisticasOrdenacao *estatisticas);
+long long aplicarPermutacao(void *base, size_t total, size_t tamanho, const int *permutacao);
+
+// Ordenação composta por chaves de bytes codificadas (Radix LSD ou qualquer algoritmo por comparação)
+int ordemCompostaPorTexto(const char *texto, OrdemComposta *ordem);
+void ordemCompostaTexto(const OrdemComposta *ordem, char *destino, size_t tamanho);
+int algoritmoSuportaOrdemComposta(AlgoritmoOrdenacao algoritmo);
+int ordenarPermutacaoComposta(const Componente *componentes, int totalSlots, const ArenaNomes *nomes,
+                              const OrdemComposta *ordem, AlgoritmoOrdenacao algoritmo, int *permutacao,
+                              EstatisticasOrdenacao *estatisticas);
+
+#endif
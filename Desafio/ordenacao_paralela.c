@@ -0,0 +1,280 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h> // clock_gettime (tempo por thread)
+#include "ordenacao_paralela.h"
+
+// Abaixo deste tamanho por bloco não compensa dividir o vetor entre threads
+#define BLOCO_MINIMO 512
+// Menor trecho de saída entregue a uma tarefa de intercalação
+#define TRECHO_MINIMO 256
+
+// Ordena um bloco contíguo do vetor
+typedef struct {
+    Componente *inicio;
+    int tamanho;
+    const ArenaNomes *nomes;
+    const PostosTipos *postos;      // A mesma cópia em todos os blocos e intercalações
+    CriterioOrdenacao criterio;
+    EstatisticasThread *porThread;
+    int sucesso;
+} TarefaBloco;
+
+// Produz as posições [inicio, fim) da intercalação de a e b
+typedef struct {
+    const Componente *a;
+    int tamanhoA;
+    const Componente *b;
+    int tamanhoB;
+    Componente *destino;
+    int inicio;
+    int fim;
+    const DescritorOrdenacao *descritor;
+    EstatisticasThread *porThread;
+} TarefaIntercalacao;
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+static double agoraSegundos(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Algoritmo estável usado em cada bloco (o mesmo da ordenação serial de referência).
+ */
+static AlgoritmoOrdenacao algoritmoDoBloco(CriterioOrdenacao criterio) {
+    return criterio == CRITERIO_NOME ? ALGORITMO_MERGESORT : ALGORITMO_CONTAGEM;
+}
+
+static void executarBloco(void *argumento, int idThread) {
+    TarefaBloco *tarefa = argumento;
+    EstatisticasThread *minhas = &tarefa->porThread[idThread];
+    EstatisticasOrdenacao est;
+    double inicio = agoraSegundos();
+
+    DescritorOrdenacao descritor;
+    ContextoComponentes contexto = { tarefa->nomes, &est, tarefa->postos };
+    descritorComponentes(tarefa->criterio, tarefa->postos, &descritor);
+    descritor.contexto = &contexto;
+    tarefa->sucesso = ordenarVetor(tarefa->inicio, (size_t)tarefa->tamanho, &descritor,
+                                   algoritmoDoBloco(tarefa->criterio), &est);
+
+    minhas->tarefas++;
+    minhas->comparacoes += est.comparacoes;
+    minhas->acertosPrefixo += est.acertosPrefixo;
+    minhas->desempatesTexto += est.desempatesTexto;
+    minhas->trocas += est.trocas;
+    minhas->tempoSegundos += agoraSegundos() - inicio;
+}
+
+/**
+ * @brief Quantos elementos de a entram nas primeiras "posicao" posições da intercalação estável.
+ * Busca binária no caminho de intercalação: em empate, a (bloco da esquerda) vem primeiro.
+ */
+static int dividirCaminho(const TarefaIntercalacao *t, const DescritorOrdenacao *descritor, int posicao,
+                          long long *comparacoes) {
+    int baixo = posicao > t->tamanhoB ? posicao - t->tamanhoB : 0;
+    int alto = posicao < t->tamanhoA ? posicao : t->tamanhoA;
+
+    while (baixo < alto) {
+        int i = baixo + (alto - baixo) / 2;
+        int j = posicao - i;
+        (*comparacoes)++;
+        // b[j-1] >= a[i]: a[i] precisa sair antes de b[j-1], então i ainda é pequeno demais
+        if (j > 0 && i < t->tamanhoA &&
+            descritor->comparar(&t->b[j - 1], &t->a[i], descritor->contexto) >= 0) {
+            baixo = i + 1;
+        } else {
+            alto = i;
+        }
+    }
+    return baixo;
+}
+
+static void executarIntercalacao(void *argumento, int idThread) {
+    TarefaIntercalacao *t = argumento;
+    EstatisticasThread *minhas = &t->porThread[idThread];
+    long long comparacoes = 0;
+    double inicio = agoraSegundos();
+
+    // Cópia local do descritor: os contadores de prefixo de cada tarefa não são compartilhados
+    EstatisticasOrdenacao contagemTexto = { 0 };
+    ContextoComponentes contexto = *(const ContextoComponentes *)t->descritor->contexto;
+    contexto.estatisticas = &contagemTexto;
+    DescritorOrdenacao descritor = *t->descritor;
+    descritor.contexto = &contexto;
+
+    int i = dividirCaminho(t, &descritor, t->inicio, &comparacoes);
+    int iFim = dividirCaminho(t, &descritor, t->fim, &comparacoes);
+    int j = t->inicio - i;
+    int jFim = t->fim - iFim;
+    int k = t->inicio;
+
+    while (i < iFim && j < jFim) {
+        comparacoes++;
+        // "<=" mantém a estabilidade, como no Merge Sort serial
+        if (descritor.comparar(&t->a[i], &t->b[j], descritor.contexto) <= 0) {
+            t->destino[k++] = t->a[i++];
+        } else {
+            t->destino[k++] = t->b[j++];
+        }
+    }
+    if (i < iFim) memcpy(&t->destino[k], &t->a[i], (size_t)(iFim - i) * sizeof(Componente));
+    if (j < jFim) memcpy(&t->destino[k + (iFim - i)], &t->b[j], (size_t)(jFim - j) * sizeof(Componente));
+
+    minhas->tarefas++;
+    minhas->comparacoes += comparacoes;
+    minhas->acertosPrefixo += contagemTexto.acertosPrefixo;
+    minhas->desempatesTexto += contagemTexto.desempatesTexto;
+    minhas->trocas += t->fim - t->inicio;
+    minhas->tempoSegundos += agoraSegundos() - inicio;
+}
+
+/**
+ * @brief Monta as tarefas de uma rodada: cada par de blocos vizinhos vira um bloco
+ * intercalado em destino, repartido em trechos proporcionais ao número de threads.
+ * Um bloco sem par é apenas copiado (intercalação com um bloco vazio).
+ * @return Quantidade de tarefas criadas.
+ */
+static int montarRodada(const Componente *origem, Componente *destino, const int *limites, int totalBlocos,
+                        int total, int totalThreads, const DescritorOrdenacao *descritor,
+                        EstatisticasThread *porThread, TarefaIntercalacao *tarefas) {
+    int totalTarefas = 0;
+
+    for (int blocoA = 0; blocoA < totalBlocos; blocoA += 2) {
+        int inicioA = limites[blocoA];
+        int inicioB = limites[blocoA + 1];
+        int fimB = blocoA + 1 < totalBlocos ? limites[blocoA + 2] : inicioB;
+        int tamanho = fimB - inicioA;
+
+        int trechos = (int)(((long long)totalThreads * tamanho + total - 1) / total);
+        if (trechos > tamanho / TRECHO_MINIMO) trechos = tamanho / TRECHO_MINIMO;
+        if (trechos < 1) trechos = 1;
+
+        for (int s = 0; s < trechos; s++) {
+            TarefaIntercalacao *t = &tarefas[totalTarefas++];
+            t->a = &origem[inicioA];
+            t->tamanhoA = inicioB - inicioA;
+            t->b = &origem[inicioB];
+            t->tamanhoB = fimB - inicioB;
+            t->destino = &destino[inicioA];
+            t->inicio = (int)((long long)tamanho * s / trechos);
+            t->fim = (int)((long long)tamanho * (s + 1) / trechos);
+            t->descritor = descritor;
+            t->porThread = porThread;
+        }
+    }
+    return totalTarefas;
+}
+
+// ---------------------------------------------
+// FUNÇÃO PÚBLICA
+// ---------------------------------------------
+
+/**
+ * @brief Ordena os componentes pelo critério usando as threads do pool.
+ * O resultado é o mesmo do Merge Sort (nome) ou Counting Sort (tipo/prioridade) seriais.
+ * @param estatisticas Soma das threads; o tempo é o de parede da ordenação inteira.
+ * @param porThread Vetor com pool->totalThreads posições (pode ser NULL).
+ * @return 1 em caso de sucesso, 0 se o critério for inválido ou faltar memória
+ *         (o vetor fica inalterado se a falta de memória ocorrer antes dos blocos).
+ */
+int ordenarComponentesParalelo(PoolThreads *pool, Componente *componentes, int total, const ArenaNomes *nomes,
+                               CriterioOrdenacao criterio, EstatisticasOrdenacao *estatisticas,
+                               EstatisticasThread *porThread) {
+    memset(estatisticas, 0, sizeof(*estatisticas));
+
+    PostosTipos postos;
+    dicionarioTiposCopiarPostos(&postos);
+    DescritorOrdenacao descritor;
+    if (!descritorComponentes(criterio, &postos, &descritor)) return 0;
+    ContextoComponentes contexto = { nomes, NULL, &postos };
+    descritor.contexto = &contexto;
+
+    int totalThreads = pool->totalThreads;
+    EstatisticasThread *medicoes = calloc((size_t)totalThreads, sizeof(EstatisticasThread));
+    if (medicoes == NULL) return 0;
+    if (total <= 1) {
+        if (porThread != NULL) memcpy(porThread, medicoes, (size_t)totalThreads * sizeof(EstatisticasThread));
+        free(medicoes);
+        return 1;
+    }
+
+    int totalBlocos = total / BLOCO_MINIMO;
+    if (totalBlocos > totalThreads) totalBlocos = totalThreads;
+    if (totalBlocos < 1) totalBlocos = 1;
+
+    // Reservas feitas antes de tocar no vetor
+    int *limites = malloc((size_t)(totalBlocos + 1) * sizeof(int));
+    TarefaBloco *blocos = malloc((size_t)totalBlocos * sizeof(TarefaBloco));
+    Componente *auxiliar = totalBlocos > 1 ? malloc((size_t)total * sizeof(Componente)) : NULL;
+    // Cada par de blocos gera no máximo totalThreads trechos (mais um por arredondamento)
+    TarefaIntercalacao *tarefas = malloc((size_t)(totalBlocos + totalThreads) * sizeof(TarefaIntercalacao));
+    if (limites == NULL || blocos == NULL || tarefas == NULL || (totalBlocos > 1 && auxiliar == NULL)) {
+        free(limites);
+        free(blocos);
+        free(auxiliar);
+        free(tarefas);
+        free(medicoes);
+        return 0;
+    }
+
+    double inicio = agoraSegundos();
+    int sucesso = 1;
+
+    // Fase 1: blocos ordenados em paralelo
+    for (int b = 0; b <= totalBlocos; b++) limites[b] = (int)((long long)total * b / totalBlocos);
+    for (int b = 0; b < totalBlocos; b++) {
+        blocos[b].inicio = &componentes[limites[b]];
+        blocos[b].tamanho = limites[b + 1] - limites[b];
+        blocos[b].nomes = nomes;
+        blocos[b].postos = &postos;
+        blocos[b].criterio = criterio;
+        blocos[b].porThread = medicoes;
+        blocos[b].sucesso = 0;
+    }
+    poolExecutar(pool, executarBloco, blocos, sizeof(TarefaBloco), totalBlocos);
+    for (int b = 0; b < totalBlocos; b++) sucesso = sucesso && blocos[b].sucesso;
+
+    // Fase 2: rodadas de intercalação alternando entre o vetor e o auxiliar
+    Componente *origem = componentes;
+    Componente *destino = auxiliar;
+    while (sucesso && totalBlocos > 1) {
+        int totalTarefas = montarRodada(origem, destino, limites, totalBlocos, total, totalThreads,
+                                        &descritor, medicoes, tarefas);
+        poolExecutar(pool, executarIntercalacao, tarefas, sizeof(TarefaIntercalacao), totalTarefas);
+
+        // Os limites dos blocos intercalados passam a ser os de índice par
+        int novosBlocos = 0;
+        for (int b = 0; b < totalBlocos; b += 2) limites[novosBlocos++] = limites[b];
+        limites[novosBlocos] = total;
+        totalBlocos = novosBlocos;
+
+        Componente *trocaPapel = origem;
+        origem = destino;
+        destino = trocaPapel;
+    }
+    if (sucesso && origem != componentes) {
+        memcpy(componentes, origem, (size_t)total * sizeof(Componente));
+        medicoes[0].trocas += total;
+    }
+
+    estatisticas->tempoSegundos = agoraSegundos() - inicio;
+    for (int t = 0; t < totalThreads; t++) {
+        estatisticas->comparacoes += medicoes[t].comparacoes;
+        estatisticas->acertosPrefixo += medicoes[t].acertosPrefixo;
+        estatisticas->desempatesTexto += medicoes[t].desempatesTexto;
+        estatisticas->trocas += medicoes[t].trocas;
+    }
+    if (porThread != NULL) memcpy(porThread, medicoes, (size_t)totalThreads * sizeof(EstatisticasThread));
+
+    free(limites);
+    free(blocos);
+    free(auxiliar);
+    free(tarefas);
+    free(medicoes);
+    return sucesso;
+}
@@ -0,0 +1,33 @@
+#ifndef ORDENACAO_PARALELA_H
+#define ORDENACAO_PARALELA_H
+
+#include "componente.h"
+#include "ordenacao.h"
+#include "pool_threads.h"
+
+// ---------------------------------------------
+// ORDENAÇÃO PARALELA (Blocos + Intercalação)
+// ---------------------------------------------
+// O vetor é dividido em um bloco por thread; cada bloco é ordenado por um
+// algoritmo estável (Merge Sort para nome, Counting Sort para tipo e prioridade) e os
+// blocos ordenados são intercalados aos pares, rodada a rodada. Cada intercalação
+// é repartida em trechos independentes da saída (divisão pelo "caminho de
+// intercalação"), então todas as threads trabalham até a última rodada.
+// Como empates sempre favorecem o bloco da esquerda, o resultado é idêntico
+// ao da ordenação serial estável.
+
+// Medições de uma thread do pool durante uma ordenação paralela
+typedef struct {
+    int tarefas;             // Blocos e trechos de intercalação executados
+    long long comparacoes;
+    long long acertosPrefixo;    // Comparações de texto resolvidas pelo prefixo
+    long long desempatesTexto;   // Comparações de texto que precisaram de strcmp
+    long long trocas;        // Elementos movidos
+    double tempoSegundos;    // Tempo ocupado (relógio monotônico)
+} EstatisticasThread;
+
+int ordenarComponentesParalelo(PoolThreads *pool, Componente *componentes, int total, const ArenaNomes *nomes,
+                               CriterioOrdenacao criterio, EstatisticasOrdenacao *estatisticas,
+                               EstatisticasThread *porThread);
+
+#endif
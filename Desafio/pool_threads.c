@@ -0,0 +1,121 @@
+#include <stdlib.h>
+#include "pool_threads.h"
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Laço de cada thread: espera uma rodada, executa tarefas enquanto houver e volta a esperar.
+ */
+static void *executarTrabalhador(void *argumento) {
+    TrabalhadorPool *trabalhador = argumento;
+    PoolThreads *pool = trabalhador->pool;
+
+    pthread_mutex_lock(&pool->trava);
+    for (;;) {
+        while (!pool->encerrar && pool->proximaTarefa >= pool->totalTarefas) {
+            pthread_cond_wait(&pool->novaRodada, &pool->trava);
+        }
+        if (pool->encerrar) break;
+
+        int tarefa = pool->proximaTarefa++;
+        FuncaoTarefa funcao = pool->funcao;
+        void *argumentoTarefa = pool->argumentos + (size_t)tarefa * pool->tamanhoArgumento;
+        pthread_mutex_unlock(&pool->trava);
+
+        funcao(argumentoTarefa, trabalhador->idThread);
+
+        pthread_mutex_lock(&pool->trava);
+        if (++pool->tarefasConcluidas == pool->totalTarefas) pthread_cond_signal(&pool->rodadaConcluida);
+    }
+    pthread_mutex_unlock(&pool->trava);
+    return NULL;
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Cria o pool com a quantidade de threads informada (mínimo 1).
+ * @return 1 em caso de sucesso, 0 se não for possível criar as threads.
+ */
+int poolCriar(PoolThreads *pool, int totalThreads) {
+    if (totalThreads < 1) totalThreads = 1;
+
+    pool->threads = malloc((size_t)totalThreads * sizeof(pthread_t));
+    pool->trabalhadores = malloc((size_t)totalThreads * sizeof(TrabalhadorPool));
+    if (pool->threads == NULL || pool->trabalhadores == NULL) {
+        free(pool->threads);
+        free(pool->trabalhadores);
+        return 0;
+    }
+    pthread_mutex_init(&pool->trava, NULL);
+    pthread_cond_init(&pool->novaRodada, NULL);
+    pthread_cond_init(&pool->rodadaConcluida, NULL);
+    pool->funcao = NULL;
+    pool->argumentos = NULL;
+    pool->tamanhoArgumento = 0;
+    pool->totalTarefas = 0;
+    pool->proximaTarefa = 0;
+    pool->tarefasConcluidas = 0;
+    pool->encerrar = 0;
+
+    pool->totalThreads = 0;
+    for (int i = 0; i < totalThreads; i++) {
+        pool->trabalhadores[i].pool = pool;
+        pool->trabalhadores[i].idThread = i;
+        if (pthread_create(&pool->threads[i], NULL, executarTrabalhador, &pool->trabalhadores[i]) != 0) {
+            poolDestruir(pool);
+            return 0;
+        }
+        pool->totalThreads++;
+    }
+    return 1;
+}
+
+/**
+ * @brief Executa uma rodada de tarefas e só retorna quando todas terminarem.
+ * @param argumentos Vetor com totalTarefas argumentos de tamanhoArgumento bytes cada.
+ */
+void poolExecutar(PoolThreads *pool, FuncaoTarefa funcao, void *argumentos, size_t tamanhoArgumento, int totalTarefas) {
+    if (totalTarefas <= 0) return;
+
+    pthread_mutex_lock(&pool->trava);
+    pool->funcao = funcao;
+    pool->argumentos = argumentos;
+    pool->tamanhoArgumento = tamanhoArgumento;
+    pool->tarefasConcluidas = 0;
+    pool->proximaTarefa = 0;
+    pool->totalTarefas = totalTarefas;
+    pthread_cond_broadcast(&pool->novaRodada);
+
+    while (pool->tarefasConcluidas < pool->totalTarefas) {
+        pthread_cond_wait(&pool->rodadaConcluida, &pool->trava);
+    }
+    pool->totalTarefas = 0;
+    pool->proximaTarefa = 0;
+    pthread_mutex_unlock(&pool->trava);
+}
+
+/**
+ * @brief Encerra as threads e libera o pool.
+ */
+void poolDestruir(PoolThreads *pool) {
+    pthread_mutex_lock(&pool->trava);
+    pool->encerrar = 1;
+    pthread_cond_broadcast(&pool->novaRodada);
+    pthread_mutex_unlock(&pool->trava);
+
+    for (int i = 0; i < pool->totalThreads; i++) pthread_join(pool->threads[i], NULL);
+
+    pthread_mutex_destroy(&pool->trava);
+    pthread_cond_destroy(&pool->novaRodada);
+    pthread_cond_destroy(&pool->rodadaConcluida);
+    free(pool->threads);
+    free(pool->trabalhadores);
+    pool->threads = NULL;
+    pool->trabalhadores = NULL;
+    pool->totalThreads = 0;
+}
@@ -0,0 +1,49 @@
+#ifndef POOL_THREADS_H
+#define POOL_THREADS_H
+
+#include <stddef.h>
+#include <pthread.h>
+
+// ---------------------------------------------
+// POOL DE THREADS (Rodadas de Tarefas)
+// ---------------------------------------------
+// Um conjunto fixo de threads trabalhadoras criado uma única vez e reaproveitado.
+// Cada chamada a poolExecutar publica uma rodada de tarefas independentes
+// (um vetor de argumentos); as threads retiram a próxima tarefa livre até a
+// rodada acabar, e quem chamou espera a conclusão de todas.
+
+// Tarefa: recebe o próprio argumento e o número da thread que a executa (0..totalThreads-1)
+typedef void (*FuncaoTarefa)(void *argumento, int idThread);
+
+typedef struct PoolThreads PoolThreads;
+
+// Identificação entregue a cada thread trabalhadora
+typedef struct {
+    PoolThreads *pool;
+    int idThread;
+} TrabalhadorPool;
+
+struct PoolThreads {
+    pthread_t *threads;
+    TrabalhadorPool *trabalhadores;
+    int totalThreads;
+
+    pthread_mutex_t trava;
+    pthread_cond_t novaRodada;        // Sinalizada quando há tarefas (ou no encerramento)
+    pthread_cond_t rodadaConcluida;   // Sinalizada quando a última tarefa da rodada termina
+
+    // Rodada atual (protegida pela trava)
+    FuncaoTarefa funcao;
+    char *argumentos;
+    size_t tamanhoArgumento;
+    int totalTarefas;
+    int proximaTarefa;
+    int tarefasConcluidas;
+    int encerrar;
+};
+
+int poolCriar(PoolThreads *pool, int totalThreads);
+void poolExecutar(PoolThreads *pool, FuncaoTarefa funcao, void *argumentos, size_t tamanhoArgumento, int totalTarefas);
+void poolDestruir(PoolThreads *pool);
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef PREFIXO_CHAVE_H
+#define PREFIXO_CHAVE_H
+
+#include <stdint.h>
+#include <string.h>
+
+// ---------------------------------------------
+// PREFIXOS DE CHAVE (Comparação em Duas Etapas)
+// ---------------------------------------------
+// Os 8 primeiros bytes de um texto, em big-endian e completados com zeros,
+// formam um inteiro que ordena exatamente como strcmp ordena esses bytes.
+// Comparar os inteiros resolve a maioria das comparações; strcmp só roda
+// quando os prefixos empatam e os dois textos têm 8 bytes ou mais (se o
+// prefixo contém o terminador, o texto inteiro já está nele).
+// As funções são static inline porque ficam no caminho quente das ordenações
+// e das buscas.
+
+/**
+ * @brief Prefixo big-endian dos 8 primeiros bytes do texto (zeros após o terminador).
+ */
+static inline uint64_t prefixoChave(const char *texto) {
+    uint64_t prefixo = 0;
+    int terminou = 0;
+    for (int i = 0; i < 8; i++) {
+        unsigned char byte = terminou ? 0 : (unsigned char)texto[i];
+        if (byte == 0) terminou = 1;
+        prefixo = (prefixo << 8) | byte;
+    }
+    return prefixo;
+}
+
+/**
+ * @brief Compara dois textos pelo prefixo em cache e, só no empate, por strcmp.
+ * @param acertos Incrementado quando o prefixo bastou (pode ser NULL).
+ * @param desempates Incrementado quando strcmp foi necessário (pode ser NULL).
+ * @return < 0, 0 ou > 0 (como strcmp).
+ */
+static inline int compararComPrefixo(uint64_t prefixoA, const char *a, uint64_t prefixoB, const char *b,
+                                     long long *acertos, long long *desempates) {
+    // Prefixos diferentes, ou iguais com o terminador dentro deles (texto inteiro já comparado)
+    if (prefixoA != prefixoB || (prefixoA & 0xFFu) == 0) {
+        if (acertos != NULL) (*acertos)++;
+        return (prefixoA > prefixoB) - (prefixoA < prefixoB);
+    }
+    if (desempates != NULL) (*desempates)++;
+    return strcmp(a + 8, b + 8);
+}
+
+#endif
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h> // write
+#include "saida_buffer.h"
+
+// Capacidade inicial: comporta algumas dezenas de linhas de tabela
+#define BUFFER_CAPACIDADE_MINIMA 4096
+
+// ---------------------------------------------
+// FUNÇÕES INTERNAS
+// ---------------------------------------------
+
+/**
+ * @brief Garante espaço para mais "adicional" bytes (mais o terminador), dobrando a capacidade.
+ */
+static int garantirEspaco(BufferSaida *buffer, size_t adicional) {
+    size_t necessario = buffer->tamanho + adicional + 1;
+    if (necessario <= buffer->capacidade) return 1;
+
+    size_t novaCapacidade = buffer->capacidade > 0 ? buffer->capacidade : BUFFER_CAPACIDADE_MINIMA;
+    while (novaCapacidade < necessario) novaCapacidade *= 2;
+    char *novos = realloc(buffer->dados, novaCapacidade);
+    if (novos == NULL) return 0;
+    buffer->dados = novos;
+    buffer->capacidade = novaCapacidade;
+    return 1;
+}
+
+// ---------------------------------------------
+// FUNÇÕES PÚBLICAS
+// ---------------------------------------------
+
+/**
+ * @brief Cria um buffer vazio (a memória é alocada na primeira escrita).
+ */
+void bufferSaidaInicializar(BufferSaida *buffer) {
+    buffer->dados = NULL;
+    buffer->tamanho = 0;
+    buffer->capacidade = 0;
+}
+
+/**
+ * @brief Libera a memória do buffer.
+ */
+void bufferSaidaLiberar(BufferSaida *buffer) {
+    free(buffer->dados);
+    bufferSaidaInicializar(buffer);
+}
+
+/**
+ * @brief Acrescenta um texto formatado (como printf) ao fim do buffer.
+ * @return 1 em caso de sucesso, 0 se não houver memória (o buffer fica como estava).
+ */
+int bufferSaidaFormatar(BufferSaida *buffer, const char *formato, ...) {
+    va_list argumentos;
+
+    // Tentativa direta no espaço livre; só formata de novo se não couber
+    size_t livre = buffer->capacidade > buffer->tamanho ? buffer->capacidade - buffer->tamanho : 0;
+    va_start(argumentos, formato);
+    int escritos = vsnprintf(livre > 0 ? buffer->dados + buffer->tamanho : NULL, livre, formato, argumentos);
+    va_end(argumentos);
+    if (escritos < 0) return 0;
+
+    if ((size_t)escritos >= livre) {
+        if (!garantirEspaco(buffer, (size_t)escritos)) {
+            if (buffer->dados != NULL) buffer->dados[buffer->tamanho] = '\0';
+            return 0;
+        }
+        va_start(argumentos, formato);
+        vsnprintf(buffer->dados + buffer->tamanho, buffer->capacidade - buffer->tamanho, formato, argumentos);
+        va_end(argumentos);
+    }
+    buffer->tamanho += (size_t)escritos;
+    return 1;
+}
+
+/**
+ * @brief Envia o conteúdo para a saída padrão com uma chamada write e esvazia o buffer.
+ * O stdout é descarregado antes, para o texto sair depois do que já foi impresso com printf.
+ * A memória é mantida para a próxima listagem.
+ * @return 1 em caso de sucesso, 0 se a escrita falhar.
+ */
+int bufferSaidaDescarregar(BufferSaida *buffer) {
+    fflush(stdout);
+
+    size_t enviados = 0;
+    while (enviados < buffer->tamanho) {
+        // Escritas parciais (pipes, sinais) continuam de onde pararam
+        ssize_t resultado = write(STDOUT_FILENO, buffer->dados + enviados, buffer->tamanho - enviados);
+        if (resultado < 0) {
+            if (errno == EINTR) continue;
+            buffer->tamanho = 0;
+            return 0;
+        }
+        enviados += (size_t)resultado;
+    }
+    buffer->tamanho = 0;
+    return 1;
+}
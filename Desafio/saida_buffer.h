@@ -0,0 +1,24 @@
+#ifndef SAIDA_BUFFER_H
+#define SAIDA_BUFFER_H
+
+#include <stddef.h>
+
+// ---------------------------------------------
+// BUFFER DE SAÍDA (Uma Escrita por Listagem)
+// ---------------------------------------------
+// As listagens montam todas as linhas em um buffer que cresce dobrando e é
+// reaproveitado entre chamadas; a tabela inteira vai para o terminal com uma
+// única chamada write, em vez de um printf (e possivelmente uma escrita) por linha.
+
+typedef struct {
+    char *dados;
+    size_t tamanho;      // Bytes já formatados
+    size_t capacidade;   // Bytes alocados
+} BufferSaida;
+
+void bufferSaidaInicializar(BufferSaida *buffer);
+void bufferSaidaLiberar(BufferSaida *buffer);
+int bufferSaidaFormatar(BufferSaida *buffer, const char *formato, ...);
+int bufferSaidaDescarregar(BufferSaida *buffer);
+
+#endif
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshot.h"
+
+static const char ASSINATURA[8] = { 'F', 'F', 'M', 'O', 'C', 'H', 'I', 'L' };
+
+/**
+ * @brief Grava o snapshot em um arquivo temporário e o renomeia por cima do antigo.
+ * O rename é atômico: uma queda no meio da gravação nunca corrompe o snapshot anterior.
+ * @return 1 em caso de sucesso, 0 em caso de erro de E/S.
+ */
+int salvarSnapshot(const char *caminho, uint32_t tipoRegistro, const void *registros,
+                   size_t tamanhoRegistro, size_t total, int ordenadoPorNome, uint32_t geracaoDiario,
+                   const void *extra, size_t tamanhoExtra) {
+    char temporario[4096];
+    if (snprintf(temporario, sizeof(temporario), "%s.tmp", caminho) >= (int)sizeof(temporario)) return 0;
+
+    CabecalhoSnapshot cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.assinatura, ASSINATURA, sizeof(ASSINATURA));
+    cabecalho.versao = SNAPSHOT_VERSAO;
+    cabecalho.marcaEndian = SNAPSHOT_MARCA_ENDIAN;
+    cabecalho.tipoRegistro = tipoRegistro;
+    cabecalho.tamanhoRegistro = (uint32_t)tamanhoRegistro;
+    cabecalho.totalRegistros = total;
+    cabecalho.ordenadoPorNome = ordenadoPorNome ? 1u : 0u;
+    cabecalho.geracaoDiario = geracaoDiario;
+    cabecalho.tamanhoExtra = tamanhoExtra;
+
+    FILE *arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) return 0;
+
+    int sucesso = fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) == 1 &&
+                  (total == 0 || fwrite(registros, tamanhoRegistro, total, arquivo) == total) &&
+                  (tamanhoExtra == 0 || fwrite(extra, tamanhoExtra, 1, arquivo) == 1);
+    sucesso = (fflush(arquivo) == 0) && sucesso;
+    sucesso = (fsync(fileno(arquivo)) == 0) && sucesso;
+    sucesso = (fclose(arquivo) == 0) && sucesso;
+
+    if (!sucesso || rename(temporario, caminho) != 0) {
+        remove(temporario);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Mapeia um snapshot em memória e valida o cabeçalho.
+ * @return SNAPSHOT_OK, SNAPSHOT_INEXISTENTE (arquivo ausente) ou SNAPSHOT_INVALIDO.
+ */
+int abrirSnapshot(const char *caminho, uint32_t tipoRegistro, size_t tamanhoRegistro, SnapshotMapeado *snapshot) {
+    memset(snapshot, 0, sizeof(*snapshot));
+
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return SNAPSHOT_INEXISTENTE;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(CabecalhoSnapshot)) {
+        close(fd);
+        return SNAPSHOT_INVALIDO;
+    }
+
+    size_t tamanho = (size_t)info.st_size;
+    // MAP_PRIVATE + PROT_WRITE: escritas criam cópias privadas das páginas (o arquivo não muda)
+    void *mapa = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); // O mapeamento continua válido após fechar o descritor
+    if (mapa == MAP_FAILED) return SNAPSHOT_INVALIDO;
+
+    const CabecalhoSnapshot *cabecalho = mapa;
+    int valido = memcmp(cabecalho->assinatura, ASSINATURA, sizeof(ASSINATURA)) == 0 &&
+                 cabecalho->versao == SNAPSHOT_VERSAO &&
+                 cabecalho->marcaEndian == SNAPSHOT_MARCA_ENDIAN &&
+                 cabecalho->tipoRegistro == tipoRegistro &&
+                 cabecalho->tamanhoRegistro == tamanhoRegistro &&
+                 cabecalho->totalRegistros <= (tamanho - sizeof(CabecalhoSnapshot)) / tamanhoRegistro &&
+                 cabecalho->tamanhoExtra <= tamanho - sizeof(CabecalhoSnapshot) - cabecalho->totalRegistros * tamanhoRegistro;
+    if (!valido) {
+        munmap(mapa, tamanho);
+        return SNAPSHOT_INVALIDO;
+    }
+
+    // As páginas são lidas sob demanda; pedir a leitura antecipada não bloqueia a carga
+    madvise(mapa, tamanho, MADV_WILLNEED);
+
+    snapshot->mapa = mapa;
+    snapshot->tamanhoMapa = tamanho;
+    snapshot->registros = (char *)mapa + sizeof(CabecalhoSnapshot);
+    snapshot->totalRegistros = (size_t)cabecalho->totalRegistros;
+    snapshot->ordenadoPorNome = cabecalho->ordenadoPorNome != 0;
+    snapshot->geracaoDiario = cabecalho->geracaoDiario;
+    snapshot->tamanhoExtra = (size_t)cabecalho->tamanhoExtra;
+    snapshot->extra = snapshot->tamanhoExtra > 0
+                          ? (char *)snapshot->registros + snapshot->totalRegistros * tamanhoRegistro
+                          : NULL;
+    return SNAPSHOT_OK;
+}
+
+/**
+ * @brief Desfaz o mapeamento do snapshot.
+ */
+void fecharSnapshot(SnapshotMapeado *snapshot) {
+    if (snapshot->mapa != NULL) munmap(snapshot->mapa, snapshot->tamanhoMapa);
+    memset(snapshot, 0, sizeof(*snapshot));
+}
@@ -0,0 +1,60 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------------------------
+// SNAPSHOT BINÁRIO DA MOCHILA
+// ---------------------------------------------
+// Formato versionado de registros de tamanho fixo: um cabeçalho seguido do
+// vetor da mochila exatamente como está na memória. A carga é feita com mmap,
+// sem nenhum parsing: o mapeamento é privado e gravável (copy-on-write), então
+// o programa pode usar os registros mapeados diretamente como a mochila.
+// Alterações nunca chegam ao arquivo; ele só muda ao salvar um novo snapshot.
+// Depois dos registros pode vir um bloco extra opaco (ex.: o dicionário de
+// tipos que dá sentido aos ids guardados nos registros).
+
+#define SNAPSHOT_VERSAO 2
+#define SNAPSHOT_MARCA_ENDIAN 0x01020304u
+
+// Tipos de registro (impede carregar um snapshot de Item como Componente)
+#define SNAPSHOT_REGISTRO_COMPONENTE 1u
+#define SNAPSHOT_REGISTRO_ITEM 2u
+
+typedef struct {
+    char assinatura[8];          // "FFMOCHIL"
+    uint32_t versao;             // SNAPSHOT_VERSAO
+    uint32_t marcaEndian;        // SNAPSHOT_MARCA_ENDIAN (rejeita arquivos de outra arquitetura)
+    uint32_t tipoRegistro;       // SNAPSHOT_REGISTRO_*
+    uint32_t tamanhoRegistro;    // sizeof do registro (rejeita layouts diferentes)
+    uint64_t totalRegistros;
+    uint32_t ordenadoPorNome;    // Preserva o statusOrdenacao entre execuções
+    uint32_t geracaoDiario;      // Checkpoint: só o diário desta geração se aplica sobre o snapshot
+    uint64_t tamanhoExtra;       // Bytes do bloco extra após os registros
+} CabecalhoSnapshot;
+
+// Snapshot aberto para leitura (mapeado em memória)
+typedef struct {
+    void *mapa;
+    size_t tamanhoMapa;
+    void *registros;             // Aponta para dentro do mapa, logo após o cabeçalho
+    size_t totalRegistros;
+    int ordenadoPorNome;
+    uint32_t geracaoDiario;
+    const void *extra;           // Bloco extra (NULL se vazio)
+    size_t tamanhoExtra;
+} SnapshotMapeado;
+
+// Resultados de abrirSnapshot
+#define SNAPSHOT_OK 0
+#define SNAPSHOT_INEXISTENTE 1
+#define SNAPSHOT_INVALIDO 2
+
+int salvarSnapshot(const char *caminho, uint32_t tipoRegistro, const void *registros,
+                   size_t tamanhoRegistro, size_t total, int ordenadoPorNome, uint32_t geracaoDiario,
+                   const void *extra, size_t tamanhoExtra);
+int abrirSnapshot(const char *caminho, uint32_t tipoRegistro, size_t tamanhoRegistro, SnapshotMapeado *snapshot);
+void fecharSnapshot(SnapshotMapeado *snapshot);
+
+#endif
@@ -0,0 +1,34 @@
+#!/bin/sh
+# ---------------------------------------------
+# REGRESSÃO: LOTE RECUSADO POR FALTA DE TIPOS
+# ---------------------------------------------
+# Um arquivo de loot com 1100 tipos distintos passa do limite do dicionário
+# (TIPOS_DISTINTOS_MAX = 1024) e é recusado inteiro. A recusa não pode deixar
+# tipos órfãos no dicionário: o "add" seguinte, com um tipo novo, tem que entrar.
+#
+# Uso: testes/lote_tipos_esgotados.sh [caminho do DesafioFreeFire]
+
+binario=${1:-./DesafioFreeFire}
+temporario=$(mktemp -d) || exit 1
+trap 'rm -rf "$temporario"' EXIT
+
+i=0
+while [ $i -lt 1100 ]; do
+    echo "Item$i tipo$i 1"
+    i=$((i + 1))
+done > "$temporario/loot.txt"
+
+printf 'loot %s\nadd Faca arma 1\nfind Faca\n' "$temporario/loot.txt" > "$temporario/comandos.txt"
+saida=$("$binario" --sem-snapshot --sem-metricas --silencioso --lote "$temporario/comandos.txt" 2>&1)
+
+falhou=0
+echo "$saida" | grep -q 'registro 1025 recusado: limite de tipos distintos atingido' || falhou=1
+echo "$saida" | grep -q 'ERRO linha 2' && falhou=1
+echo "$saida" | grep -q 'erros=1 itens=1' || falhou=1
+
+if [ $falhou -ne 0 ]; then
+    echo "FALHOU: lote_tipos_esgotados"
+    echo "$saida"
+    exit 1
+fi
+echo "OK: lote_tipos_esgotados"